@@ -0,0 +1,53 @@
+#pragma once
+#include "ui/UIElement.h"
+#include "ui/UIEventBus.h"
+#include "ui/IInputEvent.h"
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+namespace bench {
+
+    // Minimal concrete element. UIElement is abstract and its constructor is
+    // protected, so benchmarks build their trees out of this.
+    class BenchElement : public ui::UIElement {
+    public:
+        BenchElement() { styleType_ = "bench"; }
+        ~BenchElement() override { ui::UIEventBus::getInstance().unregisterHandler("styleUpdate", this); }
+
+        void render(ui::IRenderer* renderer) override {
+            if (renderer) renderer->drawRect(position_, size_, glm::vec4(1.0f));
+        }
+        void onStyleUpdate() override { markDirty(); }
+    };
+
+    class BenchMouseEvent : public ui::IMouseEvent {
+    public:
+        BenchMouseEvent(ui::EventType type, glm::vec2 pos, ui::MouseButton button = ui::MouseButton::Left)
+            : type_(type), pos_(pos), button_(button) {}
+        ui::EventType getType() const override { return type_; }
+        glm::vec2 getPosition() const override { return pos_; }
+        ui::MouseButton getButton() const override { return button_; }
+
+    private:
+        ui::EventType type_;
+        glm::vec2 pos_;
+        ui::MouseButton button_;
+    };
+
+    // Children sized 20x20, laid out on a square-ish grid so hit tests have a
+    // well-defined target.
+    inline std::vector<std::unique_ptr<ui::UIElement>> makeChildren(std::size_t count) {
+        std::vector<std::unique_ptr<ui::UIElement>> children;
+        children.reserve(count);
+        const std::size_t columns = 256;
+        for (std::size_t i = 0; i < count; ++i) {
+            auto child = std::make_unique<BenchElement>();
+            child->setSize(glm::vec2(20.0f, 20.0f));
+            child->setPosition(glm::vec2(static_cast<float>(i % columns) * 20.0f, static_cast<float>(i / columns) * 20.0f));
+            children.push_back(std::move(child));
+        }
+        return children;
+    }
+
+} // namespace bench
@@ -0,0 +1,51 @@
+#include "physics/PhysicsWorld.h"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+
+namespace {
+
+// A loose pile of range(0) unit spheres that all move every step: the workload where
+// refitting a tree is expensive. Measures the whole step, broadphase included.
+void runPile(benchmark::State& state, physics::BroadphaseType type) {
+    physics::PhysicsWorld world;
+    world.setBroadphase(type);
+    world.setGravity(glm::vec3(0.0f));
+    world.setSleepEnabled(false); // Collisions slow the pile down; it must not doze off mid-run.
+
+    const auto count = static_cast<int>(state.range(0));
+    const float extent = std::cbrt(static_cast<float>(count)) * 1.5f;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(-extent, extent);
+    std::uniform_real_distribution<float> velocity(-2.0f, 2.0f);
+    for (int i = 0; i < count; ++i) {
+        physics::BodyDesc desc;
+        desc.position = glm::vec3(position(rng), position(rng), position(rng));
+        desc.velocity = glm::vec3(velocity(rng), velocity(rng), velocity(rng));
+        desc.shape = physics::Shape::sphere(0.5f);
+        world.createBody(desc);
+    }
+
+    for (auto _ : state) {
+        world.step(1.0f / 60.0f);
+    }
+    state.counters["pairs"] = static_cast<double>(world.getPairs().size());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void BM_PileStepAabbTree(benchmark::State& state) {
+    runPile(state, physics::BroadphaseType::AabbTree);
+}
+BENCHMARK(BM_PileStepAabbTree)->Arg(1000)->Arg(10000)->Arg(50000);
+
+void BM_PileStepSweepAndPrune(benchmark::State& state) {
+    runPile(state, physics::BroadphaseType::SweepAndPrune);
+}
+BENCHMARK(BM_PileStepSweepAndPrune)->Arg(1000)->Arg(10000)->Arg(50000);
+
+void BM_PileStepHashGrid(benchmark::State& state) {
+    runPile(state, physics::BroadphaseType::HashGrid);
+}
+BENCHMARK(BM_PileStepHashGrid)->Arg(1000)->Arg(10000)->Arg(50000);
+
+} // namespace
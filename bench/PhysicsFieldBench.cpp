@@ -0,0 +1,38 @@
+#include "physics/VectorField.h"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Swirl field on a 64^3 grid sampled at range(0) points drifting through it in short random
+// walks, so neighbouring samples mostly share cells the way particle streams do.
+void BM_VectorFieldSample(benchmark::State& state) {
+    physics::VectorField field(glm::vec3(-8.0f), 0.25f, glm::ivec3(64));
+    field.updateRegion(field.getBounds(), [](const glm::vec3& p) {
+        return glm::vec3(-p.z, 0.1f * std::sin(p.x), p.x);
+    });
+
+    const auto count = static_cast<size_t>(state.range(0));
+    std::vector<float> x(count), y(count), z(count), outX(count), outY(count), outZ(count);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> start(-8.0f, 7.75f);
+    std::uniform_real_distribution<float> stepDist(-0.1f, 0.1f);
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 64 == 0) {
+            x[i] = start(rng); y[i] = start(rng); z[i] = start(rng);
+        } else {
+            x[i] = x[i - 1] + stepDist(rng); y[i] = y[i - 1] + stepDist(rng); z[i] = z[i - 1] + stepDist(rng);
+        }
+    }
+
+    for (auto _ : state) {
+        field.sample(x.data(), y.data(), z.data(), count, outX.data(), outY.data(), outZ.data());
+        benchmark::DoNotOptimize(outX.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_VectorFieldSample)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+} // namespace
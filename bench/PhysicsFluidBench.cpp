@@ -0,0 +1,33 @@
+#include "physics/FluidSystem.h"
+#include <benchmark/benchmark.h>
+#include <cmath>
+
+namespace {
+
+// Dam break: a column of range(0) particles collapsing into an empty tank. The column is run
+// for half a second before timing so the measured steps see a moving, splashing fluid.
+void BM_FluidDamBreakStep(benchmark::State& state) {
+    physics::FluidSettings settings;
+    settings.particleRadius = 0.02f;
+    const auto count = static_cast<float>(state.range(0));
+    // A column twice as tall as it is wide, in a tank four widths long.
+    const float spacing = 2.0f * settings.particleRadius;
+    const float width = spacing * std::cbrt(count / 2.0f);
+    settings.bounds = { glm::vec3(0.0f), glm::vec3(4.0f * width, 3.0f * width, width) };
+    physics::FluidSystem fluid(settings);
+    fluid.addBlock({ glm::vec3(0.0f), glm::vec3(width, 2.0f * width, width) });
+
+    constexpr float kDt = 1.0f / 60.0f;
+    for (int i = 0; i < 30; ++i) fluid.step(kDt);
+
+    for (auto _ : state) {
+        fluid.step(kDt);
+        benchmark::DoNotOptimize(fluid.getPositionX());
+    }
+    state.counters["particles"] = static_cast<double>(fluid.size());
+    state.counters["neighbors"] = static_cast<double>(fluid.getNeighborPairCount()) / static_cast<double>(fluid.size());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * fluid.size()));
+}
+BENCHMARK(BM_FluidDamBreakStep)->Arg(1 << 15)->Arg(1 << 17)->Arg(1 << 19)->Unit(benchmark::kMillisecond);
+
+} // namespace
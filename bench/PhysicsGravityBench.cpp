@@ -0,0 +1,69 @@
+#include "physics/NBodyGravity.h"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Flattened disc with a sparse halo, roughly what the galaxy scenes spawn.
+struct PointCloud {
+    std::vector<float> x, y, z, mass;
+
+    explicit PointCloud(size_t count) : x(count), y(count), z(count), mass(count) {
+        std::mt19937 rng(11);
+        std::normal_distribution<float> normal(0.0f, 1.0f);
+        std::uniform_real_distribution<float> massDist(0.5f, 1.5f);
+        for (size_t i = 0; i < count; ++i) {
+            const float spread = i % 10 == 0 ? 5.0f : 1.0f;
+            x[i] = normal(rng) * spread;
+            y[i] = normal(rng) * spread * 0.3f;
+            z[i] = normal(rng) * spread;
+            mass[i] = massDist(rng);
+        }
+    }
+};
+
+void runGravity(benchmark::State& state, physics::GravityMethod method) {
+    const auto count = static_cast<size_t>(state.range(0));
+    const PointCloud cloud(count);
+    std::vector<float> ax(count), ay(count), az(count);
+
+    physics::GravitySettings settings;
+    settings.gravitationalConstant = 1.0f;
+    settings.method = method;
+    physics::NBodyGravity gravity(settings);
+
+    for (auto _ : state) {
+        gravity.computeAccelerations(cloud.x.data(), cloud.y.data(), cloud.z.data(), cloud.mass.data(), count,
+                                     ax.data(), ay.data(), az.data());
+        benchmark::DoNotOptimize(ax.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+
+    // RMS error relative to direct summation, where that is still affordable.
+    if (method != physics::GravityMethod::Direct && count <= 16384) {
+        settings.method = physics::GravityMethod::Direct;
+        gravity.setSettings(settings);
+        std::vector<float> rx(count), ry(count), rz(count);
+        gravity.computeAccelerations(cloud.x.data(), cloud.y.data(), cloud.z.data(), cloud.mass.data(), count,
+                                     rx.data(), ry.data(), rz.data());
+        double error = 0.0, reference = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            const double dx = ax[i] - rx[i], dy = ay[i] - ry[i], dz = az[i] - rz[i];
+            error += dx * dx + dy * dy + dz * dz;
+            reference += double(rx[i]) * rx[i] + double(ry[i]) * ry[i] + double(rz[i]) * rz[i];
+        }
+        state.counters["rmsError"] = std::sqrt(error / reference);
+    }
+}
+
+void BM_GravityDirect(benchmark::State& state) { runGravity(state, physics::GravityMethod::Direct); }
+void BM_GravityBarnesHut(benchmark::State& state) { runGravity(state, physics::GravityMethod::BarnesHut); }
+void BM_GravityMultipole(benchmark::State& state) { runGravity(state, physics::GravityMethod::FastMultipole); }
+
+BENCHMARK(BM_GravityDirect)->Arg(1024)->Arg(4096)->Arg(16384)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GravityBarnesHut)->Arg(1024)->Arg(4096)->Arg(16384)->Arg(131072)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GravityMultipole)->Arg(1024)->Arg(4096)->Arg(16384)->Arg(131072)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,66 @@
+#include "physics/ParticleSystem.h"
+#include "physics/VectorField.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+namespace {
+
+// A fountain emitting fast enough to hold about range(0) particles, run for two seconds (longer
+// than any lifetime) before timing so births and deaths balance.
+physics::ParticleSystem makeFountain(int64_t particles) {
+    physics::ParticleSystem system;
+    physics::ParticleEmitterDesc desc;
+    desc.rate = static_cast<float>(particles) / 1.5f;
+    desc.capacity = static_cast<uint32_t>(particles + particles / 4);
+    desc.velocity = glm::vec3(0.0f, 5.0f, 0.0f);
+    desc.velocitySpread = glm::vec3(1.0f);
+    desc.drag = 0.1f;
+    system.addEmitter(desc);
+    for (int i = 0; i < 120; ++i) system.step(1.0f / 60.0f);
+    return system;
+}
+
+physics::VectorField makeSwirl() {
+    physics::VectorField field(glm::vec3(-8.0f), 0.5f, glm::ivec3(32));
+    field.updateRegion(field.getBounds(), [](const glm::vec3& p) { return glm::vec3(-p.z, 0.0f, p.x) * 0.5f; });
+    return field;
+}
+
+void BM_ParticleStep(benchmark::State& state) {
+    physics::ParticleSystem system = makeFountain(state.range(0));
+    for (auto _ : state) {
+        system.step(1.0f / 60.0f);
+        benchmark::DoNotOptimize(system.getPositionX(0));
+    }
+    state.counters["particles"] = static_cast<double>(system.size());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * system.size()));
+}
+BENCHMARK(BM_ParticleStep)->Arg(1 << 18)->Arg(1 << 20)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+
+// Same, with a wind field sampled at every particle each step.
+void BM_ParticleStepWithField(benchmark::State& state) {
+    physics::ParticleSystem system = makeFountain(state.range(0));
+    const physics::VectorField field = makeSwirl();
+    for (auto _ : state) {
+        system.applyAccelerationField(field);
+        system.step(1.0f / 60.0f);
+        benchmark::DoNotOptimize(system.getPositionX(0));
+    }
+    state.counters["particles"] = static_cast<double>(system.size());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * system.size()));
+}
+BENCHMARK(BM_ParticleStepWithField)->Arg(1 << 18)->Arg(1 << 20)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+
+void BM_ParticleWriteInstances(benchmark::State& state) {
+    const physics::ParticleSystem system = makeFountain(state.range(0));
+    std::vector<physics::ParticleInstance> instances;
+    for (auto _ : state) {
+        system.writeInstances(instances);
+        benchmark::DoNotOptimize(instances.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * system.size()));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * system.size() * sizeof(physics::ParticleInstance)));
+}
+BENCHMARK(BM_ParticleWriteInstances)->Arg(1 << 18)->Arg(1 << 20)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,49 @@
+#include "physics/PhysicsWorld.h"
+#include "physics/SoftBodySystem.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// A range(0) x range(0) cloth with self-collision draped over a sphere. It is run for half a
+// second before timing so the measured steps see it folding over the sphere.
+void BM_SoftBodyClothDrapeStep(benchmark::State& state) {
+    physics::PhysicsWorld world;
+    physics::BodyDesc ground;
+    ground.shape = physics::Shape::box(glm::vec3(5.0f, 0.5f, 5.0f));
+    ground.position = glm::vec3(0.0f, -0.5f, 0.0f);
+    ground.mass = 0.0f;
+    world.createBody(ground);
+    physics::BodyDesc ball;
+    ball.shape = physics::Shape::sphere(0.3f);
+    ball.position = glm::vec3(0.0f, 0.3f, 0.0f);
+    ball.mass = 0.0f;
+    world.createBody(ball);
+
+    const auto side = static_cast<int>(state.range(0));
+    physics::SoftBodySettings settings;
+    settings.thickness = 0.5f / static_cast<float>(side - 1);
+    physics::SoftBodySystem cloth(settings);
+    physics::ClothDesc desc;
+    desc.origin = glm::vec3(-0.5f, 0.8f, -0.5f);
+    desc.resolution = glm::ivec2(side);
+    cloth.createCloth(desc);
+
+    constexpr float kDt = 1.0f / 60.0f;
+    for (int i = 0; i < 30; ++i) {
+        world.step(kDt);
+        cloth.step(kDt, &world);
+    }
+
+    for (auto _ : state) {
+        world.step(kDt);
+        cloth.step(kDt, &world);
+        benchmark::DoNotOptimize(cloth.getPositionX());
+    }
+    state.counters["particles"] = static_cast<double>(cloth.size());
+    state.counters["constraints"] = static_cast<double>(cloth.getConstraintCount());
+    state.counters["colors"] = static_cast<double>(cloth.getColorCount());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * cloth.size()));
+}
+BENCHMARK(BM_SoftBodyClothDrapeStep)->Arg(32)->Arg(100)->Arg(256)->Unit(benchmark::kMillisecond);
+
+} // namespace
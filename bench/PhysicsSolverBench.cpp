@@ -0,0 +1,76 @@
+#include "physics/PhysicsWorld.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+constexpr int kLayers = 8;
+
+// Layers of side x side boxes resting on a floor: every box touches up to six others, so most of
+// the step is spent in the contact solver. The pile is settled so the measured steps see warm,
+// persistent contacts.
+void buildBoxPile(physics::PhysicsWorld& world, int side) {
+    world.setSleepEnabled(false);
+
+    physics::BodyDesc floor;
+    floor.mass = 0.0f;
+    floor.shape = physics::Shape::box(glm::vec3(100.0f, 0.5f, 100.0f));
+    floor.position = glm::vec3(0.0f, -0.5f, 0.0f);
+    world.createBody(floor);
+
+    for (int y = 0; y < kLayers; ++y) {
+        for (int x = 0; x < side; ++x) {
+            for (int z = 0; z < side; ++z) {
+                physics::BodyDesc desc;
+                desc.shape = physics::Shape::box(glm::vec3(0.5f));
+                desc.position = glm::vec3((x - side / 2) * 1.01f, 0.5f + y, (z - side / 2) * 1.01f);
+                world.createBody(desc);
+            }
+        }
+    }
+
+    for (int i = 0; i < 30; ++i) world.step(1.0f / 60.0f);
+}
+
+void BM_BoxPileStep(benchmark::State& state) {
+    physics::PhysicsWorld world;
+    const auto side = static_cast<int>(state.range(0));
+    buildBoxPile(world, side);
+
+    for (auto _ : state) {
+        world.step(1.0f / 60.0f);
+    }
+    state.counters["contacts"] = static_cast<double>(world.getContacts().size());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * side * side * kLayers);
+}
+BENCHMARK(BM_BoxPileStep)->Arg(8)->Arg(16)->Arg(32)->Unit(benchmark::kMillisecond);
+
+// The same pile in deterministic mode: the difference to BM_BoxPileStep is the cost of sorting
+// the contacts and hashing the state every step.
+void BM_BoxPileStepDeterministic(benchmark::State& state) {
+    physics::PhysicsWorld world;
+    world.setDeterministic(true);
+    const auto side = static_cast<int>(state.range(0));
+    buildBoxPile(world, side);
+
+    for (auto _ : state) {
+        world.step(1.0f / 60.0f);
+    }
+    benchmark::DoNotOptimize(world.getStepChecksum());
+    state.counters["contacts"] = static_cast<double>(world.getContacts().size());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * side * side * kLayers);
+}
+BENCHMARK(BM_BoxPileStepDeterministic)->Arg(8)->Arg(16)->Arg(32)->Unit(benchmark::kMillisecond);
+
+void BM_WorldChecksum(benchmark::State& state) {
+    physics::PhysicsWorld world;
+    const auto side = static_cast<int>(state.range(0));
+    buildBoxPile(world, side);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(world.computeChecksum());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * side * side * kLayers);
+}
+BENCHMARK(BM_WorldChecksum)->Arg(8)->Arg(16)->Arg(32)->Unit(benchmark::kMicrosecond);
+
+} // namespace
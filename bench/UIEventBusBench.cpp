@@ -0,0 +1,41 @@
+#include "BenchCommon.h"
+#include "ui/UIEventBus.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// Cost of one publish() as the number of subscribers on the event grows.
+void BM_EventBusPublishFanOut(benchmark::State& state) {
+    auto& bus = ui::UIEventBus::getInstance();
+    const auto subscriberCount = static_cast<std::size_t>(state.range(0));
+    std::vector<std::unique_ptr<bench::BenchElement>> subscribers;
+    subscribers.reserve(subscriberCount);
+    std::size_t delivered = 0;
+    for (std::size_t i = 0; i < subscriberCount; ++i) {
+        subscribers.push_back(std::make_unique<bench::BenchElement>());
+        bus.registerHandler("benchFanOut", subscribers.back().get(),
+            [&delivered](ui::UIElement*, ui::EventType) { ++delivered; });
+    }
+
+    for (auto _ : state) {
+        bus.publish("benchFanOut", nullptr, ui::EventType::MouseMove);
+    }
+    benchmark::DoNotOptimize(delivered);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(subscriberCount));
+
+    for (auto& subscriber : subscribers) {
+        bus.unregisterHandler("benchFanOut", subscriber.get());
+    }
+}
+BENCHMARK(BM_EventBusPublishFanOut)->RangeMultiplier(10)->Range(1, 10000);
+
+// Publishing an event nobody listens to; this is the common case for raw input.
+void BM_EventBusPublishNoSubscribers(benchmark::State& state) {
+    auto& bus = ui::UIEventBus::getInstance();
+    for (auto _ : state) {
+        bus.publish("benchUnheard", nullptr, ui::EventType::MouseMove);
+    }
+}
+BENCHMARK(BM_EventBusPublishNoSubscribers);
+
+} // namespace
@@ -0,0 +1,40 @@
+#include "BenchCommon.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// Routes a mouse move through UIElement::handleInput, which hit-tests the
+// children back to front. The target is the first child, i.e. the worst case.
+void BM_HandleInputHitTestMove(benchmark::State& state) {
+    bench::BenchElement root;
+    root.setSize(glm::vec2(1e6f, 1e6f));
+    for (auto& child : bench::makeChildren(static_cast<std::size_t>(state.range(0)))) {
+        root.addChild(std::move(child));
+    }
+    bench::BenchMouseEvent move(ui::EventType::MouseMove, glm::vec2(5.0f, 5.0f), ui::MouseButton::Unknown);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(root.handleInput(&move));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_HandleInputHitTestMove)->Arg(10)->Arg(1000)->Arg(100000);
+
+// Press followed by release on the first child: the full click path.
+void BM_HandleInputClick(benchmark::State& state) {
+    bench::BenchElement root;
+    root.setSize(glm::vec2(1e6f, 1e6f));
+    for (auto& child : bench::makeChildren(static_cast<std::size_t>(state.range(0)))) {
+        root.addChild(std::move(child));
+    }
+    bench::BenchMouseEvent press(ui::EventType::MousePress, glm::vec2(5.0f, 5.0f));
+    bench::BenchMouseEvent release(ui::EventType::MouseRelease, glm::vec2(5.0f, 5.0f));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(root.handleInput(&press));
+        benchmark::DoNotOptimize(root.handleInput(&release));
+    }
+}
+BENCHMARK(BM_HandleInputClick)->Arg(10)->Arg(1000)->Arg(100000);
+
+} // namespace
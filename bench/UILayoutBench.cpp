@@ -0,0 +1,68 @@
+#include "BenchCommon.h"
+#include "ui/UICanvas.h"
+#include "ui/UIBoxLayout.h"
+#include "ui/UIConstraintLayout.h"
+#include "ui/UIFullLayout.h"
+#include "ui/UIGridLayout.h"
+#include "ui/UILinearLayout.h"
+#include "ui/UIXYLayout.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+template <typename MakeLayout>
+void runArrange(benchmark::State& state, MakeLayout makeLayout) {
+    auto canvas = ui::UICanvas::create("canvas", 0);
+    canvas->setSize(glm::vec2(1280.0f, 720.0f));
+    auto children = bench::makeChildren(static_cast<std::size_t>(state.range(0)));
+    auto layout = makeLayout(children);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(layout->arrange(canvas.get(), children));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void BM_LinearLayoutArrange(benchmark::State& state) {
+    runArrange(state, [](auto&) { return std::make_unique<ui::UILinearLayout>(ui::UILinearLayout::Orientation::Vertical); });
+}
+BENCHMARK(BM_LinearLayoutArrange)->Arg(10)->Arg(1000)->Arg(100000);
+
+void BM_BoxLayoutArrange(benchmark::State& state) {
+    runArrange(state, [](auto&) { return std::make_unique<ui::UIBoxLayout>(ui::UIBoxLayout::Orientation::Horizontal); });
+}
+BENCHMARK(BM_BoxLayoutArrange)->Arg(10)->Arg(1000)->Arg(100000);
+
+void BM_GridLayoutArrange(benchmark::State& state) {
+    runArrange(state, [](auto&) { return std::make_unique<ui::UIGridLayout>(16); });
+}
+BENCHMARK(BM_GridLayoutArrange)->Arg(10)->Arg(1000)->Arg(100000);
+
+void BM_XYLayoutArrange(benchmark::State& state) {
+    runArrange(state, [](auto&) { return std::make_unique<ui::UIXYLayout>(); });
+}
+BENCHMARK(BM_XYLayoutArrange)->Arg(10)->Arg(1000)->Arg(100000);
+
+// Canvas-relative constraints only: element-to-element targets make
+// validateConstraints quadratic and would dominate the 100k case.
+void BM_ConstraintLayoutArrange(benchmark::State& state) {
+    runArrange(state, [](auto& children) {
+        auto layout = std::make_unique<ui::UIConstraintLayout>();
+        using Constraint = ui::UIConstraintLayout::Constraint;
+        for (auto& child : children) {
+            layout->addConstraint(child.get(), Constraint{ Constraint::Anchor::CenterX, Constraint::Type::Proportional, nullptr, 0.5f, 0 });
+            layout->addConstraint(child.get(), Constraint{ Constraint::Anchor::Width, Constraint::Type::Absolute, nullptr, 20.0f, 0 });
+        }
+        return layout;
+    });
+}
+BENCHMARK(BM_ConstraintLayoutArrange)->Arg(10)->Arg(1000)->Arg(100000);
+
+// UIFullLayout keeps a single child and discards the rest, so it is only
+// meaningful with one child.
+void BM_FullLayoutArrange(benchmark::State& state) {
+    runArrange(state, [](auto&) { return std::make_unique<ui::UIFullLayout>(); });
+}
+BENCHMARK(BM_FullLayoutArrange)->Arg(1);
+
+} // namespace
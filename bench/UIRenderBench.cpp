@@ -0,0 +1,47 @@
+#include "BenchCommon.h"
+#include "ui/HeadlessRenderer.h"
+#include "ui/UICanvas.h"
+#include "ui/UIButton.h"
+#include "ui/UILabel.h"
+#include "ui/UITheme.h"
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace {
+
+// One full frame of a canvas holding range(0) labels and buttons, rendered
+// against the headless renderer so only UI-side cost is measured.
+void BM_CanvasRenderFrame(benchmark::State& state) {
+    ui::UITheme theme;
+    ui::HeadlessRenderer renderer;
+    auto canvas = ui::UICanvas::create("canvas", 0);
+    canvas->setSize(renderer.getScreenSize());
+    canvas->setGlobalTheme(&theme);
+
+    const auto count = static_cast<int>(state.range(0));
+    for (int i = 0; i < count; ++i) {
+        if (i % 2 == 0) {
+            auto label = ui::UILabel::create("Label " + std::to_string(i));
+            label->setPosition(glm::vec2(static_cast<float>(i % 64) * 20.0f, static_cast<float>(i / 64) * 20.0f));
+            canvas->addChild(std::move(label));
+        }
+        else {
+            auto button = ui::UIButton::create("Button " + std::to_string(i));
+            button->setPosition(glm::vec2(static_cast<float>(i % 64) * 20.0f, static_cast<float>(i / 64) * 20.0f));
+            canvas->addChild(std::move(button));
+        }
+    }
+
+    for (auto _ : state) {
+        canvas->markDirty();
+        canvas->doRender(&renderer);
+    }
+    const auto& stats = renderer.getStats();
+    state.counters["drawCallsPerFrame"] = benchmark::Counter(
+        static_cast<double>(stats.rects + stats.lines + stats.texts + stats.textures),
+        benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * count);
+}
+BENCHMARK(BM_CanvasRenderFrame)->Arg(10)->Arg(1000)->Arg(100000);
+
+} // namespace
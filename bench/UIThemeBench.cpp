@@ -0,0 +1,38 @@
+#include "ui/UITheme.h"
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace {
+
+void BM_ThemeGetStyleDefault(benchmark::State& state) {
+    ui::UITheme theme;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(theme.getStyle("button"));
+    }
+}
+BENCHMARK(BM_ThemeGetStyleDefault);
+
+// Per-element overrides: lookup by id among range(0) registered ids.
+void BM_ThemeGetStyleById(benchmark::State& state) {
+    ui::UITheme theme;
+    const auto idCount = static_cast<int>(state.range(0));
+    for (int i = 0; i < idCount; ++i) {
+        theme.setStyle("button", "button" + std::to_string(i), std::make_shared<ui::UIButtonStyle>());
+    }
+    const std::string id = "button" + std::to_string(idCount / 2);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(theme.getStyle("button", id));
+    }
+}
+BENCHMARK(BM_ThemeGetStyleById)->RangeMultiplier(10)->Range(10, 10000);
+
+// Unknown component type: falls through to a freshly allocated UIStyle.
+void BM_ThemeGetStyleMissing(benchmark::State& state) {
+    ui::UITheme theme;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(theme.getStyle("noSuchComponent"));
+    }
+}
+BENCHMARK(BM_ThemeGetStyleMissing);
+
+} // namespace
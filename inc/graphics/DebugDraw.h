@@ -0,0 +1,99 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ui {
+    class IRenderer;
+}
+
+namespace graphics {
+
+    class DebugRasterizer;
+
+    // Immediate-mode debug drawing for simulation overlays.
+    // Emitters append to a buffer owned by the calling thread, so worker threads never contend.
+    // flush() must run while no thread is emitting (e.g. after the physics step joined).
+    class DebugDraw {
+    public:
+        static DebugDraw& getInstance();
+
+        // Primitives are world-space; z is depth (larger z is nearer the viewer).
+        // lifetime is in seconds, 0 draws for a single flush. Overlay primitives skip the depth test.
+        void line(const glm::vec3& a, const glm::vec3& b, const glm::vec4& color, float lifetime = 0.0f, bool overlay = false);
+        void point(const glm::vec3& position, float size, const glm::vec4& color, float lifetime = 0.0f, bool overlay = false);
+        void box(const glm::vec3& min, const glm::vec3& max, const glm::vec4& color, float lifetime = 0.0f, bool overlay = false);
+        void arrow(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color, float headSize = 4.0f, float lifetime = 0.0f, bool overlay = false);
+
+        // World -> screen: screen = offset + world.xy * scale.
+        void setView(const glm::vec2& offset, float scale) { viewOffset_ = offset; viewScale_ = scale; }
+        void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+        bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+        // Draws everything emitted since the last flush plus live retained primitives,
+        // one drawLines batch per color, then ages lifetimes by dt.
+        void flush(ui::IRenderer* renderer, float dt);
+        // Same, through the CPU rasterizer for headless runs (real per-pixel depth test).
+        void flush(DebugRasterizer& target, float dt);
+        // Drops all pending and retained primitives.
+        void clear();
+
+        size_t getLastFlushSegmentCount() const { return lastSegmentCount_; }
+
+    private:
+        DebugDraw() = default;
+        DebugDraw(const DebugDraw&) = delete;
+        DebugDraw& operator=(const DebugDraw&) = delete;
+
+        static constexpr uint8_t kOverlay = 1;
+        static uint8_t overlayFlag(bool overlay) { return overlay ? kOverlay : uint8_t(0); }
+
+        struct Line { glm::vec3 a, b; uint32_t color; float lifetime; uint8_t flags; };
+        struct Point { glm::vec3 position; float size; uint32_t color; float lifetime; uint8_t flags; };
+        struct Box { glm::vec3 min, max; uint32_t color; float lifetime; uint8_t flags; };
+        struct Arrow { glm::vec3 from, to; float headSize; uint32_t color; float lifetime; uint8_t flags; };
+
+        // Typed primitive streams; one set per emitting thread plus one for retained primitives.
+        struct Streams {
+            std::vector<Line> lines;
+            std::vector<Point> points;
+            std::vector<Box> boxes;
+            std::vector<Arrow> arrows;
+            void clear() { lines.clear(); points.clear(); boxes.clear(); arrows.clear(); }
+        };
+
+        // Expanded screen-space segment, ready for batching.
+        struct Segment {
+            glm::vec2 a, b;
+            float depthA, depthB;
+            uint32_t color;
+            uint8_t flags;
+        };
+
+        Streams& localStreams();
+        void collect();
+        void expand();
+        void retire(float dt);
+        void emitSegment(const glm::vec3& a, const glm::vec3& b, uint32_t color, uint8_t flags);
+        glm::vec2 toScreen(const glm::vec3& p) const { return viewOffset_ + glm::vec2(p.x, p.y) * viewScale_; }
+
+        static uint32_t packColor(const glm::vec4& color);
+        static glm::vec4 unpackColor(uint32_t color);
+
+        std::atomic<bool> enabled_{ true };
+        std::mutex registryMutex_; // Taken on a thread's first emit and by flush(), never per primitive.
+        std::vector<std::unique_ptr<Streams>> threadStreams_;
+
+        Streams frame_;    // Merged view of this flush.
+        Streams retained_; // Primitives with lifetime left.
+        std::vector<Segment> segments_;
+        std::vector<glm::vec2> batch_;
+        glm::vec2 viewOffset_{ 0.0f };
+        float viewScale_{ 1.0f };
+        size_t lastSegmentCount_{ 0 };
+    };
+
+} // namespace graphics
@@ -0,0 +1,36 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace graphics {
+
+    // Minimal software target for debug overlays when there is no GPU: RGBA8 color plus a float depth buffer.
+    class DebugRasterizer {
+    public:
+        DebugRasterizer(int width, int height);
+
+        void resize(int width, int height);
+        // Depth clears to the farthest value; larger depth is nearer.
+        void clear(uint32_t color = 0);
+
+        // Segment with per-end depth; depth-tested segments only write where they are nearer.
+        void drawLine(const glm::vec2& a, float depthA, const glm::vec2& b, float depthB, uint32_t color, bool depthTest);
+
+        int getWidth() const { return width_; }
+        int getHeight() const { return height_; }
+        uint32_t pixelAt(int x, int y) const { return color_[static_cast<size_t>(y) * width_ + x]; }
+        const std::vector<uint32_t>& getPixels() const { return color_; }
+
+        // Binary PPM dump for eyeballing headless runs.
+        bool writePPM(const std::filesystem::path& path) const;
+
+    private:
+        int width_;
+        int height_;
+        std::vector<uint32_t> color_; // 0xAABBGGRR
+        std::vector<float> depth_;
+    };
+
+} // namespace graphics
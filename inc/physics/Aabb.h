@@ -0,0 +1,57 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <algorithm>
+
+namespace physics {
+
+    struct Aabb {
+        glm::vec3 min{ 0.0f };
+        glm::vec3 max{ 0.0f };
+
+        glm::vec3 center() const { return (min + max) * 0.5f; }
+        glm::vec3 extents() const { return (max - min) * 0.5f; }
+
+        bool overlaps(const Aabb& other) const {
+            return min.x <= other.max.x && max.x >= other.min.x &&
+                   min.y <= other.max.y && max.y >= other.min.y &&
+                   min.z <= other.max.z && max.z >= other.min.z;
+        }
+        bool contains(const Aabb& other) const {
+            return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+                   max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+        }
+        bool contains(const glm::vec3& p) const {
+            return p.x >= min.x && p.y >= min.y && p.z >= min.z && p.x <= max.x && p.y <= max.y && p.z <= max.z;
+        }
+
+        // Half the surface area; only ratios matter for the SAH.
+        float area() const {
+            const glm::vec3 d = max - min;
+            return d.x * d.y + d.y * d.z + d.z * d.x;
+        }
+
+        Aabb fattened(float margin) const { return { min - glm::vec3(margin), max + glm::vec3(margin) }; }
+
+        static Aabb merge(const Aabb& a, const Aabb& b) { return { glm::min(a.min, b.min), glm::max(a.max, b.max) }; }
+
+        // Slab test; returns the entry distance along `direction` in [0, maxT], or a negative value on a miss.
+        float rayCast(const glm::vec3& origin, const glm::vec3& direction, float maxT) const {
+            float tMin = 0.0f, tMax = maxT;
+            for (int axis = 0; axis < 3; ++axis) {
+                if (direction[axis] == 0.0f) {
+                    if (origin[axis] < min[axis] || origin[axis] > max[axis]) return -1.0f;
+                    continue;
+                }
+                const float inv = 1.0f / direction[axis];
+                float t0 = (min[axis] - origin[axis]) * inv;
+                float t1 = (max[axis] - origin[axis]) * inv;
+                if (t0 > t1) std::swap(t0, t1);
+                tMin = std::max(tMin, t0);
+                tMax = std::min(tMax, t1);
+                if (tMin > tMax) return -1.0f;
+            }
+            return tMin;
+        }
+    };
+
+} // namespace physics
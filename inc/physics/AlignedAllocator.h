@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace physics {
+
+    // Allocator that hands out storage aligned to `Alignment` bytes (a cache line by default),
+    // so SoA columns start on vector-register boundaries.
+    template <typename T, std::size_t Alignment = 64>
+    struct AlignedAllocator {
+        using value_type = T;
+
+        template <typename U>
+        struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+        AlignedAllocator() noexcept = default;
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+        T* allocate(std::size_t count) {
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+        }
+        void deallocate(T* pointer, std::size_t) noexcept {
+            ::operator delete(pointer, std::align_val_t(Alignment));
+        }
+
+        template <typename U>
+        bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+        template <typename U>
+        bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+    };
+
+    template <typename T>
+    using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+} // namespace physics
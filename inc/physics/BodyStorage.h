@@ -0,0 +1,76 @@
+#pragma once
+#include "AlignedAllocator.h"
+#include "Shape.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <array>
+#include <cstdint>
+
+namespace physics {
+
+    enum BodyFlags : uint32_t {
+        kBodyStatic = 1u << 0,    // Infinite mass, never integrated.
+        kBodyKinematic = 1u << 1, // Moved by velocity only, ignores forces and contacts.
+        kBodySleeping = 1u << 2,
+        kBodyBullet = 1u << 3,    // Wants continuous collision detection.
+    };
+
+    // Dense structure-of-arrays body state. Every column has the same length and index i
+    // describes the same body in all of them; kernels stream each column independently.
+    struct BodyStorage {
+        AlignedVector<float> positionX, positionY, positionZ;
+        AlignedVector<float> orientationW, orientationX, orientationY, orientationZ;
+        AlignedVector<float> velocityX, velocityY, velocityZ;
+        AlignedVector<float> angularVelocityX, angularVelocityY, angularVelocityZ;
+        AlignedVector<float> forceX, forceY, forceZ;
+        AlignedVector<float> torqueX, torqueY, torqueZ;
+        AlignedVector<float> inverseMass;
+        // Inverse inertia about the body's principal axes (local space).
+        AlignedVector<float> inverseInertiaX, inverseInertiaY, inverseInertiaZ;
+        // Transform before the last step, for render interpolation.
+        AlignedVector<float> previousPositionX, previousPositionY, previousPositionZ;
+        AlignedVector<float> previousOrientationW, previousOrientationX, previousOrientationY, previousOrientationZ;
+        AlignedVector<uint32_t> flags;
+        AlignedVector<uint32_t> restSteps; // Consecutive steps spent below the sleep threshold.
+        std::vector<Shape> shapes; // Cold data: only read by collision code.
+
+        static constexpr size_t kFloatColumns = 30;
+
+        size_t size() const { return flags.size(); }
+        void reserve(size_t capacity);
+        // Appends a zeroed body with identity orientation; returns its index.
+        size_t push();
+        // Moves the last body into `index` and shrinks by one.
+        void swapRemove(size_t index);
+        // Exchanges two bodies in every column.
+        void swap(size_t a, size_t b);
+        void clear();
+
+        glm::vec3 position(size_t i) const { return { positionX[i], positionY[i], positionZ[i] }; }
+        void setPosition(size_t i, const glm::vec3& p) { positionX[i] = p.x; positionY[i] = p.y; positionZ[i] = p.z; }
+        glm::quat orientation(size_t i) const { return glm::quat(orientationW[i], orientationX[i], orientationY[i], orientationZ[i]); }
+        void setOrientation(size_t i, const glm::quat& q) { orientationW[i] = q.w; orientationX[i] = q.x; orientationY[i] = q.y; orientationZ[i] = q.z; }
+        glm::vec3 velocity(size_t i) const { return { velocityX[i], velocityY[i], velocityZ[i] }; }
+        void setVelocity(size_t i, const glm::vec3& v) { velocityX[i] = v.x; velocityY[i] = v.y; velocityZ[i] = v.z; }
+        glm::vec3 angularVelocity(size_t i) const { return { angularVelocityX[i], angularVelocityY[i], angularVelocityZ[i] }; }
+        void setAngularVelocity(size_t i, const glm::vec3& w) { angularVelocityX[i] = w.x; angularVelocityY[i] = w.y; angularVelocityZ[i] = w.z; }
+        glm::vec3 previousPosition(size_t i) const { return { previousPositionX[i], previousPositionY[i], previousPositionZ[i] }; }
+        glm::quat previousOrientation(size_t i) const {
+            return glm::quat(previousOrientationW[i], previousOrientationX[i], previousOrientationY[i], previousOrientationZ[i]);
+        }
+        // Copies the current transform into the previous one, so the body renders without blending.
+        void storePreviousTransform(size_t i) {
+            previousPositionX[i] = positionX[i]; previousPositionY[i] = positionY[i]; previousPositionZ[i] = positionZ[i];
+            previousOrientationW[i] = orientationW[i]; previousOrientationX[i] = orientationX[i];
+            previousOrientationY[i] = orientationY[i]; previousOrientationZ[i] = orientationZ[i];
+        }
+        glm::vec3 inverseInertia(size_t i) const { return { inverseInertiaX[i], inverseInertiaY[i], inverseInertiaZ[i] }; }
+
+        // World-space inverse inertia tensor: R * diag(I^-1) * R^T.
+        glm::mat3 inverseInertiaWorld(size_t i) const;
+
+    private:
+        std::array<AlignedVector<float>*, kFloatColumns> floatColumns();
+    };
+
+} // namespace physics
@@ -0,0 +1,61 @@
+#pragma once
+#include "Narrowphase.h"
+#include <cstdint>
+#include <vector>
+
+namespace physics {
+
+    struct Contact {
+        uint32_t bodyA;   // Body ids, bodyA < bodyB; the manifold normal points from A to B.
+        uint32_t bodyB;
+        ContactManifold manifold;
+    };
+
+    // Copies accumulated impulses from `previous` to the points of `current` with the same feature
+    // id; unmatched points start from zero. Nothing carries over if the normal turned too far.
+    void matchContactPoints(const ContactManifold& previous, ContactManifold& current);
+
+    // Manifolds that outlive a step, keyed by body pair. Contacts live in a dense array (what the
+    // solver iterates); a linear-probing table of {pair key, dense index} finds them, and removals
+    // use backward-shift deletion so lookups never wade through tombstones.
+    class ContactCache {
+    public:
+        ContactCache();
+
+        // Safe to call from several threads as long as nothing is being stored or erased.
+        const Contact* find(uint32_t bodyA, uint32_t bodyB) const;
+        // Inserts or replaces the manifold for the contact's pair and marks it as touched.
+        void store(const Contact& contact);
+        // Marks the pair's manifold as still current without recomputing it (e.g. both bodies asleep).
+        void keep(uint32_t bodyA, uint32_t bodyB);
+        // Drops every pair not stored since the previous call, then clears the touched marks.
+        void eraseUntouched();
+        void eraseBody(uint32_t bodyId);
+        void clear();
+
+        std::vector<Contact>& getContacts() { return contacts_; }
+        const std::vector<Contact>& getContacts() const { return contacts_; }
+        size_t size() const { return contacts_.size(); }
+        size_t getCapacity() const { return slots_.size(); }
+
+    private:
+        struct Slot {
+            uint64_t key;
+            uint32_t index;
+        };
+
+        static constexpr uint64_t kEmptyKey = UINT64_MAX;
+        static uint64_t keyOf(uint32_t bodyA, uint32_t bodyB) { return (uint64_t(bodyA) << 32) | bodyB; }
+        size_t homeOf(uint64_t key) const { return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> shift_); }
+        size_t findSlot(uint64_t key) const;
+        void eraseSlot(size_t slot);
+        void removeAt(size_t index);
+        void rehash(size_t capacity);
+
+        std::vector<Slot> slots_;         // Power of two, at most half full.
+        std::vector<Contact> contacts_;
+        std::vector<uint8_t> touched_;    // Parallel to contacts_.
+        int shift_{ 0 };
+    };
+
+} // namespace physics
@@ -0,0 +1,111 @@
+#pragma once
+#include "BodyStorage.h"
+#include "ContactCache.h"
+#include "SimdFloat.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace physics {
+
+    struct ContactSolverSettings {
+        int iterations{ 8 };
+        float friction{ 0.5f };
+        float baumgarte{ 0.2f };    // Fraction of the penetration removed per step.
+        float slop{ 0.005f };       // Penetration left alone so resting contacts stay touching.
+        bool warmStarting{ true };  // Start from last step's impulses; disable to compare.
+    };
+
+    // Sequential-impulse contact solver with Coulomb friction (two tangent directions, boxed by
+    // the normal impulse). Penetration is fed back as a velocity bias; separated contacts within
+    // the margin are speculative and only stop the bodies from closing the gap in one step.
+    //
+    // Manifolds are colored so that no two in a color share a dynamic body, then packed
+    // SimdFloat::kWidth to a group. Groups of one color run in parallel on the job system; colors
+    // run in order. Static and kinematic bodies are never written, so they don't count for the
+    // coloring. The outcome depends only on the contact order, not on the thread count.
+    class ContactSolver {
+    public:
+        // Builds constraints for the contacts listed in `contactIndices` from the current body
+        // state. `bodyIndices` holds the dense indices of each listed contact's two bodies.
+        void prepare(const BodyStorage& bodies, const std::vector<Contact>& contacts, const std::vector<uint32_t>& contactIndices,
+                     const std::vector<uint32_t>& bodyIndices, const ContactSolverSettings& settings, float dt);
+        // Applies the impulses carried over in the manifolds.
+        void warmStart(BodyStorage& bodies);
+        void solveVelocities(BodyStorage& bodies);
+        // Writes the accumulated impulses back so the next step can start from them.
+        void storeImpulses(std::vector<Contact>& contacts) const;
+
+        size_t getColorCount() const { return colorGroups_.empty() ? 0 : colorGroups_.size() - 1; }
+        // Manifolds that didn't fit in kMaxColors; solved on the calling thread after the colors.
+        size_t getOverflowCount() const { return overflow_.size(); }
+
+        static constexpr int kMaxColors = 64;
+
+    private:
+        struct PointConstraint {
+            glm::vec3 rA, rB;
+            float normalMass;
+            float tangentMass[2];
+            float bias;
+            float normalImpulse;
+            float tangentImpulse[2];
+        };
+
+        struct ManifoldConstraint {
+            uint32_t contact;
+            uint32_t indexA, indexB;
+            bool dynamicA, dynamicB;
+            float inverseMassA, inverseMassB;
+            glm::mat3 inverseInertiaA, inverseInertiaB;
+            glm::vec3 normal;
+            glm::vec3 tangents[2];
+            float friction;
+            int pointCount;
+            PointConstraint points[ContactManifold::kMaxPoints];
+        };
+
+        static constexpr int kWidth = SimdFloat::kWidth;
+
+        struct WidePoint {
+            SimdVec3 rA, rB;
+            SimdFloat normalMass;
+            SimdFloat tangentMass[2];
+            SimdFloat bias;
+            SimdFloat normalImpulse;
+            SimdFloat tangentImpulse[2];
+        };
+
+        // kWidth manifolds of one color. Unused lanes repeat lane 0's bodies with zero mass and
+        // are never written back.
+        struct WideConstraint {
+            uint32_t constraint[kWidth];         // Index into constraints_, UINT32_MAX for padding.
+            uint32_t indexA[kWidth], indexB[kWidth];
+            uint8_t writeA[kWidth], writeB[kWidth];
+            int pointCount;                      // Largest point count among the lanes.
+            SimdFloat inverseMassA, inverseMassB;
+            SimdFloat inverseInertiaA[6], inverseInertiaB[6]; // Symmetric: xx yy zz xy xz yz.
+            SimdVec3 normal;
+            SimdVec3 tangents[2];
+            SimdFloat friction;
+            WidePoint points[ContactManifold::kMaxPoints];
+        };
+
+        void colorConstraints(const BodyStorage& bodies);
+        void packGroup(WideConstraint& wide) const;
+        template <bool WarmStart>
+        static void solveGroup(BodyStorage& bodies, WideConstraint& wide);
+        static void solveScalar(BodyStorage& bodies, ManifoldConstraint& mc);
+        static void warmStartScalar(BodyStorage& bodies, const ManifoldConstraint& mc);
+        template <typename Fn>
+        void forEachColor(Fn&& fn);
+
+        std::vector<ManifoldConstraint> constraints_;
+        std::vector<WideConstraint> groups_;
+        std::vector<uint32_t> colorGroups_;    // Group range of color c is [colorGroups_[c], colorGroups_[c + 1]).
+        std::vector<uint32_t> overflow_;
+        std::vector<uint64_t> bodyColors_;     // Per dense body, the colors already touching it.
+        std::vector<uint8_t> constraintColors_;
+    };
+
+} // namespace physics
@@ -0,0 +1,65 @@
+#pragma once
+#include "IBroadphase.h"
+#include <cstdint>
+#include <vector>
+
+namespace physics {
+
+    // Bounding-volume hierarchy over fattened AABBs. Leaves only reinsert when a body escapes its
+    // fat box, insertion follows the surface-area heuristic and rotations keep the height balanced.
+    // findPairs() queries only proxies that moved since the last call, in parallel.
+    class DynamicAabbTree : public IBroadphase {
+    public:
+        explicit DynamicAabbTree(float margin = 0.1f, float displacementMultiplier = 2.0f);
+
+        ProxyId createProxy(const Aabb& aabb, uint32_t userData) override;
+        void destroyProxy(ProxyId proxy) override;
+        void moveProxy(ProxyId proxy, const Aabb& aabb, const glm::vec3& displacement) override;
+        void findPairs(std::vector<BroadphasePair>& pairs) override;
+        void queryAabb(const Aabb& aabb, const std::function<bool(uint32_t)>& visitor) const override;
+        void rayCast(const glm::vec3& origin, const glm::vec3& direction, float maxT,
+                     const std::function<float(uint32_t, float)>& visitor) const override;
+        const char* getName() const override { return "AabbTree"; }
+
+        const Aabb& getFatAabb(ProxyId proxy) const override { return nodes_[proxy].aabb; }
+        uint32_t getUserData(ProxyId proxy) const { return nodes_[proxy].userData; }
+        size_t getProxyCount() const { return proxyCount_; }
+        int getHeight() const { return root_ == kNull ? 0 : nodes_[root_].height; }
+        // Sum of node areas over root area; lower is a tighter tree.
+        float getAreaRatio() const;
+
+    private:
+        static constexpr uint32_t kNull = UINT32_MAX;
+
+        struct Node {
+            Aabb aabb;
+            uint32_t parent{ kNull }; // Doubles as the free-list link.
+            uint32_t child1{ kNull };
+            uint32_t child2{ kNull };
+            int32_t height{ -1 };     // 0 for leaves, -1 when free.
+            uint32_t userData{ 0 };
+            bool moved{ false };
+            bool isLeaf() const { return child1 == kNull; }
+        };
+
+        uint32_t allocateNode();
+        void freeNode(uint32_t node);
+        void insertLeaf(uint32_t leaf);
+        void removeLeaf(uint32_t leaf);
+        uint32_t balance(uint32_t a);
+        void refitUpwards(uint32_t node);
+
+        template <typename Visitor>
+        void query(const Aabb& aabb, Visitor&& visitor) const;
+
+        std::vector<Node> nodes_;
+        uint32_t root_{ kNull };
+        uint32_t freeList_{ kNull };
+        size_t proxyCount_{ 0 };
+        std::vector<ProxyId> moveBuffer_;
+        std::vector<std::vector<BroadphasePair>> chunkPairs_;
+        float margin_;
+        float displacementMultiplier_;
+    };
+
+} // namespace physics
@@ -0,0 +1,137 @@
+#pragma once
+#include "Aabb.h"
+#include "AlignedAllocator.h"
+#include "SpatialHashGrid.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace physics {
+
+    class PhysicsWorld;
+    struct Shape;
+
+    struct FluidSettings {
+        // Particles sit 2 * radius apart at rest; the kernel reaches 4 * radius.
+        float particleRadius{ 0.05f };
+        float restDensity{ 1000.0f };
+        uint32_t iterations{ 3 };
+        // XSPH velocity smoothing in [0, 1].
+        float viscosity{ 0.01f };
+        // Artificial pressure that keeps particles from clumping at the free surface, as the
+        // compression it would take to match it at zero distance.
+        float tensileStrength{ 0.1f };
+        // Constraint softening relative to a particle at rest density; larger is softer.
+        float relaxation{ 0.01f };
+        // Steps between Z-order re-sorts of the particle columns.
+        uint32_t reorderInterval{ 8 };
+        glm::vec3 gravity{ 0.0f, -9.81f, 0.0f };
+        // Particles are kept inside this box.
+        Aabb bounds{ glm::vec3(-10.0f, 0.0f, -10.0f), glm::vec3(10.0f, 20.0f, 10.0f) };
+    };
+
+    // Position based fluid (Macklin & Müller): each iteration solves a density constraint per
+    // particle, so it stays stable at rigid body time steps where a pressure-force SPH would not.
+    //
+    // Particles live in SoA columns that are re-sorted along a Z-order curve every few steps, so
+    // neighbours are mostly neighbours in memory too. Neighbour lists are rebuilt every step from
+    // a SpatialHashGrid with cells one kernel radius wide, and the kernel sums run SimdFloat::kWidth
+    // neighbours at a time.
+    //
+    // Coupling with a PhysicsWorld is two-way: particles are pushed out of bodies, and the
+    // momentum that takes goes back to dynamic bodies as a force on their next step.
+    class FluidSystem {
+    public:
+        explicit FluidSystem(const FluidSettings& settings = {});
+
+        void setSettings(const FluidSettings& settings);
+        const FluidSettings& getSettings() const { return settings_; }
+        float getKernelRadius() const { return kernelRadius_; }
+        float getParticleMass() const { return mass_; }
+
+        // Returns the new particle's id, which stays with it across re-sorts.
+        uint32_t addParticle(const glm::vec3& position, const glm::vec3& velocity = glm::vec3(0.0f));
+        // Fills `region` with particles at rest spacing; returns how many were added.
+        size_t addBlock(const Aabb& region, const glm::vec3& velocity = glm::vec3(0.0f));
+        void clear();
+
+        // Advances the fluid by dt. Call after world->step(dt); forces on bodies act in the
+        // world's next step. `world` may be null.
+        void step(float dt, PhysicsWorld* world = nullptr);
+
+        size_t size() const { return ids_.size(); }
+        // Columns in the current (Z-order) particle order.
+        const float* getPositionX() const { return x_.data(); }
+        const float* getPositionY() const { return y_.data(); }
+        const float* getPositionZ() const { return z_.data(); }
+        const float* getVelocityX() const { return vx_.data(); }
+        const float* getVelocityY() const { return vy_.data(); }
+        const float* getVelocityZ() const { return vz_.data(); }
+        const float* getDensity() const { return density_.data(); }
+        const uint32_t* getIds() const { return ids_.data(); }
+        glm::vec3 getPosition(size_t i) const { return { x_[i], y_[i], z_[i] }; }
+        glm::vec3 getVelocity(size_t i) const { return { vx_[i], vy_[i], vz_[i] }; }
+
+        size_t getNeighborPairCount() const { return neighbors_.size(); }
+
+    private:
+        // A body near the fluid, gathered once per step.
+        struct Collider {
+            const Shape* shape;
+            glm::vec3 position;
+            glm::quat orientation;
+            uint32_t bodyIndex;
+            bool dynamic;
+        };
+        // A particle close enough to a collider to touch it this step.
+        struct Contact {
+            uint32_t particle;
+            uint32_t collider;
+            glm::vec3 push; // Total displacement applied to the particle.
+        };
+
+        template <typename Kernel>
+        void forEachChunk(Kernel&& kernel);
+        void reorder();
+        void findNeighbors();
+        void gatherColliders(PhysicsWorld& world);
+        void solveDensity();
+        void applyDelta();
+        void collide();
+        void applyViscosity();
+        void applyCouplingForces(PhysicsWorld& world, float dt);
+
+        FluidSettings settings_;
+        float kernelRadius_{ 0.0f };
+        float mass_{ 0.0f };
+        float poly6_{ 0.0f };          // Density kernel scale.
+        float spikyGradient_{ 0.0f };  // Gradient kernel scale (negative).
+        float restGradient_{ 0.0f };   // Constraint gradient norm of a particle at rest density.
+        float tensileReference_{ 0.0f }; // 1 / (h^2 - (0.2 h)^2), for the artificial pressure.
+        uint32_t stepsSinceReorder_{ 0 };
+        uint32_t nextId_{ 0 };
+
+        // Persistent particle state.
+        AlignedVector<float> x_, y_, z_;
+        AlignedVector<float> vx_, vy_, vz_;
+        AlignedVector<uint32_t> ids_;
+        // Per-step scratch.
+        AlignedVector<float> px_, py_, pz_;    // Predicted positions.
+        AlignedVector<float> lambda_, density_;
+        AlignedVector<float> dx_, dy_, dz_;    // Position corrections, later the smoothed velocities.
+
+        SpatialHashGrid grid_;
+        std::vector<uint32_t> neighborStart_;  // Particle count + 1 offsets into neighbors_.
+        std::vector<uint32_t> neighbors_;      // Sorted per particle; excludes the particle itself.
+        std::vector<std::vector<uint32_t>> chunkNeighbors_;
+        std::vector<uint64_t> codes_;
+        std::vector<uint32_t> order_;
+
+        std::vector<Collider> colliders_;
+        std::vector<Contact> contacts_;         // Sorted by particle.
+        std::vector<uint32_t> contactGroups_;   // Start of each particle's run, plus the end.
+    };
+
+} // namespace physics
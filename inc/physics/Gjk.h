@@ -0,0 +1,44 @@
+#pragma once
+#include "Shape.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace physics {
+
+    // A shape placed in the world, as GJK and EPA see it.
+    struct ConvexInstance {
+        const Shape* shape;
+        glm::vec3 position;
+        glm::quat orientation;
+
+        glm::vec3 support(const glm::vec3& direction) const {
+            return position + orientation * shape->support(glm::conjugate(orientation) * direction);
+        }
+        glm::vec3 coreSupport(const glm::vec3& direction) const {
+            return position + orientation * shape->coreSupport(glm::conjugate(orientation) * direction);
+        }
+    };
+
+    struct GjkResult {
+        bool overlap{ false };      // Cores intersect; distance and witnesses are meaningless.
+        float distance{ 0.0f };     // Between the cores; subtract coreRadius() for surfaces.
+        glm::vec3 pointA{ 0.0f };   // Closest point on A's core.
+        glm::vec3 pointB{ 0.0f };   // Closest point on B's core.
+        int iterations{ 0 };
+    };
+
+    // Closest points between the cores of two convex shapes (see Shape::coreSupport).
+    GjkResult gjkDistance(const ConvexInstance& a, const ConvexInstance& b);
+
+    struct EpaResult {
+        glm::vec3 normal{ 0.0f, 1.0f, 0.0f }; // From A towards B.
+        float depth{ 0.0f };
+        glm::vec3 pointA{ 0.0f };             // Deepest point of A inside B.
+        glm::vec3 pointB{ 0.0f };             // Deepest point of B inside A.
+    };
+
+    // Penetration of two overlapping shapes, using their full surfaces. Returns false if the shapes
+    // turn out not to overlap or the polytope degenerates (touching contact).
+    bool epaPenetration(const ConvexInstance& a, const ConvexInstance& b, EpaResult& result);
+
+} // namespace physics
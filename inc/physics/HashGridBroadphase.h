@@ -0,0 +1,59 @@
+#pragma once
+#include "IBroadphase.h"
+#include "AlignedAllocator.h"
+#include "SpatialHashGrid.h"
+#include <cstdint>
+#include <vector>
+
+namespace physics {
+
+    // Broadphase for many similarly sized bodies: proxy centers are binned into a hashed uniform
+    // grid each findPairs() and every proxy tests the neighbouring cells. Proxies larger than a
+    // cell skip the grid and are tested against everything, so a few big static boxes are fine.
+    class HashGridBroadphase : public IBroadphase {
+    public:
+        // cellSize 0 picks one per call: the median proxy size.
+        explicit HashGridBroadphase(float cellSize = 0.0f, float margin = 0.05f);
+
+        ProxyId createProxy(const Aabb& aabb, uint32_t userData) override;
+        void destroyProxy(ProxyId proxy) override;
+        void moveProxy(ProxyId proxy, const Aabb& aabb, const glm::vec3& displacement) override;
+        void findPairs(std::vector<BroadphasePair>& pairs) override;
+        const Aabb& getFatAabb(ProxyId proxy) const override { return proxies_[proxy].aabb; }
+        void queryAabb(const Aabb& aabb, const std::function<bool(uint32_t)>& visitor) const override;
+        void rayCast(const glm::vec3& origin, const glm::vec3& direction, float maxT,
+                     const std::function<float(uint32_t, float)>& visitor) const override;
+        const char* getName() const override { return "HashGrid"; }
+
+        void setCellSize(float cellSize) { cellSize_ = cellSize; }
+        size_t getProxyCount() const { return proxyCount_; }
+        const SpatialHashGrid& getGrid() const { return grid_; }
+        // Proxies that did not fit a cell in the last findPairs().
+        size_t getOversizedCount() const { return large_.size(); }
+
+    private:
+        struct Proxy {
+            Aabb aabb;
+            uint32_t userData{ 0 };
+            bool alive{ false };
+        };
+
+        float chooseCellSize();
+
+        std::vector<Proxy> proxies_;
+        std::vector<ProxyId> freeProxies_;
+        size_t proxyCount_{ 0 };
+        float cellSize_;
+        float margin_;
+
+        SpatialHashGrid grid_;
+        // Scratch rebuilt by findPairs(): gridded proxies as SoA centers, plus the oversized ones.
+        AlignedVector<float> centerX_, centerY_, centerZ_;
+        std::vector<Aabb> smallAabbs_;
+        std::vector<ProxyId> small_;
+        std::vector<ProxyId> large_;
+        std::vector<float> sizes_;
+        std::vector<std::vector<BroadphasePair>> chunkPairs_;
+    };
+
+} // namespace physics
@@ -0,0 +1,48 @@
+#pragma once
+#include "Aabb.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace physics {
+
+    using ProxyId = uint32_t;
+    constexpr ProxyId kInvalidProxy = UINT32_MAX;
+
+    // Candidate pair of proxy user data (body ids), ordered so that a < b.
+    struct BroadphasePair {
+        uint32_t a;
+        uint32_t b;
+        bool operator==(const BroadphasePair& other) const { return a == other.a && b == other.b; }
+        bool operator<(const BroadphasePair& other) const { return a != other.a ? a < other.a : b < other.b; }
+    };
+
+    // Coarse overlap detection over body bounds. Implementations differ in how they trade
+    // update cost against query cost; the world owns exactly one.
+    class IBroadphase {
+    public:
+        virtual ~IBroadphase() = default;
+
+        virtual ProxyId createProxy(const Aabb& aabb, uint32_t userData) = 0;
+        virtual void destroyProxy(ProxyId proxy) = 0;
+        // `displacement` is the body's motion this step, used to predict where the bounds are heading.
+        virtual void moveProxy(ProxyId proxy, const Aabb& aabb, const glm::vec3& displacement) = 0;
+
+        // Replaces `pairs` with a sorted, deduplicated set containing at least every pair that
+        // began overlapping since the previous call. Pairs that persist may or may not be repeated;
+        // callers keep their own pair set and retire pairs once getFatAabb() boxes separate.
+        virtual void findPairs(std::vector<BroadphasePair>& pairs) = 0;
+        // Bounds the proxy is currently stored with (possibly enlarged by a margin).
+        virtual const Aabb& getFatAabb(ProxyId proxy) const = 0;
+
+        // Calls visitor(userData) for every proxy whose bounds overlap `aabb`; return false to stop.
+        virtual void queryAabb(const Aabb& aabb, const std::function<bool(uint32_t)>& visitor) const = 0;
+        // Calls visitor(userData) for proxies whose bounds the ray hits. The visitor returns the new
+        // max distance (clip), 0 to stop, or the current max to continue unchanged.
+        virtual void rayCast(const glm::vec3& origin, const glm::vec3& direction, float maxT,
+                             const std::function<float(uint32_t, float)>& visitor) const = 0;
+
+        virtual const char* getName() const = 0;
+    };
+
+} // namespace physics
@@ -0,0 +1,20 @@
+#pragma once
+#include "BodyStorage.h"
+#include <cstddef>
+
+namespace physics {
+
+    // Per-step force source (gravity between bodies, fields, ...) run by PhysicsWorld right
+    // before velocities are integrated.
+    class IForceProvider {
+    public:
+        virtual ~IForceProvider() = default;
+
+        // Adds to the force columns of the awake bodies [0, awakeCount). Sleeping bodies follow
+        // them in `bodies` and may still act as sources, but must not be written.
+        virtual void applyForces(BodyStorage& bodies, size_t awakeCount) = 0;
+
+        virtual const char* getName() const = 0;
+    };
+
+} // namespace physics
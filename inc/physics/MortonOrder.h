@@ -0,0 +1,37 @@
+#pragma once
+#include "Aabb.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace physics {
+
+    // Z-order (Morton) codes: sorting points by them keeps points that are close in space close
+    // in memory, and every octree node is a contiguous run of the sorted codes.
+    constexpr int kMortonBitsPerAxis = 21;
+
+    // Spreads the low 21 bits of v so two zero bits follow each one.
+    inline uint64_t mortonSpread(uint32_t v) {
+        uint64_t x = v & 0x1fffffu;
+        x = (x | x << 32) & 0x001f00000000ffffull;
+        x = (x | x << 16) & 0x001f0000ff0000ffull;
+        x = (x | x << 8) & 0x100f00f00f00f00full;
+        x = (x | x << 4) & 0x10c30c30c30c30c3ull;
+        x = (x | x << 2) & 0x1249249249249249ull;
+        return x;
+    }
+
+    // Interleaves three 21-bit cell coordinates as ...z1 y1 x1 z0 y0 x0.
+    inline uint64_t mortonEncode(uint32_t x, uint32_t y, uint32_t z) {
+        return mortonSpread(x) | mortonSpread(y) << 1 | mortonSpread(z) << 2;
+    }
+
+    // Codes of `count` SoA points quantized over `bounds`; points outside clamp to its faces.
+    // Pass a cube for octree use so every level splits all three axes evenly.
+    void computeMortonCodes(const float* x, const float* y, const float* z, size_t count, const Aabb& bounds, uint64_t* codes);
+
+    // Stable parallel LSD radix sort. On return `keys` is ascending and order[i] is the original
+    // position of keys[i]. Digits shared by every key are skipped.
+    void sortMortonCodes(std::vector<uint64_t>& keys, std::vector<uint32_t>& order);
+
+} // namespace physics
@@ -0,0 +1,108 @@
+#pragma once
+#include "IForceProvider.h"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace physics {
+
+    enum class GravityMethod {
+        Direct,        // Exact pairwise sum, O(n^2): reference results and small scenes.
+        BarnesHut,     // Octree walk per point, O(n log n). Error grows with theta and varies between points.
+        FastMultipole, // Cell-to-cell interactions through second-order local expansions, about O(n).
+    };
+
+    struct GravitySettings {
+        GravityMethod method{ GravityMethod::BarnesHut };
+        float gravitationalConstant{ 6.674e-11f };
+        // Opening angle in (0, 1]: a cell of radius r at distance d acts as a whole when r < theta * d.
+        float theta{ 0.5f };
+        // Plummer softening length; keeps close encounters finite. 0 gives plain Newtonian gravity
+        // (e.g. SI-unit orbits), where G m / d^2 must stay within float range for the closest
+        // pairs; coincident points then ignore each other.
+        float softening{ 0.01f };
+        // Most points an octree leaf holds before it splits.
+        uint32_t leafSize{ 16 };
+    };
+
+    // Mutual gravity between all dynamic bodies, as a force provider for PhysicsWorld, or between
+    // arbitrary point masses through computeAccelerations().
+    //
+    // The tree methods sort points by Morton code and build the octree level by level from the
+    // sorted runs, so construction is parallel and points of a node are contiguous. Nodes carry
+    // monopole plus quadrupole moments. Results don't depend on the worker count.
+    //
+    // Sleeping bodies still pull on awake ones but are not pulled until something wakes them.
+    class NBodyGravity : public IForceProvider {
+    public:
+        explicit NBodyGravity(const GravitySettings& settings = {});
+
+        void setSettings(const GravitySettings& settings);
+        const GravitySettings& getSettings() const { return settings_; }
+
+        // Acceleration of each of `count` SoA point masses due to all the others.
+        void computeAccelerations(const float* x, const float* y, const float* z, const float* mass, size_t count,
+                                  float* ax, float* ay, float* az);
+
+        void applyForces(BodyStorage& bodies, size_t awakeCount) override;
+        const char* getName() const override { return "N-Body Gravity"; }
+
+        // Octree of the last tree evaluation, for stats.
+        size_t getNodeCount() const { return nodes_.size(); }
+        size_t getTreeDepth() const { return levelStart_.empty() ? 0 : levelStart_.size() - 1; }
+
+    private:
+        struct Node {
+            glm::vec3 centerOfMass;
+            float mass;
+            float radius;            // Farthest point from centerOfMass.
+            uint32_t begin, end;     // Points, in Morton order.
+            uint32_t firstChild;     // Children are contiguous on the next level.
+            uint32_t childCount;     // 0 for leaves.
+            float quadrupole[6];     // Traceless xx, xy, xz, yy, yz, zz about centerOfMass.
+        };
+
+        // Second-order Taylor expansion of the field about a node's center of mass, accumulated
+        // by the multipole method: the field, its gradient (symmetric, laid out like
+        // Node::quadrupole) and its second derivatives (xxx, xxy, xxz, xyy, xyz, xzz, yyy, yyz, yzz, zzz).
+        struct LocalExpansion {
+            glm::vec3 field;
+            float tidal[6];
+            float third[10];
+        };
+
+        void sortPoints(const float* x, const float* y, const float* z, const float* mass, size_t count);
+        void buildTree();
+        void computeMoments();
+        void evaluateDirect(const float* x, const float* y, const float* z, const float* mass, size_t count,
+                            float* ax, float* ay, float* az) const;
+        void evaluateBarnesHut();
+        void evaluateMultipole();
+        void interact(uint32_t target, uint32_t source);
+        // Adds the pull of `source` at offset r = target center - source center to `local`.
+        void addMultipoleToLocal(LocalExpansion& local, const Node& source, const glm::vec3& r) const;
+        // Softened direct sum of the pull of the points of `source` at p.
+        glm::vec3 sumPoints(const glm::vec3& p, const Node& source) const;
+        glm::vec3 cellAcceleration(const Node& source, const glm::vec3& r) const;
+
+        GravitySettings settings_;
+
+        // Inputs reordered by Morton code, and their accelerations in the same order.
+        std::vector<uint64_t> codes_;
+        std::vector<uint32_t> order_;
+        std::vector<float> px_, py_, pz_, pm_;
+        std::vector<float> ax_, ay_, az_;
+
+        std::vector<Node> nodes_;            // Breadth first; root at 0.
+        std::vector<uint32_t> levelStart_;   // First node of each level, plus the end.
+        std::vector<uint32_t> childCounts_;  // Scratch for building one level.
+        std::vector<LocalExpansion> locals_;
+        std::vector<uint32_t> tasks_;        // Disjoint subtrees the multipole pass runs in parallel.
+
+        // Dynamic bodies gathered by applyForces().
+        std::vector<uint32_t> bodyIndices_;
+        std::vector<float> bodyX_, bodyY_, bodyZ_, bodyMass_, bodyAx_, bodyAy_, bodyAz_;
+    };
+
+} // namespace physics
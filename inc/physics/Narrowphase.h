@@ -0,0 +1,35 @@
+#pragma once
+#include "Shape.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace physics {
+
+    struct ContactPoint {
+        glm::vec3 position;  // World space, halfway between the two surfaces.
+        float depth;         // Penetration; negative while still separated by less than the margin.
+        // Which pair of features (faces, edges, vertices) produced the point. Stable from one step
+        // to the next while the shapes keep touching the same way; single-point contacts use 0.
+        uint32_t feature{ 0 };
+        // Solver impulses, carried over between steps for points with a matching feature id.
+        float normalImpulse{ 0.0f };
+        float tangentImpulse[2]{ 0.0f, 0.0f };
+    };
+
+    struct ContactManifold {
+        static constexpr int kMaxPoints = 4;
+
+        glm::vec3 normal{ 0.0f, 1.0f, 0.0f }; // From A towards B.
+        ContactPoint points[kMaxPoints];
+        int pointCount{ 0 };
+    };
+
+    // Contact generation between two placed shapes. Pairs with a dedicated routine (sphere-sphere,
+    // sphere-box, sphere-capsule, capsule-capsule, box-box SAT) go straight to it through a table
+    // built at compile time; everything else uses GJK, with EPA for penetrating cores. Shapes
+    // separated by more than `margin` produce no contact and return false.
+    bool collide(const Shape& shapeA, const glm::vec3& positionA, const glm::quat& orientationA,
+                 const Shape& shapeB, const glm::vec3& positionB, const glm::quat& orientationB,
+                 float margin, ContactManifold& manifold);
+
+} // namespace physics
@@ -0,0 +1,130 @@
+#pragma once
+#include "AlignedAllocator.h"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace physics {
+
+    class VectorField;
+
+    struct ParticleEmitterDesc {
+        glm::vec3 position{ 0.0f };
+        glm::vec3 extents{ 0.0f };            // Half extents of the box particles spawn in.
+        glm::vec3 velocity{ 0.0f, 1.0f, 0.0f };
+        glm::vec3 velocitySpread{ 0.5f };     // Uniform jitter of up to this much per axis.
+        float rate{ 100.0f };                 // Particles per second.
+        float minLifetime{ 1.0f };
+        float maxLifetime{ 2.0f };
+        float gravityScale{ 1.0f };           // Negative for smoke that rises.
+        float drag{ 0.0f };                   // Fraction of velocity removed per second.
+        // Live particles never exceed this; storage for it is allocated up front.
+        uint32_t capacity{ 1u << 16 };
+        // Interpolated linearly over each particle's life.
+        glm::vec4 startColor{ 1.0f };
+        glm::vec4 endColor{ 1.0f, 1.0f, 1.0f, 0.0f };
+        float startSize{ 0.1f };
+        float endSize{ 0.0f };
+        uint32_t seed{ 1 };
+    };
+
+    // One particle as a per-instance vertex: position and size fill one vec4 attribute, then
+    // RGBA8 colour (red in the low byte), 20 bytes tightly packed.
+    struct ParticleInstance {
+        float x, y, z, size;
+        uint32_t color;
+    };
+
+    // Effects particles: no collisions or interaction, just emitters, gravity, drag and the same
+    // acceleration fields PhysicsWorld applies to bodies.
+    //
+    // Each emitter owns a pool of SoA columns sized to its capacity, so stepping never
+    // allocates. A step first counts the survivors of every chunk, then integrates the chunks
+    // SimdFloat::kWidth particles at a time in parallel and writes the survivors straight into
+    // a second set of columns at their prefix-summed offsets. Dead particles are dropped by that
+    // stream compaction and order is kept, so results don't depend on the worker count.
+    class ParticleSystem {
+    public:
+        ParticleSystem() = default;
+
+        void setGravity(const glm::vec3& gravity) { gravity_ = gravity; }
+        glm::vec3 getGravity() const { return gravity_; }
+
+        // Reuses the slot of a removed emitter if there is one.
+        uint32_t addEmitter(const ParticleEmitterDesc& desc);
+        // A smaller capacity drops the newest particles.
+        void setEmitter(uint32_t emitter, const ParticleEmitterDesc& desc);
+        const ParticleEmitterDesc& getEmitter(uint32_t emitter) const { return emitters_[emitter].desc; }
+        void setEmitterPosition(uint32_t emitter, const glm::vec3& position) { emitters_[emitter].desc.position = position; }
+        // Stops continuous emission; live particles play out.
+        void setEmitting(uint32_t emitter, bool emitting) { emitters_[emitter].emitting = emitting; }
+        void removeEmitter(uint32_t emitter);
+        // Spawns `count` particles at once on the next step.
+        void burst(uint32_t emitter, uint32_t count);
+        void clear();
+
+        // Adds scale * field(position) to the acceleration of every live particle for the next
+        // step, as PhysicsWorld::applyAccelerationField does for bodies.
+        void applyAccelerationField(const VectorField& field, float scale = 1.0f);
+
+        void step(float dt);
+
+        size_t size() const;
+        size_t getEmitterCount() const { return emitters_.size(); }
+        size_t getParticleCount(uint32_t emitter) const { return emitters_[emitter].count; }
+        // Columns of an emitter's live particles, oldest first.
+        const float* getPositionX(uint32_t emitter) const { return emitters_[emitter].live.x.data(); }
+        const float* getPositionY(uint32_t emitter) const { return emitters_[emitter].live.y.data(); }
+        const float* getPositionZ(uint32_t emitter) const { return emitters_[emitter].live.z.data(); }
+        const float* getVelocityX(uint32_t emitter) const { return emitters_[emitter].live.vx.data(); }
+        const float* getVelocityY(uint32_t emitter) const { return emitters_[emitter].live.vy.data(); }
+        const float* getVelocityZ(uint32_t emitter) const { return emitters_[emitter].live.vz.data(); }
+        // Fraction of its lifetime each particle has lived, in [0, 1).
+        const float* getLife(uint32_t emitter) const { return emitters_[emitter].live.life.data(); }
+
+        // Writes up to `capacity` instances, emitter by emitter, and returns how many. Size and
+        // colour are evaluated over life here, so they cost nothing when nothing is drawn.
+        size_t writeInstances(ParticleInstance* out, size_t capacity) const;
+        size_t writeInstances(std::vector<ParticleInstance>& out) const;
+
+    private:
+        struct Columns {
+            AlignedVector<float> x, y, z;
+            AlignedVector<float> vx, vy, vz;
+            AlignedVector<float> life, lifeRate; // Fraction of life lived, and its rate per second.
+            void resize(size_t size);
+        };
+        struct Emitter {
+            ParticleEmitterDesc desc;
+            Columns live, spare;
+            AlignedVector<float> ax, ay, az; // Field accelerations; allocated on first use.
+            size_t count{ 0 };
+            bool accelerated{ false };       // ax/ay/az hold this step's fields.
+            bool emitting{ true };
+            bool removed{ false };
+            float spawnDebt{ 0.0f };         // Fractional particles carried over between steps.
+            uint32_t pendingBurst{ 0 };
+            uint32_t spawned{ 0 };           // Spawn counter, the random streams' index.
+        };
+        // A run of one emitter's particles, the unit of parallel work.
+        struct Chunk {
+            uint32_t emitter;
+            uint32_t begin, end;
+            uint32_t survivors;              // Then their offset in the compacted columns.
+        };
+
+        // Splits every emitter's live particles into runs of at most kChunkSize.
+        void collectChunks(std::vector<Chunk>& chunks) const;
+        // Calls kernel(emitter, begin, end) for runs of every emitter's live particles, in parallel.
+        template <typename Kernel>
+        void forEachChunk(Kernel&& kernel) const;
+        void integrate(float dt);
+        void emit(Emitter& emitter, float dt);
+
+        glm::vec3 gravity_{ 0.0f, -9.81f, 0.0f };
+        std::vector<Emitter> emitters_;
+        std::vector<Chunk> chunks_;
+    };
+
+} // namespace physics
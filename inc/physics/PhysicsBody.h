@@ -0,0 +1,41 @@
+#pragma once
+#include "PhysicsWorld.h"
+
+namespace physics {
+
+    // Convenience wrapper pairing a world with a body handle. Cheap to copy; does not own the body.
+    class PhysicsBody {
+    public:
+        PhysicsBody() = default;
+        PhysicsBody(PhysicsWorld& world, BodyHandle handle) : world_(&world), handle_(handle) {}
+
+        static PhysicsBody create(PhysicsWorld& world, const BodyDesc& desc);
+        void destroy();
+
+        bool isValid() const { return world_ && world_->isValid(handle_); }
+        BodyHandle getHandle() const { return handle_; }
+
+        glm::vec3 getPosition() const { return world_->getPosition(handle_); }
+        void setPosition(const glm::vec3& position) { world_->setPosition(handle_, position); }
+        glm::quat getOrientation() const { return world_->getOrientation(handle_); }
+        void setOrientation(const glm::quat& orientation) { world_->setOrientation(handle_, orientation); }
+        glm::vec3 getVelocity() const { return world_->getVelocity(handle_); }
+        void setVelocity(const glm::vec3& velocity) { world_->setVelocity(handle_, velocity); }
+        glm::vec3 getAngularVelocity() const { return world_->getAngularVelocity(handle_); }
+        void setAngularVelocity(const glm::vec3& angularVelocity) { world_->setAngularVelocity(handle_, angularVelocity); }
+
+        void applyForce(const glm::vec3& force) { world_->applyForce(handle_, force); }
+        void applyForceAtPoint(const glm::vec3& force, const glm::vec3& point) { world_->applyForceAtPoint(handle_, force, point); }
+        void applyTorque(const glm::vec3& torque) { world_->applyTorque(handle_, torque); }
+        void applyImpulse(const glm::vec3& impulse) { world_->applyImpulse(handle_, impulse); }
+
+        uint32_t getFlags() const { return world_->getFlags(handle_); }
+        bool isSleeping() const { return world_->isSleeping(handle_); }
+        void wake() { world_->wakeBody(handle_); }
+
+    private:
+        PhysicsWorld* world_{ nullptr };
+        BodyHandle handle_;
+    };
+
+} // namespace physics
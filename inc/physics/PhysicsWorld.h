@@ -0,0 +1,239 @@
+#pragma once
+#include "BodyStorage.h"
+#include "ContactCache.h"
+#include "ContactSolver.h"
+#include "IBroadphase.h"
+#include "IForceProvider.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace physics {
+
+    class VectorField;
+
+    // Stable reference to a body. The generation invalidates handles whose slot was reused.
+    struct BodyHandle {
+        uint32_t id{ UINT32_MAX };
+        uint32_t generation{ 0 };
+
+        bool operator==(const BodyHandle& other) const { return id == other.id && generation == other.generation; }
+        bool operator!=(const BodyHandle& other) const { return !(*this == other); }
+    };
+
+    struct BodyDesc {
+        glm::vec3 position{ 0.0f };
+        glm::quat orientation{ 1.0f, 0.0f, 0.0f, 0.0f };
+        glm::vec3 velocity{ 0.0f };
+        glm::vec3 angularVelocity{ 0.0f };
+        float mass{ 1.0f };                 // 0 makes the body static.
+        // Principal moments; 0 on an axis locks rotation about it. Derived from the shape when unset.
+        std::optional<glm::vec3> inertia;
+        Shape shape;
+        uint32_t flags{ 0 };
+    };
+
+    enum class BroadphaseType {
+        AabbTree,      // General purpose; cheap when most bodies are at rest.
+        SweepAndPrune, // Dense scenes where nearly everything moves every step.
+        HashGrid,      // Thousands of same-size bodies.
+    };
+
+    struct RayHit {
+        BodyHandle body;
+        float distance;
+    };
+
+    // How getRenderPosition/getRenderOrientation fill the time between fixed steps.
+    enum class RenderBlend {
+        Interpolate, // Between the last two steps: smooth, one step behind.
+        Extrapolate, // Ahead of the last step along the current velocity: no lag, can overshoot contacts.
+    };
+
+    // Rigid-body world with structure-of-arrays state. Handles map to dense indices through a
+    // sparse table so removal stays O(1) and the per-step kernels always see packed columns.
+    class PhysicsWorld {
+    public:
+        PhysicsWorld();
+
+        BodyHandle createBody(const BodyDesc& desc);
+        bool destroyBody(BodyHandle handle);
+        bool isValid(BodyHandle handle) const;
+        size_t getBodyCount() const { return bodies_.size(); }
+
+        // Dense index of a live body, or nullopt. Indices change when bodies are destroyed, fall
+        // asleep or wake up: awake bodies are kept in front so the step kernels skip the rest.
+        std::optional<size_t> indexOf(BodyHandle handle) const;
+        BodyHandle handleAt(size_t index) const { return denseToHandle_[index]; }
+
+        glm::vec3 getPosition(BodyHandle handle) const;
+        void setPosition(BodyHandle handle, const glm::vec3& position);
+        glm::quat getOrientation(BodyHandle handle) const;
+        void setOrientation(BodyHandle handle, const glm::quat& orientation);
+        glm::vec3 getVelocity(BodyHandle handle) const;
+        void setVelocity(BodyHandle handle, const glm::vec3& velocity);
+        glm::vec3 getAngularVelocity(BodyHandle handle) const;
+        void setAngularVelocity(BodyHandle handle, const glm::vec3& angularVelocity);
+
+        // Accumulated until the end of the next step.
+        void applyForce(BodyHandle handle, const glm::vec3& force);
+        void applyForceAtPoint(BodyHandle handle, const glm::vec3& force, const glm::vec3& worldPoint);
+        void applyTorque(BodyHandle handle, const glm::vec3& torque);
+        void applyImpulse(BodyHandle handle, const glm::vec3& impulse);
+        // Adds mass * scale * field(position) to the force of every awake dynamic body, e.g. wind
+        // given as an acceleration. Sleeping bodies are left alone.
+        void applyAccelerationField(const VectorField& field, float scale = 1.0f);
+        // Providers run at the start of every step, in the order they were added.
+        void addForceProvider(std::shared_ptr<IForceProvider> provider);
+        void removeForceProvider(const IForceProvider* provider);
+        uint32_t getFlags(BodyHandle handle) const;
+
+        void setGravity(const glm::vec3& gravity) { gravity_ = gravity; }
+        glm::vec3 getGravity() const { return gravity_; }
+        void setDamping(float linear, float angular) { linearDamping_ = linear; angularDamping_ = angular; }
+        void setSolverSettings(const ContactSolverSettings& settings) { solverSettings_ = settings; }
+        const ContactSolverSettings& getSolverSettings() const { return solverSettings_; }
+
+        void step(float dt);
+
+        // Steps are bit-identical across runs and worker counts either way: every parallel phase
+        // writes disjoint outputs in fixed chunks and pairs are sorted by body id. Deterministic
+        // mode also solves contacts in body-id order instead of the contact cache's insertion
+        // order, so a step no longer depends on the order contacts were made in, and records
+        // getStepChecksum() after every step. Bit-exact results across builds also need the
+        // PHYSICS_STRICT_FP CMake option (no FMA contraction) and the same compiler and libm.
+        void setDeterministic(bool enabled);
+        bool isDeterministic() const { return deterministic_; }
+        // Hash of the id, generation, flags, transform and velocities of every body, in id order,
+        // for spotting diverging simulations (e.g. a desynced network peer). Not cryptographic.
+        uint64_t computeChecksum() const;
+        // computeChecksum() after the last step, or 0 outside deterministic mode.
+        uint64_t getStepChecksum() const { return stepChecksum_; }
+
+        // Transform to draw at `alpha` (0..1) of a step past the last one, e.g. SimulationClock::getAlpha().
+        // Teleports and newly created bodies snap instead of blending.
+        glm::vec3 getRenderPosition(BodyHandle handle, float alpha, RenderBlend blend = RenderBlend::Interpolate) const;
+        glm::quat getRenderOrientation(BodyHandle handle, float alpha, RenderBlend blend = RenderBlend::Interpolate) const;
+
+        // Islands (bodies linked by contacts) whose kinetic energy per unit mass stays below
+        // `energyThreshold` for `steps` consecutive steps fall asleep together. Sleeping bodies are
+        // skipped by integration, broadphase updates and the solver until something wakes them:
+        // contact with a moving body, a force, impulse or velocity change, or a teleport.
+        void setSleepEnabled(bool enabled);
+        void setSleepThreshold(float energyThreshold, uint32_t steps) { sleepEnergy_ = energyThreshold; sleepSteps_ = steps; }
+        bool isSleeping(BodyHandle handle) const;
+        // Wakes the body's whole island.
+        void wakeBody(BodyHandle handle);
+        // Awake dynamic and kinematic bodies: the dense range [0, getAwakeCount()).
+        size_t getAwakeCount() const { return activeCount_; }
+        // Awake islands found by the last step.
+        size_t getIslandCount() const { return islandCount_; }
+        size_t getSleepingIslandCount() const { return sleepingIslands_.size() - freeIslands_.size(); }
+
+        // Swaps the broadphase; existing bodies are re-registered with the new one.
+        void setBroadphase(BroadphaseType type);
+        BroadphaseType getBroadphaseType() const { return broadphaseType_; }
+        IBroadphase& getBroadphase() { return *broadphase_; }
+        // Candidate pairs (body ids) whose bounds overlap, maintained across steps.
+        const std::vector<BroadphasePair>& getPairs() const { return pairs_; }
+        // Touching (or nearly touching) pairs found by the last step's narrowphase, with the
+        // impulses the solver applied to them.
+        const std::vector<Contact>& getContacts() const { return contactCache_.getContacts(); }
+
+        // Nearest body hit by a ray, e.g. for picking under the cursor.
+        std::optional<RayHit> rayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const;
+        // Visits bodies whose bounds overlap `aabb`; return false from the visitor to stop.
+        void queryAabb(const Aabb& aabb, const std::function<bool(BodyHandle)>& visitor) const;
+
+        // Direct column access for kernels (broadphase, solver, debug draw).
+        BodyStorage& getBodies() { return bodies_; }
+        const BodyStorage& getBodies() const { return bodies_; }
+
+    private:
+        struct Slot {
+            uint32_t dense{ UINT32_MAX };
+            uint32_t generation{ 0 };
+            ProxyId proxy{ kInvalidProxy };
+            uint32_t island{ kNoIsland }; // Sleeping island, if asleep.
+        };
+
+        static constexpr uint32_t kNoIsland = UINT32_MAX;
+
+        void storePreviousTransforms();
+        void integrateVelocities(float dt);
+        void integratePositions(float dt);
+        // Pulls awake bullets back to their first time of impact along this step's motion.
+        void solveTimeOfImpact();
+        void clearForces();
+        void synchronizeBroadphase(float dt);
+        void updatePairs();
+        void updateContacts();
+        void solveContacts(float dt);
+        void updateIslands();
+        void sleepIsland(const std::vector<uint32_t>& bodyIds);
+        void wakeIsland(uint32_t bodyId);
+        // Wakes every sleeping body in contact with `bodyId`.
+        void wakeTouching(uint32_t bodyId);
+        // Awake dynamic or kinematic, i.e. inside the awake dense range.
+        bool isActive(uint32_t bodyId) const { return slots_[bodyId].dense < activeCount_; }
+        void activate(size_t index);
+        void deactivate(size_t index);
+        void swapDense(size_t a, size_t b);
+        float specificKineticEnergy(size_t index) const;
+        bool isDynamicBody(uint32_t bodyId) const;
+        BodyHandle handleOfId(uint32_t bodyId) const { return { bodyId, slots_[bodyId].generation }; }
+        // Runs kernel(begin, end) over the awake dense range in parallel chunks.
+        template <typename Kernel>
+        void forEachChunk(Kernel&& kernel);
+
+        static constexpr size_t kChunkSize = 1024;
+        static constexpr size_t kPairChunkSize = 64;
+        // Shapes closer than this already get (speculative) contacts.
+        static constexpr float kContactMargin = 0.02f;
+        // Gap a bullet is left at after a time-of-impact clamp; inside the margin, so the next
+        // contact update turns it into a speculative contact.
+        static constexpr float kTimeOfImpactTarget = 0.25f * kContactMargin;
+
+        BodyStorage bodies_;
+        std::vector<Slot> slots_;
+        std::vector<uint32_t> freeSlots_;
+        std::vector<BodyHandle> denseToHandle_;
+        std::unique_ptr<IBroadphase> broadphase_;
+        std::vector<std::shared_ptr<IForceProvider>> forceProviders_;
+        BroadphaseType broadphaseType_{ BroadphaseType::AabbTree };
+        std::vector<Aabb> bounds_;            // Awake range, refreshed each step.
+        std::vector<BroadphasePair> pairs_;
+        std::vector<BroadphasePair> newPairs_;
+        std::vector<BroadphasePair> mergedPairs_;
+        ContactCache contactCache_;           // Persistent manifolds, keyed by body pair.
+        std::vector<Contact> pairContacts_;   // One slot per pair, filled in parallel.
+        ContactSolver solver_;
+        ContactSolverSettings solverSettings_;
+        std::vector<uint32_t> activeContacts_; // Contacts with an awake body, solved this step.
+        std::vector<uint32_t> contactBodies_;  // Dense indices of each solved contact's bodies.
+        size_t activeCount_{ 0 };
+        std::vector<uint32_t> islandParent_;   // Union-find over the awake range.
+        std::vector<uint32_t> islandRest_;     // Fewest rest steps per island root.
+        std::vector<uint32_t> islandSlot_;     // Root -> index into sleepers_, while collecting.
+        std::vector<std::vector<uint32_t>> sleepers_;
+        std::vector<std::vector<uint32_t>> sleepingIslands_; // Body ids per sleeping island.
+        std::vector<uint32_t> freeIslands_;
+        size_t islandCount_{ 0 };
+        bool sleepEnabled_{ true };
+        float sleepEnergy_{ 0.002f };
+        uint32_t sleepSteps_{ 30 };
+        glm::vec3 gravity_{ 0.0f, -9.81f, 0.0f };
+        float linearDamping_{ 0.01f };
+        float angularDamping_{ 0.05f };
+        float lastStepDt_{ 0.0f };
+        bool deterministic_{ false };
+        uint64_t stepChecksum_{ 0 };
+        std::vector<uint32_t> bullets_;       // Awake bullet dense indices, refreshed each step.
+        std::vector<float> bulletImpacts_;    // Time of impact per entry of bullets_.
+    };
+
+} // namespace physics
@@ -0,0 +1,63 @@
+#pragma once
+#include "Aabb.h"
+#include "AlignedAllocator.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace physics {
+
+    enum class ShapeType : uint8_t { Sphere, Box, Capsule, Cylinder, ConvexHull, Count };
+    constexpr size_t kShapeTypeCount = static_cast<size_t>(ShapeType::Count);
+
+    // Hull vertices in SoA columns, padded to a multiple of four by repeating the first vertex,
+    // so support queries scan four vertices per instruction.
+    struct ConvexHullData {
+        AlignedVector<float> x, y, z;
+        size_t count{ 0 };
+        Aabb bounds;
+
+        glm::vec3 vertex(size_t i) const { return { x[i], y[i], z[i] }; }
+        // Index of the vertex farthest along `direction`.
+        size_t supportIndex(const glm::vec3& direction) const;
+    };
+
+    // Collision geometry in body-local space, centred on the body origin. Capsules and
+    // cylinders run along the local Y axis.
+    struct Shape {
+        ShapeType type{ ShapeType::Sphere };
+        float radius{ 0.5f };              // Sphere, capsule and cylinder radius.
+        float halfHeight{ 0.0f };          // Capsule segment / cylinder half length.
+        glm::vec3 halfExtents{ 0.5f };     // Box only.
+        std::shared_ptr<const ConvexHullData> hull;
+
+        static Shape sphere(float radius);
+        static Shape box(const glm::vec3& halfExtents);
+        static Shape capsule(float radius, float halfHeight);
+        static Shape cylinder(float radius, float halfHeight);
+        // Uses the points as given; interior points are harmless but cost support time.
+        static Shape convexHull(const std::vector<glm::vec3>& points);
+
+        // Farthest point along a local-space direction.
+        glm::vec3 support(const glm::vec3& direction) const;
+        // Spheres and capsules are a point or segment inflated by radius. GJK runs on that core
+        // and adds the radius back, which is both faster and exact for round shapes.
+        glm::vec3 coreSupport(const glm::vec3& direction) const;
+        float coreRadius() const { return type == ShapeType::Sphere || type == ShapeType::Capsule ? radius : 0.0f; }
+
+        Aabb computeAabb(const glm::vec3& position, const glm::quat& orientation) const;
+        // Distance from the body origin to the farthest surface point (or a bound on it).
+        float boundingRadius() const;
+        // Distance from a local-space point to the surface, negative inside, and the outward
+        // normal at the closest surface point. Hulls use GJK outside and EPA inside.
+        float signedDistance(const glm::vec3& point, glm::vec3& normal) const;
+        // Principal moments of inertia for a solid shape of the given mass.
+        glm::vec3 computeInertia(float mass) const;
+        // Entry distance of a world-space ray, or a negative value on a miss.
+        float rayCast(const glm::vec3& position, const glm::quat& orientation,
+                      const glm::vec3& origin, const glm::vec3& direction, float maxT) const;
+    };
+
+} // namespace physics
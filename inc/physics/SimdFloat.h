@@ -0,0 +1,111 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define PHYSICS_SIMD_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PHYSICS_SIMD_SSE 1
+#endif
+
+namespace physics {
+
+    // Packed floats at the widest width the build targets: 8 lanes with AVX, 4 with SSE and a
+    // plain 4-lane array elsewhere. Only the handful of operations the wide kernels use.
+    struct SimdFloat {
+#if defined(PHYSICS_SIMD_AVX)
+        static constexpr int kWidth = 8;
+        __m256 v;
+
+        static SimdFloat zero() { return { _mm256_setzero_ps() }; }
+        static SimdFloat splat(float x) { return { _mm256_set1_ps(x) }; }
+        static SimdFloat load(const float* p) { return { _mm256_loadu_ps(p) }; }
+        void store(float* p) const { _mm256_storeu_ps(p, v); }
+        friend SimdFloat operator+(SimdFloat a, SimdFloat b) { return { _mm256_add_ps(a.v, b.v) }; }
+        friend SimdFloat operator-(SimdFloat a, SimdFloat b) { return { _mm256_sub_ps(a.v, b.v) }; }
+        friend SimdFloat operator*(SimdFloat a, SimdFloat b) { return { _mm256_mul_ps(a.v, b.v) }; }
+        friend SimdFloat operator/(SimdFloat a, SimdFloat b) { return { _mm256_div_ps(a.v, b.v) }; }
+        friend SimdFloat sqrt(SimdFloat a) { return { _mm256_sqrt_ps(a.v) }; }
+        friend SimdFloat min(SimdFloat a, SimdFloat b) { return { _mm256_min_ps(a.v, b.v) }; }
+        friend SimdFloat max(SimdFloat a, SimdFloat b) { return { _mm256_max_ps(a.v, b.v) }; }
+        SimdFloat truncate() const { return { _mm256_round_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC) }; }
+        void storeTruncated(int32_t* p) const { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm256_cvttps_epi32(v)); }
+#elif defined(PHYSICS_SIMD_SSE)
+        static constexpr int kWidth = 4;
+        __m128 v;
+
+        static SimdFloat zero() { return { _mm_setzero_ps() }; }
+        static SimdFloat splat(float x) { return { _mm_set1_ps(x) }; }
+        static SimdFloat load(const float* p) { return { _mm_loadu_ps(p) }; }
+        void store(float* p) const { _mm_storeu_ps(p, v); }
+        friend SimdFloat operator+(SimdFloat a, SimdFloat b) { return { _mm_add_ps(a.v, b.v) }; }
+        friend SimdFloat operator-(SimdFloat a, SimdFloat b) { return { _mm_sub_ps(a.v, b.v) }; }
+        friend SimdFloat operator*(SimdFloat a, SimdFloat b) { return { _mm_mul_ps(a.v, b.v) }; }
+        friend SimdFloat operator/(SimdFloat a, SimdFloat b) { return { _mm_div_ps(a.v, b.v) }; }
+        friend SimdFloat sqrt(SimdFloat a) { return { _mm_sqrt_ps(a.v) }; }
+        friend SimdFloat min(SimdFloat a, SimdFloat b) { return { _mm_min_ps(a.v, b.v) }; }
+        friend SimdFloat max(SimdFloat a, SimdFloat b) { return { _mm_max_ps(a.v, b.v) }; }
+        SimdFloat truncate() const { return { _mm_cvtepi32_ps(_mm_cvttps_epi32(v)) }; }
+        void storeTruncated(int32_t* p) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_cvttps_epi32(v)); }
+#else
+        static constexpr int kWidth = 4;
+        float v[kWidth];
+
+        template <typename Op>
+        static SimdFloat map(SimdFloat a, SimdFloat b, Op op) {
+            SimdFloat r;
+            for (int i = 0; i < kWidth; ++i) r.v[i] = op(a.v[i], b.v[i]);
+            return r;
+        }
+        static SimdFloat zero() { return splat(0.0f); }
+        static SimdFloat splat(float x) { return { { x, x, x, x } }; }
+        static SimdFloat load(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+        void store(float* p) const { std::copy(v, v + kWidth, p); }
+        friend SimdFloat operator+(SimdFloat a, SimdFloat b) { return map(a, b, [](float x, float y) { return x + y; }); }
+        friend SimdFloat operator-(SimdFloat a, SimdFloat b) { return map(a, b, [](float x, float y) { return x - y; }); }
+        friend SimdFloat operator*(SimdFloat a, SimdFloat b) { return map(a, b, [](float x, float y) { return x * y; }); }
+        friend SimdFloat operator/(SimdFloat a, SimdFloat b) { return map(a, b, [](float x, float y) { return x / y; }); }
+        friend SimdFloat sqrt(SimdFloat a) { return map(a, a, [](float x, float) { return std::sqrt(x); }); }
+        friend SimdFloat min(SimdFloat a, SimdFloat b) { return map(a, b, [](float x, float y) { return std::min(x, y); }); }
+        friend SimdFloat max(SimdFloat a, SimdFloat b) { return map(a, b, [](float x, float y) { return std::max(x, y); }); }
+        SimdFloat truncate() const {
+            SimdFloat r;
+            for (int i = 0; i < kWidth; ++i) r.v[i] = static_cast<float>(static_cast<int32_t>(v[i]));
+            return r;
+        }
+        void storeTruncated(int32_t* p) const {
+            for (int i = 0; i < kWidth; ++i) p[i] = static_cast<int32_t>(v[i]);
+        }
+#endif
+
+        SimdFloat& operator+=(SimdFloat b) { return *this = *this + b; }
+        SimdFloat& operator-=(SimdFloat b) { return *this = *this - b; }
+        // Lanes added in a fixed order, so results don't depend on how the lanes got their values.
+        float sum() const {
+            alignas(32) float lanes[kWidth];
+            store(lanes);
+            float total = lanes[0];
+            for (int i = 1; i < kWidth; ++i) total += lanes[i];
+            return total;
+        }
+    };
+
+    struct SimdVec3 {
+        SimdFloat x, y, z;
+
+        friend SimdVec3 operator+(const SimdVec3& a, const SimdVec3& b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+        friend SimdVec3 operator-(const SimdVec3& a, const SimdVec3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+        friend SimdVec3 operator*(const SimdVec3& a, SimdFloat s) { return { a.x * s, a.y * s, a.z * s }; }
+        SimdVec3& operator+=(const SimdVec3& b) { return *this = *this + b; }
+        SimdVec3& operator-=(const SimdVec3& b) { return *this = *this - b; }
+    };
+
+    inline SimdFloat dot(const SimdVec3& a, const SimdVec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    inline SimdVec3 cross(const SimdVec3& a, const SimdVec3& b) {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+
+} // namespace physics
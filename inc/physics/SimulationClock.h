@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+
+namespace physics {
+
+    // Fixed-timestep driver: frames feed in wall time, the clock hands out whole steps of
+    // 1 / stepRate and keeps the remainder for the next frame. getAlpha() is how far the
+    // remainder reaches into the next step, for PhysicsWorld::getRenderPosition and friends.
+    //
+    // A frame never runs more than maxSubsteps steps; time beyond that is dropped, so a slow
+    // frame makes the simulation fall behind wall time instead of snowballing into ever longer
+    // frames.
+    class SimulationClock {
+    public:
+        explicit SimulationClock(double stepRate = 240.0, int maxSubsteps = 8);
+
+        void setStepRate(double hz);
+        double getStepRate() const { return stepRate_; }
+        float getFixedDt() const { return static_cast<float>(fixedDt_); }
+        void setMaxSubsteps(int maxSubsteps);
+        int getMaxSubsteps() const { return maxSubsteps_; }
+
+        // Accumulates `frameSeconds` and calls step(getFixedDt()) once per whole step it covers.
+        // Returns the number of steps taken.
+        int advance(double frameSeconds, const std::function<void(float)>& step);
+        // Forgets accumulated time and stats, e.g. after loading a scene.
+        void reset();
+
+        // Fraction of a step accumulated but not simulated yet, in [0, 1).
+        float getAlpha() const { return static_cast<float>(accumulator_ / fixedDt_); }
+        double getSimulationTime() const { return simulationTime_; }
+        uint64_t getStepCount() const { return stepCount_; }
+        int getLastSubsteps() const { return lastSubsteps_; }
+        // Wall time fed to the last advance(), in milliseconds.
+        double getLastFrameMs() const { return lastFrameMs_; }
+        // Average wall time of one step during the last advance(), in milliseconds.
+        double getLastStepMs() const { return lastStepMs_; }
+        // Wall time thrown away by the substep cap since the last reset.
+        double getDroppedTime() const { return droppedTime_; }
+
+    private:
+        double stepRate_;
+        double fixedDt_;
+        int maxSubsteps_;
+        double accumulator_{ 0.0 };
+        double simulationTime_{ 0.0 };
+        uint64_t stepCount_{ 0 };
+        int lastSubsteps_{ 0 };
+        double lastFrameMs_{ 0.0 };
+        double lastStepMs_{ 0.0 };
+        double droppedTime_{ 0.0 };
+    };
+
+} // namespace physics
@@ -0,0 +1,195 @@
+#pragma once
+#include "Aabb.h"
+#include "AlignedAllocator.h"
+#include "SpatialHashGrid.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace physics {
+
+    class PhysicsWorld;
+    struct Shape;
+
+    struct SoftBodySettings {
+        glm::vec3 gravity{ 0.0f, -9.81f, 0.0f };
+        // Each step is split into this many substeps with one constraint pass each, which
+        // converges faster than the same number of iterations on one big step.
+        uint32_t substeps{ 10 };
+        // Fraction of velocity removed per second.
+        float damping{ 0.0f };
+        // Collision radius of every particle, against bodies and each other.
+        float thickness{ 0.01f };
+        // Coulomb friction against bodies.
+        float friction{ 0.3f };
+        bool selfCollision{ true };
+    };
+
+    // Compliances are inverse stiffnesses in m/N (0 is rigid), as in XPBD.
+    struct ClothDesc {
+        glm::vec3 origin{ 0.0f };
+        glm::vec3 axisU{ 1.0f, 0.0f, 0.0f }; // Full extent along each side.
+        glm::vec3 axisV{ 0.0f, 0.0f, 1.0f };
+        glm::ivec2 resolution{ 32, 32 };       // Particles per side, at least 2 each.
+        float mass{ 1.0f };
+        float stretchCompliance{ 0.0f };
+        float shearCompliance{ 1e-4f };
+        float bendCompliance{ 1e-2f };
+    };
+
+    // Extended position based dynamics (Macklin et al.) for cloth, ropes and tetrahedral soft
+    // bodies. All particles of all soft bodies share one set of SoA columns, and every kind of
+    // constraint keeps its data in SoA columns of its own.
+    //
+    // Constraints are greedily colored so no two of a color share a particle, then stored in
+    // color order; a color is solved Gauss-Seidel in parallel, distance constraints
+    // SimdFloat::kWidth at a time. Coloring is serial and only redone after constraints are
+    // added, so results don't depend on the worker count.
+    //
+    // Particles collide with PhysicsWorld bodies (pushing dynamic ones back) and, through a
+    // SpatialHashGrid built once per step, with each other.
+    class SoftBodySystem {
+    public:
+        explicit SoftBodySystem(const SoftBodySettings& settings = {});
+
+        void setSettings(const SoftBodySettings& settings);
+        const SoftBodySettings& getSettings() const { return settings_; }
+
+        // Starts a new body; addParticle() appends to the body created last, so the particles of
+        // a body are contiguous. Self-collision ignores pairs of one body that start closer than
+        // two thicknesses, so neighbouring particles of a mesh don't fight.
+        uint32_t createBody();
+        // inverseMass 0 pins the particle in place.
+        uint32_t addParticle(const glm::vec3& position, float inverseMass);
+        void setInverseMass(uint32_t particle, float inverseMass) { inverseMass_[particle] = inverseMass; }
+        void setPosition(uint32_t particle, const glm::vec3& position);
+
+        // Rest length/volume/shape is taken from the current positions.
+        void addDistanceConstraint(uint32_t a, uint32_t b, float compliance);
+        // Bending about the edge two triangles share, as a distance constraint between the two
+        // vertices opposite it: cheap, and as stable as the stretch constraints themselves.
+        void addBendingConstraint(uint32_t oppositeA, uint32_t oppositeB, float compliance);
+        void addVolumeConstraint(uint32_t a, uint32_t b, uint32_t c, uint32_t d, float compliance);
+        // Pulls the particles towards a rigid transform of their rest shape, for stiffness in [0, 1]
+        // per step. Useful for cheap volumetric bodies without a tetrahedral mesh.
+        void addShapeMatchingCluster(const std::vector<uint32_t>& particles, float stiffness);
+
+        // Builders; each returns the new body. Particles are laid out row by row.
+        uint32_t createCloth(const ClothDesc& desc);
+        uint32_t createRope(const glm::vec3& start, const glm::vec3& end, uint32_t segments, float mass,
+                            float compliance, float bendCompliance);
+        // Four indices per tetrahedron. Each unique edge gets a distance constraint.
+        uint32_t createTetMesh(const std::vector<glm::vec3>& vertices, const std::vector<uint32_t>& tetrahedra,
+                               float mass, float edgeCompliance, float volumeCompliance);
+
+        void clear();
+
+        // Advances by dt in settings.substeps substeps. Call after world->step(dt); forces on
+        // bodies act in the world's next step. `world` may be null.
+        void step(float dt, PhysicsWorld* world = nullptr);
+
+        size_t size() const { return inverseMass_.size(); }
+        size_t getBodyCount() const { return bodyBegin_.size(); }
+        // Particles of `body` are [getBodyBegin(body), getBodyEnd(body)).
+        uint32_t getBodyBegin(uint32_t body) const { return bodyBegin_[body]; }
+        uint32_t getBodyEnd(uint32_t body) const {
+            return body + 1 < bodyBegin_.size() ? bodyBegin_[body + 1] : static_cast<uint32_t>(size());
+        }
+        glm::vec3 getPosition(size_t i) const { return { x_[i], y_[i], z_[i] }; }
+        glm::vec3 getVelocity(size_t i) const { return { vx_[i], vy_[i], vz_[i] }; }
+        const float* getPositionX() const { return x_.data(); }
+        const float* getPositionY() const { return y_.data(); }
+        const float* getPositionZ() const { return z_.data(); }
+        // Cloth triangles, three particle indices each, for rendering.
+        const std::vector<uint32_t>& getTriangles() const { return triangles_; }
+
+        size_t getConstraintCount() const;
+        size_t getColorCount() const;
+        size_t getSelfCollisionPairCount() const { return selfNeighbors_.size(); }
+
+    private:
+        // Constraints in color order; colors are ranges [colorStart[c], colorStart[c + 1]).
+        // Constraints that didn't fit in kMaxColors follow the last color and run serially.
+        struct Coloring {
+            std::vector<uint32_t> colorStart;
+            uint32_t overflowBegin{ 0 };
+        };
+        struct DistanceConstraints {
+            std::vector<uint32_t> a, b;
+            AlignedVector<float> rest, compliance, lambda;
+            Coloring coloring;
+            size_t size() const { return a.size(); }
+        };
+        struct VolumeConstraints {
+            std::vector<uint32_t> p[4];
+            AlignedVector<float> rest, compliance, lambda; // Rest is six times the volume.
+            Coloring coloring;
+            size_t size() const { return rest.size(); }
+        };
+        struct ShapeClusters {
+            std::vector<uint32_t> start{ 0 };     // Cluster count + 1 offsets into particles.
+            std::vector<uint32_t> particles;
+            std::vector<glm::vec3> restPositions; // Per member, where it was when the cluster was added.
+            std::vector<float> stiffness;
+            std::vector<glm::quat> rotation;      // Warm start for the polar decomposition.
+            Coloring coloring;
+            size_t size() const { return stiffness.size(); }
+        };
+        struct Collider {
+            const Shape* shape;
+            glm::vec3 position;
+            glm::quat orientation;
+            glm::vec3 velocity;
+            glm::vec3 angularVelocity;
+            Aabb bounds;           // Fattened by the thickness.
+            uint32_t bodyIndex;
+            bool dynamic;
+        };
+
+        void prepareColoring();
+        template <typename Kernel>
+        void forEachChunk(Kernel&& kernel);
+        void findSelfCollisionPairs(float dt);
+        void gatherColliders(PhysicsWorld& world, float dt);
+        void solveDistances(DistanceConstraints& constraints, float inverseH2);
+        void solveVolumes(float inverseH2);
+        void solveShapeMatching(uint32_t substeps);
+        void solveSelfCollisions();
+        void solveColliders(float h);
+        void applyCouplingForces(PhysicsWorld& world, float h, float dt);
+
+        SoftBodySettings settings_;
+        bool coloringDirty_{ false };
+
+        // Particle columns.
+        AlignedVector<float> x_, y_, z_;
+        AlignedVector<float> prevX_, prevY_, prevZ_;
+        AlignedVector<float> vx_, vy_, vz_;
+        AlignedVector<float> inverseMass_;
+        AlignedVector<float> restX_, restY_, restZ_; // Creation positions, for self-collision filtering.
+        AlignedVector<float> dx_, dy_, dz_;          // Scratch: Jacobi corrections, search radii.
+        std::vector<uint32_t> body_;
+        std::vector<uint32_t> bodyBegin_;
+
+        DistanceConstraints stretch_;
+        DistanceConstraints bending_;
+        VolumeConstraints volumes_;
+        ShapeClusters clusters_;
+        std::vector<uint32_t> triangles_;
+
+        SpatialHashGrid grid_;
+        std::vector<uint32_t> selfStart_;            // Particle count + 1 offsets into selfNeighbors_.
+        std::vector<uint32_t> selfNeighbors_;
+        std::vector<std::vector<uint32_t>> chunkNeighbors_;
+        std::vector<std::vector<uint64_t>> chunkMirrored_; // (owner << 32 | partner) pairs.
+        std::vector<uint64_t> mirrored_;
+
+        std::vector<Collider> colliders_;
+        // Per chunk and collider: mass times displacement pushed into particles this step, and
+        // its moment about the body.
+        std::vector<glm::vec3> chunkPush_, chunkMoment_;
+    };
+
+} // namespace physics
@@ -0,0 +1,115 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace physics {
+
+    // Uniform grid over points, stored as a hash table of cells. build() bins points with a
+    // parallel counting sort into one flat index array plus per-bucket prefix sums, so there
+    // are no per-cell allocations and rebuilding every step is cheap. Shared by the hash-grid
+    // broadphase and the particle/fluid neighbour searches.
+    class SpatialHashGrid {
+    public:
+        struct Cell {
+            int32_t x, y, z;
+        };
+
+        explicit SpatialHashGrid(float cellSize = 1.0f) { setCellSize(cellSize); }
+
+        // Takes effect on the next build().
+        void setCellSize(float cellSize);
+        float getCellSize() const { return cellSize_; }
+
+        // Bins `count` points read from SoA columns. Order within a bucket is unspecified.
+        void build(const float* x, const float* y, const float* z, size_t count);
+        size_t size() const { return sorted_.size(); }
+
+        Cell cellOf(const glm::vec3& p) const {
+            return { static_cast<int32_t>(std::floor(p.x * inverseCellSize_)),
+                     static_cast<int32_t>(std::floor(p.y * inverseCellSize_)),
+                     static_cast<int32_t>(std::floor(p.z * inverseCellSize_)) };
+        }
+
+        // Calls visitor(index) for every point binned in `cell`'s bucket. Buckets are shared by
+        // colliding cells, so callers still test distance.
+        template <typename Visitor>
+        void forEachInCell(const Cell& cell, Visitor&& visitor) const {
+            if (sorted_.empty()) return;
+            const uint32_t bucket = hashCell(cell);
+            for (uint32_t k = cellStart_[bucket]; k < cellStart_[bucket + 1]; ++k) visitor(sorted_[k]);
+        }
+
+        // Calls visitor(index) once for every point in the 27 cells around `p` (the point itself
+        // included, if binned). Finds everything within cellSize of `p`.
+        template <typename Visitor>
+        void forEachNeighbor(const glm::vec3& p, Visitor&& visitor) const {
+            visitCells(cellOf(p), 27, std::forward<Visitor>(visitor));
+        }
+
+        // Like forEachNeighbor(), but only the point's own cell and the 13 cells "ahead" of it.
+        // Between them, two points in adjacent cells meet exactly once, which halves pair searches.
+        // Points sharing a cell (or a colliding bucket) still see each other from both sides.
+        template <typename Visitor>
+        void forEachHalfNeighbor(const glm::vec3& p, Visitor&& visitor) const {
+            visitCells(cellOf(p), 14, std::forward<Visitor>(visitor));
+        }
+
+        // Point indices grouped by bucket; iterating in this order keeps neighbours in cache.
+        const std::vector<uint32_t>& getSortedIndices() const { return sorted_; }
+
+    private:
+        // Offsets ordered so the first 14 are the own cell plus one of each opposing pair.
+        static constexpr int kNeighborOffsets[27][3] = {
+            { 0, 0, 0 },
+            { 1, 0, 0 }, { -1, 1, 0 }, { 0, 1, 0 }, { 1, 1, 0 },
+            { -1, -1, 1 }, { 0, -1, 1 }, { 1, -1, 1 }, { -1, 0, 1 }, { 0, 0, 1 }, { 1, 0, 1 },
+            { -1, 1, 1 }, { 0, 1, 1 }, { 1, 1, 1 },
+            { -1, 0, 0 }, { 1, -1, 0 }, { 0, -1, 0 }, { -1, -1, 0 },
+            { 1, 1, -1 }, { 0, 1, -1 }, { -1, 1, -1 }, { 1, 0, -1 }, { 0, 0, -1 }, { -1, 0, -1 },
+            { 1, -1, -1 }, { 0, -1, -1 }, { -1, -1, -1 },
+        };
+
+        template <typename Visitor>
+        void visitCells(const Cell& center, int offsetCount, Visitor&& visitor) const {
+            if (sorted_.empty()) return;
+            uint32_t visited[27];
+            int visitedCount = 0;
+            uint64_t signature = 0;
+            for (int o = 0; o < offsetCount; ++o) {
+                const int* d = kNeighborOffsets[o];
+                const uint32_t bucket = hashCell({ center.x + d[0], center.y + d[1], center.z + d[2] });
+                // Neighbouring cells can share a bucket; walk it only once. The 64-bit signature
+                // skips the linear check in the common no-collision case.
+                const uint64_t bit = uint64_t(1) << (bucket & 63);
+                if (signature & bit) {
+                    bool seen = false;
+                    for (int v = 0; v < visitedCount && !seen; ++v) seen = visited[v] == bucket;
+                    if (seen) continue;
+                }
+                signature |= bit;
+                visited[visitedCount++] = bucket;
+                for (uint32_t k = cellStart_[bucket]; k < cellStart_[bucket + 1]; ++k) visitor(sorted_[k]);
+            }
+        }
+
+        uint32_t hashCell(const Cell& cell) const {
+            uint32_t h = static_cast<uint32_t>(cell.x) * 0x8da6b343u
+                       + static_cast<uint32_t>(cell.y) * 0xd8163841u
+                       + static_cast<uint32_t>(cell.z) * 0xcb1ab31fu;
+            h ^= h >> 16;
+            return h & tableMask_;
+        }
+
+        float cellSize_{ 1.0f };
+        float inverseCellSize_{ 1.0f };
+        uint32_t tableMask_{ 0 };
+        std::vector<uint32_t> buckets_;   // Per point.
+        std::vector<uint32_t> ranks_;     // Per point: slot within its bucket.
+        std::vector<uint32_t> cellStart_; // Table size + 1 prefix sums.
+        std::vector<uint32_t> sorted_;
+    };
+
+} // namespace physics
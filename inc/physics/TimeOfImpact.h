@@ -0,0 +1,25 @@
+#pragma once
+#include "Shape.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace physics {
+
+    // Motion of a body across one step. Poses in between interpolate linearly, with rotation
+    // slerped at constant angular speed.
+    struct Sweep {
+        glm::vec3 position0, position1;
+        glm::quat orientation0, orientation1;
+
+        glm::vec3 position(float t) const { return glm::mix(position0, position1, t); }
+        glm::quat orientation(float t) const { return glm::slerp(orientation0, orientation1, t); }
+    };
+
+    // Conservative advancement: the first fraction of the sweeps, in [0, 1], at which the two
+    // surfaces come within `targetDistance`, or 1 if they never do. Each iteration advances by
+    // the current distance over an upper bound on the closing speed (linear plus angular times
+    // bounding radius), so it never steps past the impact. Pairs already that close at t = 0
+    // belong to the contact solver and return 1, unless A pushes into B by more than the target.
+    float timeOfImpact(const Shape& shapeA, const Sweep& sweepA, const Shape& shapeB, const Sweep& sweepB, float targetDistance);
+
+} // namespace physics
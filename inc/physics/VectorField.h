@@ -0,0 +1,64 @@
+#pragma once
+#include "Aabb.h"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace physics {
+
+    // Vector values on a regular grid of nodes, trilinearly interpolated in between: wind,
+    // magnetic-style or any other field sampled at body and particle positions every step.
+    // Node (x, y, z) sits at origin + (x, y, z) * cellSize. Samples outside the grid take the
+    // value at the nearest point on its boundary.
+    class VectorField {
+    public:
+        // `resolution` is the node count per axis, at least 2 each.
+        VectorField(const glm::vec3& origin, float cellSize, const glm::ivec3& resolution);
+
+        const glm::vec3& getOrigin() const { return origin_; }
+        float getCellSize() const { return cellSize_; }
+        const glm::ivec3& getResolution() const { return resolution_; }
+        Aabb getBounds() const { return { origin_, origin_ + glm::vec3(resolution_ - 1) * cellSize_ }; }
+        glm::vec3 nodePosition(const glm::ivec3& node) const { return origin_ + glm::vec3(node) * cellSize_; }
+
+        glm::vec3 getNode(const glm::ivec3& node) const { return values_[nodeIndex(node)]; }
+        void setNode(const glm::ivec3& node, const glm::vec3& value) { values_[nodeIndex(node)] = value; }
+        void fill(const glm::vec3& value);
+
+        // Streaming updates. Copies count.x * count.y * count.z values (x fastest) into the block
+        // of nodes starting at `first`; blocks that don't fit the grid are rejected.
+        void setRegion(const glm::ivec3& first, const glm::ivec3& count, const glm::vec3* values);
+        // Re-evaluates every node inside `bounds` from its position. The generator runs on the
+        // job system's workers, so it must be safe to call concurrently.
+        void updateRegion(const Aabb& bounds, const std::function<glm::vec3(const glm::vec3&)>& generator);
+
+        glm::vec3 sample(const glm::vec3& position) const;
+        // Samples `count` SoA positions into SoA outputs, SimdFloat::kWidth points at a time.
+        // Inputs and outputs may not overlap.
+        void sample(const float* x, const float* y, const float* z, size_t count,
+                    float* outX, float* outY, float* outZ) const;
+
+        // Derivatives of the interpolated field; column j of the Jacobian is d(field)/d(axis j).
+        glm::mat3 jacobian(const glm::vec3& position) const;
+        glm::vec3 curl(const glm::vec3& position) const;
+        float divergence(const glm::vec3& position) const;
+
+    private:
+        size_t nodeIndex(const glm::ivec3& node) const {
+            return static_cast<size_t>(node.x) + static_cast<size_t>(resolution_.x) *
+                   (static_cast<size_t>(node.y) + static_cast<size_t>(resolution_.y) * static_cast<size_t>(node.z));
+        }
+        // Cell holding `position` (clamped to the grid) and the offset inside it, in [0, 1].
+        void locate(const glm::vec3& position, glm::ivec3& cell, glm::vec3& fraction) const;
+        void sampleRange(const float* x, const float* y, const float* z, size_t begin, size_t end,
+                         float* outX, float* outY, float* outZ) const;
+
+        glm::vec3 origin_;
+        float cellSize_;
+        float inverseCellSize_;
+        glm::ivec3 resolution_;
+        std::vector<glm::vec3> values_; // Interleaved, so a cell's corners share cache lines.
+    };
+
+} // namespace physics
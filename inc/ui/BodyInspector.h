@@ -0,0 +1,32 @@
+#pragma once
+#include "IExposable.h"
+#include "UIPropertyBinding.h"
+#include "physics/PhysicsBody.h"
+
+namespace ui {
+
+    // Property pane view of one body: motion state (static, kinematic, awake, asleep), position
+    // and velocity. publish() pushes the current values through the binding; call it once per
+    // frame after stepping.
+    class BodyInspector : public IExposable {
+    public:
+        explicit BodyInspector(physics::PhysicsBody body);
+
+        void publish();
+
+        std::string getObjectName() const override;
+        std::vector<UIPropertyDescription> getProperties() const override;
+        UIPropertyBinding* getPropertyBinding() override { return &binding_; }
+
+        // "Static", "Kinematic", "Sleeping", "Awake" or "Destroyed".
+        static const char* getStateName(const physics::PhysicsBody& body);
+
+    private:
+        physics::PhysicsBody body_;
+        UIPropertyBinding binding_;
+        UIPropertyBinding::FieldId stateField_;
+        UIPropertyBinding::FieldId positionFields_[3];
+        UIPropertyBinding::FieldId velocityFields_[3];
+    };
+
+} // namespace ui
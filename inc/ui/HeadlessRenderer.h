@@ -0,0 +1,50 @@
+#pragma once
+#include "IRenderer.h"
+#include "ITexture.h"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <string>
+#include <optional>
+
+namespace ui {
+
+    // IRenderer that draws nothing. It only counts the calls it receives, so UI
+    // code can be driven without a window or GPU (benchmarks, replays, CI).
+    class HeadlessRenderer : public IRenderer {
+    public:
+        struct Stats {
+            std::size_t rects{ 0 };
+            std::size_t lines{ 0 };
+            std::size_t lineBatches{ 0 };
+            std::size_t texts{ 0 };
+            std::size_t textures{ 0 };
+            std::size_t measures{ 0 };
+            std::size_t clips{ 0 };
+        };
+
+        explicit HeadlessRenderer(const glm::vec2& screenSize = glm::vec2(1280.0f, 720.0f));
+        ~HeadlessRenderer() override = default;
+
+        // IRenderer interface implementations
+        void drawRect(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) override;
+        void drawLine(const glm::vec2& start, const glm::vec2& end, const glm::vec4& color) override;
+        void drawLines(const glm::vec2* vertices, size_t vertexCount, const glm::vec4& color) override;
+        void drawText(const glm::vec2& position, const std::string& text, const glm::vec4& color, float fontSize) override;
+        void drawTexture(const glm::vec2& position, const glm::vec2& size, ITexture* texture) override;
+        glm::vec2 measureText(const std::string& text, float fontSize) override;
+        void setClipRect(const glm::vec2& position, const glm::vec2& size) override;
+        void resetClipRect() override;
+        void* getNVGContext() override;
+        glm::vec2 getScreenSize() const override;
+
+        void setScreenSize(const glm::vec2& size) { screenSize_ = size; }
+        const Stats& getStats() const { return stats_; }
+        void resetStats() { stats_ = Stats{}; }
+
+    private:
+        glm::vec2 screenSize_;
+        std::optional<std::pair<glm::vec2, glm::vec2>> clipRect_;
+        Stats stats_;
+    };
+
+} // namespace ui
@@ -8,12 +8,16 @@
 namespace ui {
 
 class UIPropertyDescription;
+class UIPropertyBinding;
 
 class IExposable {
 public:
     virtual ~IExposable() = default;
     virtual std::string getObjectName() const = 0;
     virtual std::vector<UIPropertyDescription> getProperties() const = 0;
+    // Optional push channel for live values; objects that return one are
+    // updated cell by cell instead of being polled through getProperties().
+    virtual UIPropertyBinding* getPropertyBinding() { return nullptr; }
 };
 
 } // namespace ui
\ No newline at end of file
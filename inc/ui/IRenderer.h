@@ -1,5 +1,6 @@
 #pragma once
 #include <glm/glm.hpp>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -15,6 +16,10 @@ public:
     virtual ~IRenderer() = default;
     virtual void drawRect(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) = 0;
     virtual void drawLine(const glm::vec2& start, const glm::vec2& end, const glm::vec4& color) = 0;
+    // Batched segments: vertices holds start/end pairs. Renderers that can stroke many segments as one path override this.
+    virtual void drawLines(const glm::vec2* vertices, size_t vertexCount, const glm::vec4& color) {
+        for (size_t i = 0; i + 1 < vertexCount; i += 2) drawLine(vertices[i], vertices[i + 1], color);
+    }
     virtual void drawText(const glm::vec2& position, const std::string& text, const glm::vec4& color, float fontSize) = 0;
     virtual void drawTexture(const glm::vec2& position, const glm::vec2& size, ITexture* texture) = 0;
     virtual glm::vec2 measureText(const std::string& text, float fontSize) = 0;
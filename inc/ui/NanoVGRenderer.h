@@ -16,6 +16,7 @@ namespace ui {
         // IRenderer interface implementations
         void drawRect(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) override;
         void drawLine(const glm::vec2& start, const glm::vec2& end, const glm::vec4& color) override;
+        void drawLines(const glm::vec2* vertices, size_t vertexCount, const glm::vec4& color) override;
         void drawText(const glm::vec2& position, const std::string& text, const glm::vec4& color, float fontSize) override;
         void drawTexture(const glm::vec2& position, const glm::vec2& size, ITexture* texture) override;
         glm::vec2 measureText(const std::string& text, float fontSize) override;
@@ -0,0 +1,32 @@
+#pragma once
+#include "IExposable.h"
+#include "UIPropertyBinding.h"
+#include "physics/SimulationClock.h"
+#include <memory>
+
+namespace ui {
+
+    // Property pane view of a physics::SimulationClock. Settings are polled on refresh; timing
+    // stats are pushed through the binding by publish(), called once per frame after advance().
+    class SimulationClockInspector : public IExposable {
+    public:
+        explicit SimulationClockInspector(std::shared_ptr<const physics::SimulationClock> clock);
+
+        void publish();
+
+        std::string getObjectName() const override { return "Simulation Clock"; }
+        std::vector<UIPropertyDescription> getProperties() const override;
+        UIPropertyBinding* getPropertyBinding() override { return &binding_; }
+
+    private:
+        std::shared_ptr<const physics::SimulationClock> clock_;
+        UIPropertyBinding binding_;
+        UIPropertyBinding::FieldId frameField_;
+        UIPropertyBinding::FieldId substepsField_;
+        UIPropertyBinding::FieldId stepMsField_;
+        UIPropertyBinding::FieldId alphaField_;
+        UIPropertyBinding::FieldId timeField_;
+        UIPropertyBinding::FieldId droppedField_;
+    };
+
+} // namespace ui
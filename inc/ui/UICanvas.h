@@ -3,6 +3,7 @@
 #include "UIScrollbar.h"
 #include "UITheme.h"
 #include "UILayout.h"
+#include "UIFocusOrder.h"
 #include <memory>
 #include <optional>
 #include <vector>
@@ -33,6 +34,7 @@ namespace ui {
         // Child management.
         virtual void addChild(std::unique_ptr<UIElement> child) override;
         virtual void removeChild(const UIElement* child) override;
+        void onChildFocusPriorityChanged(UIElement* child) override;
 
         void addScrollbar(std::unique_ptr<UIScrollbar> scrollbar);
         void setScrollOffset(float xOffset, float yOffset);
@@ -41,6 +43,10 @@ namespace ui {
         // Provide computed content size.
         glm::vec2 getContentSize() const { return contentSize_; }
 
+        // Per-frame hook, called by UIManager::update() before dirty canvases are queued for rendering.
+        // Runs on a worker thread in parallel with other canvases; use UIManager::deferUntilMerge for cross-canvas work.
+        virtual void update() {}
+
         // Layout.
         virtual void setLayout(std::unique_ptr<UILayout> layout);
         virtual void updateLayout();
@@ -54,6 +60,7 @@ namespace ui {
         bool isModal() const { return isModal_; }
         void setFocusScope(bool scope) { focusScope_ = scope; }
         bool isFocusScope() const { return focusScope_; }
+        const UIFocusOrder& getFocusOrder() const { return focusOrder_; }
 
         // Per-canvas theme override.
         void setThemeOverride(std::unique_ptr<UITheme> theme) { themeOverride_ = std::move(theme); }
@@ -71,6 +78,7 @@ namespace ui {
         // Unique_ptr holding scrollbars.
         std::vector<std::unique_ptr<UIScrollbar>> scrollbars_;
         std::unique_ptr<UILayout> layout_{ nullptr };
+        UIFocusOrder focusOrder_;
         std::unique_ptr<UITheme> themeOverride_;
         UITheme* globalTheme_{ nullptr };
         glm::vec2 scrollOffset_{ 0.0f, 0.0f };
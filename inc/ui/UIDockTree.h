@@ -0,0 +1,102 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace ui {
+
+    class UIDockable;
+
+    enum class DockSide { Left, Right, Top, Bottom, Tab };
+
+    // Where a dragged panel would land if released now.
+    struct DockSnapTarget {
+        uint32_t node;
+        DockSide side;
+        glm::vec2 previewPosition;
+        glm::vec2 previewSize;
+    };
+
+    // Split-node hierarchy for docked panels. Leaves hold tabbed panels; splits divide their
+    // rect between two children by ratio. The root starts as an empty workspace leaf.
+    class UIDockTree {
+    public:
+        using NodeId = uint32_t;
+        static constexpr NodeId kInvalidNode = UINT32_MAX;
+
+        UIDockTree();
+
+        // Screen area the tree lays out into; re-solves everything when it changes.
+        void setBounds(const glm::vec2& position, const glm::vec2& size);
+
+        // Docks `panel` against `target`: a side splits the target, Tab adds it to the target leaf.
+        bool dock(UIDockable* panel, NodeId target, DockSide side);
+        // Removes a panel and collapses the leaf it leaves empty. Returns false if it wasn't docked.
+        bool undock(UIDockable* panel);
+        bool contains(const UIDockable* panel) const { return panelLeaf_.count(panel) != 0; }
+
+        // Moves the divider of a split; only that split's subtree is re-solved.
+        void setRatio(NodeId split, float ratio);
+        void setActiveTab(UIDockable* panel);
+
+        NodeId getRoot() const { return root_; }
+        NodeId findLeaf(const UIDockable* panel) const;
+
+        // Snap candidate for a pointer position, or nullopt if nothing is within `threshold`.
+        std::optional<DockSnapTarget> querySnap(const glm::vec2& point, const UIDockable* dragged, float threshold) const;
+
+    private:
+        struct Node {
+            bool isSplit{ false };
+            bool horizontal{ true }; // Split: children side by side when true, stacked otherwise.
+            float ratio{ 0.5f };
+            NodeId parent{ kInvalidNode };
+            NodeId first{ kInvalidNode };
+            NodeId second{ kInvalidNode };
+            std::vector<UIDockable*> tabs;
+            size_t activeTab{ 0 };
+            bool workspace{ false }; // Kept alive when empty.
+            glm::vec2 position{ 0.0f };
+            glm::vec2 size{ 0.0f };
+        };
+
+        // A snappable edge: constant coordinate plus the span it covers along the other axis.
+        struct Edge {
+            float coord;
+            float lo;
+            float hi;
+            NodeId node;
+            DockSide side;
+            bool operator<(const Edge& other) const { return coord < other.coord; }
+        };
+
+        NodeId allocate();
+        void release(NodeId id);
+        void solve(NodeId id, const glm::vec2& position, const glm::vec2& size);
+        void applyLeaf(const Node& leaf);
+        void replaceChild(NodeId parent, NodeId oldChild, NodeId newChild);
+        void rebuildEdges() const;
+        NodeId leafAt(const glm::vec2& point) const;
+        static bool inside(const Node& node, const glm::vec2& point);
+        static void previewRect(const Node& node, DockSide side, glm::vec2& position, glm::vec2& size);
+
+        static constexpr float kSplitterThickness = 4.0f;
+        static constexpr float kMinRatio = 0.1f;
+        static constexpr float kMaxRatio = 0.9f;
+
+        std::vector<Node> nodes_;
+        std::vector<NodeId> freeNodes_;
+        NodeId root_{ kInvalidNode };
+        std::unordered_map<const UIDockable*, NodeId> panelLeaf_;
+        glm::vec2 boundsPosition_{ 0.0f };
+        glm::vec2 boundsSize_{ 0.0f };
+
+        // Interval index over leaf and root edges, sorted by coordinate; rebuilt lazily after a solve.
+        mutable std::vector<Edge> verticalEdges_;   // x = coord, spans y
+        mutable std::vector<Edge> horizontalEdges_; // y = coord, spans x
+        mutable bool edgesDirty_{ true };
+    };
+
+} // namespace ui
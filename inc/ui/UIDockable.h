@@ -9,7 +9,8 @@ namespace ui {
 
     class UIDockable : public UICanvas {
     public:
-        enum class DockPosition { None, Top, Bottom, Left, Right };
+        // Tabbed: sharing a dock-tree leaf with other panels. Placement itself comes from UIManager's dock tree.
+        enum class DockPosition { None, Top, Bottom, Left, Right, Tabbed };
 
         static std::unique_ptr<UIDockable> create(const std::string& title, const std::string& styleType = "dockable", int zIndex = 0);
         void render(IRenderer* renderer) override;
@@ -24,16 +25,16 @@ namespace ui {
         virtual void setPosition(const glm::vec2& pos) override;
         void onStyleUpdate() override;
 
-    private:
+    protected:
         UIDockable(const std::string& title, const std::string& styleType, int zIndex);
-        void updateDocking();
+        float titleBarHeight_{ 20.0f };
 
+    private:
         std::string title_;
         std::unique_ptr<UILabel> titleLabel_;
         DockPosition dockPosition_{ DockPosition::None };
         glm::vec2 dragStart_{ 0.0f, 0.0f };
         bool isDragging_{ false };
-        float titleBarHeight_{ 20.0f };
     };
 
 } // namespace ui
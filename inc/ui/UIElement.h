@@ -48,8 +48,10 @@ namespace ui {
         virtual bool hitTest(const glm::vec2& point) const;
 
         // Focus priority
-        void setFocusPriority(int priority) { focusPriority_ = priority; }
+        void setFocusPriority(int priority);
         int getFocusPriority() const { return focusPriority_; }
+        // Lets containers that index focus order re-sort a child whose priority changed.
+        virtual void onChildFocusPriorityChanged(UIElement* /*child*/) {}
 
         // Style
         void setStyleType(const std::string& type) { styleType_ = type; }
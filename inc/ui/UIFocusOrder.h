@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <unordered_map>
+
+namespace ui {
+
+    class UIElement;
+
+    // Tab order for one canvas: focusable children (priority > 0) sorted by focus priority, then
+    // document order. Kept up to date on add/remove/priority change so traversal is O(log n).
+    class UIFocusOrder {
+    public:
+        // Registers an element in document order; it only joins the tab order while its priority is > 0.
+        void insert(UIElement* element);
+        void erase(const UIElement* element);
+        // Re-sorts an element after its focus priority changed.
+        void update(UIElement* element);
+        void clear();
+
+        bool contains(const UIElement* element) const { return slots_.count(element) != 0; }
+        size_t size() const { return order_.size(); }
+        bool empty() const { return order_.empty(); }
+
+        UIElement* first() const;
+        UIElement* last() const;
+        // Neighbours of a registered element, focusable or not; nullptr past either end.
+        UIElement* next(const UIElement* current) const;
+        UIElement* previous(const UIElement* current) const;
+
+    private:
+        struct Key {
+            int priority;
+            uint64_t sequence;
+            bool operator<(const Key& other) const {
+                return priority != other.priority ? priority < other.priority : sequence < other.sequence;
+            }
+        };
+        using Order = std::map<Key, UIElement*>;
+
+        struct Slot {
+            uint64_t sequence;
+            std::optional<Order::iterator> position;
+        };
+
+        Order order_;
+        std::unordered_map<const UIElement*, Slot> slots_;
+        uint64_t nextSequence_{ 0 };
+    };
+
+} // namespace ui
@@ -0,0 +1,100 @@
+#pragma once
+#include "IInputEvent.h"
+#include <glm/glm.hpp>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace ui {
+
+    // Binary input log layout (little-endian, packed):
+    //   header : "UIRL" u16 version
+    //   record : u8 kind, u64 timestamp (microseconds since recording started), payload
+    //     Frame    : u32 frame index                       (closes the frame)
+    //     Mouse    : u8 type, f32 x, f32 y, u8 button, f32 wheelX, f32 wheelY, u16 len, bytes (dropped data)
+    //     Keyboard : u8 type, u16 keyCode, u16 modifiers
+    //     Text     : u8 type, u16 len, bytes
+    namespace inputlog {
+        inline constexpr char kMagic[4] = { 'U', 'I', 'R', 'L' };
+        inline constexpr std::uint16_t kVersion = 1;
+        enum class RecordKind : std::uint8_t { Frame = 0, Mouse = 1, Keyboard = 2, Text = 3 };
+    }
+
+    // Plain-data event implementations used when events are read back from a log.
+    class RecordedMouseEvent : public IMouseEvent {
+    public:
+        RecordedMouseEvent(EventType type, glm::vec2 pos, MouseButton button, glm::vec2 wheelDelta = glm::vec2(0.0f), std::string droppedData = "")
+            : type_(type), pos_(pos), button_(button), wheelDelta_(wheelDelta), droppedData_(std::move(droppedData)) {}
+        EventType getType() const override { return type_; }
+        glm::vec2 getPosition() const override { return pos_; }
+        MouseButton getButton() const override { return button_; }
+        glm::vec2 getWheelDelta() const override { return wheelDelta_; }
+        std::string getDroppedData() const override { return droppedData_; }
+
+    private:
+        EventType type_;
+        glm::vec2 pos_;
+        MouseButton button_;
+        glm::vec2 wheelDelta_;
+        std::string droppedData_;
+    };
+
+    class RecordedKeyboardEvent : public IKeyboardEvent {
+    public:
+        RecordedKeyboardEvent(EventType type, KeyCode key, int modifiers)
+            : type_(type), key_(key), modifiers_(modifiers) {}
+        EventType getType() const override { return type_; }
+        KeyCode getKeyCode() const override { return key_; }
+        int getModifiers() const override { return modifiers_; }
+
+    private:
+        EventType type_;
+        KeyCode key_;
+        int modifiers_;
+    };
+
+    class RecordedTextInputEvent : public ITextInputEvent {
+    public:
+        RecordedTextInputEvent(EventType type, std::string text)
+            : type_(type), text_(std::move(text)) {}
+        EventType getType() const override { return type_; }
+        std::string getText() const override { return text_; }
+
+    private:
+        EventType type_;
+        std::string text_;
+    };
+
+    // Appends translated input events and frame boundaries to a binary log.
+    class UIInputRecorder {
+    public:
+        UIInputRecorder() = default;
+        ~UIInputRecorder();
+
+        bool open(const std::filesystem::path& path);
+        void close();
+        bool isOpen() const { return stream_.is_open(); }
+
+        void record(const IMouseEvent& event);
+        void record(const IKeyboardEvent& event);
+        void record(const ITextInputEvent& event);
+        // Marks the end of the current frame; events recorded after this belong to the next one.
+        void endFrame();
+
+        std::uint32_t getFrameCount() const { return frame_; }
+
+    private:
+        std::uint64_t elapsedMicros() const;
+        void writeHeader(inputlog::RecordKind kind);
+        void writeString(const std::string& value);
+        template <typename T>
+        void write(const T& value) { stream_.write(reinterpret_cast<const char*>(&value), sizeof(T)); }
+
+        std::ofstream stream_;
+        std::chrono::steady_clock::time_point start_;
+        std::uint32_t frame_{ 0 };
+    };
+
+} // namespace ui
@@ -0,0 +1,43 @@
+#pragma once
+#include "UIInputRecorder.h"
+#include <cstdint>
+#include <filesystem>
+#include <variant>
+#include <vector>
+
+namespace ui {
+
+    enum class ReplayMode {
+        FullSpeed, // Frames are replayed back to back.
+        RealTime   // Frames are paced to their recorded timestamps.
+    };
+
+    struct ReplayFrameTiming {
+        std::uint32_t frame{ 0 };
+        std::size_t eventCount{ 0 };
+        double inputMs{ 0.0 };
+        double updateMs{ 0.0 };
+        double renderMs{ 0.0 };
+        double totalMs() const { return inputMs + updateMs + renderMs; }
+    };
+
+    // Loads a log written by UIInputRecorder and exposes it frame by frame.
+    class UIInputReplayer {
+    public:
+        using RecordedEvent = std::variant<RecordedMouseEvent, RecordedKeyboardEvent, RecordedTextInputEvent>;
+
+        struct Frame {
+            std::uint32_t index{ 0 };
+            std::uint64_t timestampMicros{ 0 }; // Time the frame ended during recording.
+            std::vector<RecordedEvent> events;
+        };
+
+        bool load(const std::filesystem::path& path);
+        const std::vector<Frame>& getFrames() const { return frames_; }
+        std::vector<Frame>& getFrames() { return frames_; }
+
+    private:
+        std::vector<Frame> frames_;
+    };
+
+} // namespace ui
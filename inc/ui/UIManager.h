@@ -6,27 +6,27 @@
 #include "UITheme.h"
 #include "UICanvas.h"
 #include "UIDockable.h"
+#include "UIDockTree.h"
 #include "UIElement.h"
 #include "UIEventBus.h" // Added for event publishing
+#include "UIInputRecorder.h"
+#include "UIInputReplayer.h"
+#include <filesystem>
+#include <optional>
 #include <memory>
 #include <vector>
+#include <unordered_map>
 #include <mutex>
 #include <queue>
 #include <chrono>
 #include <coroutine>
 #include <thread>
 #include <condition_variable>
+#include <functional>
+#include <atomic>
 
 namespace ui {
 
-enum class DockPosition {
-    None,
-    Top,
-    Bottom,
-    Left,
-    Right
-};
-
 struct CoroutineSchedule {
     std::chrono::steady_clock::time_point resumeTime;
     std::coroutine_handle<> handle;
@@ -52,6 +52,21 @@ public:
     void setInputTranslator(std::unique_ptr<IInputTranslator> translator);
     void handleDockableDragging(UIDockable* dockable, const glm::vec2& position);
     void handleDockableRelease(UIDockable* dockable);
+    // Docks a panel against a screen edge (or as a tab of the root) without dragging.
+    bool dockDockable(UIDockable* dockable, DockSide side);
+    // Drop target under the pointer while a dockable is being dragged, for drawing a preview.
+    std::optional<DockSnapTarget> getDockPreview() const;
+
+    // Runs `action` once the parallel canvas update has finished, or right away outside of it.
+    // Canvas updates must route anything that touches other canvases or manager state through here.
+    void deferUntilMerge(std::function<void()> action);
+
+    // Input recording and headless replay for reproducing sessions as perf tests.
+    bool startRecording(const std::filesystem::path& path);
+    void stopRecording();
+    bool isRecording() const;
+    std::vector<ReplayFrameTiming> replayInput(const std::filesystem::path& path, IRenderer* renderer,
+                                               ReplayMode mode = ReplayMode::FullSpeed);
 
 private:
     UIManager();
@@ -62,9 +77,13 @@ private:
     // Core UI management
     std::vector<std::unique_ptr<UICanvas>> canvases_;
     std::vector<UIDockable*> dockables_;
+    UIDockTree dockTree_;
+    std::optional<DockSnapTarget> dockPreview_;
+    static constexpr float kDockSnapThreshold = 20.0f;
     std::unique_ptr<UITheme> globalTheme_;
     std::unique_ptr<IInputTranslator> translator_;
     UIElement* focusedElement_ = nullptr;
+    std::unordered_map<const UIElement*, size_t> canvasIndex_; // Canvas -> slot in canvases_
     mutable std::mutex mutex_;
 
     // Coroutine scheduling
@@ -81,15 +100,34 @@ private:
     bool renderThreadRunning_ = true;
     IRenderer* renderer_ = nullptr;
 
+    // Parallel canvas update; cross-canvas side effects queue up until the serial merge
+    std::atomic<bool> updatingCanvases_{ false };
+    std::mutex deferredMutex_;
+    std::vector<std::function<void()>> deferredActions_;
+
+    // Input recording (null when not recording)
+    std::unique_ptr<UIInputRecorder> recorder_;
+
     // Private helper methods
     void applyTheme();
     void renderLoop();
     void coroutineLoop();
+    void dispatchInput(IMouseEvent* mouseEvent);
+    void dispatchInput(IKeyboardEvent* keyboardEvent);
+    void dispatchInput(ITextInputEvent* textEvent);
+    std::vector<UICanvas*> getCanvasesTopDown() const;
+    std::vector<UICanvas*> updateCanvases();
+    void runDeferredActions();
+    // Caller holds mutex_.
+    void setFocusedElementLocked(UIElement* element);
+    void renderCanvases(IRenderer* renderer, std::vector<UICanvas*>& canvases);
     UIElement* findNextFocusable(UIElement* current, bool withinScope = true);
     UIElement* findPreviousFocusable(UIElement* current, bool withinScope = true);
     UICanvas* getCanvasForElement(const UIElement* element) const;
+    void rebuildCanvasIndex();
     void updateDockableSnapping(UIDockable* dockable, const glm::vec2& position);
-    DockPosition checkDockableSnapping(UIDockable* dockable, const glm::vec2& position, const glm::vec2& screenSize = glm::vec2(1280.0f, 720.0f));
+    std::optional<DockSnapTarget> checkDockableSnapping(UIDockable* dockable, const glm::vec2& position);
+    void syncDockBounds();
 };
 
 inline void UIManager::queueForRender(UICanvas* canvas) {
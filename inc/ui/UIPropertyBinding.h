@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace ui {
+
+    using PropertyValue = std::variant<float, std::string>;
+
+    // Push channel for live property values. An exposed object registers the
+    // fields it can report, then publishes new values as they change (from any
+    // thread). Each subscriber sees only the latest value of every field changed
+    // since its last flush, so bursts of updates coalesce to one per frame.
+    // Slots and dirty lists are preallocated; publishing floats never allocates.
+    class UIPropertyBinding {
+    public:
+        using FieldId = std::uint32_t;
+        using SubscriptionId = std::uint32_t;
+        using Listener = std::function<void(FieldId, const PropertyValue&)>;
+
+        // path is "<description>[/<sub-description>...].<field label>", matching
+        // the UIPropertyDescription tree the object returns from getProperties().
+        FieldId registerField(const std::string& path, PropertyValue initial = 0.0f);
+        const std::string& getFieldPath(FieldId field) const { return fields_[field].path; }
+        std::size_t getFieldCount() const;
+
+        void publish(FieldId field, float value);
+        void publish(FieldId field, const std::string& value);
+
+        SubscriptionId subscribe();
+        void unsubscribe(SubscriptionId subscription);
+        // Invokes listener once per field changed since the last flush; returns how many.
+        std::size_t flush(SubscriptionId subscription, const Listener& listener);
+
+    private:
+        struct Field {
+            std::string path;
+            PropertyValue value;
+        };
+        struct Subscription {
+            bool active{ false };
+            std::vector<std::uint8_t> dirty; // One flag per field.
+            std::vector<FieldId> pending;    // Fields flagged dirty, in publish order.
+            std::vector<FieldId> flushing;   // Swapped with pending during flush.
+        };
+
+        template <typename T>
+        void publishValue(FieldId field, const T& value);
+
+        mutable std::mutex mutex_;
+        std::vector<Field> fields_;
+        std::vector<Subscription> subscriptions_;
+    };
+
+} // namespace ui
@@ -3,6 +3,8 @@
 #include "UIPropertyDescription.h"
 #include "UITheme.h"
 #include "IExposable.h"
+#include "UIPropertyBinding.h"
+#include <chrono>
 #include <vector>
 #include <memory>
 #include <unordered_map>
@@ -19,6 +21,8 @@ namespace ui {
         void addObject(std::shared_ptr<IExposable> obj);
         void combineWith(const UIPropertyPane& other);
         void refresh();
+        // Minimum time between applying pushed values; 0 applies them every frame.
+        void setLiveUpdateInterval(float seconds) { liveUpdateInterval_ = seconds; }
 
         // Theme-related methods.
         static void setUseBeautification(bool useBeautification);
@@ -26,10 +30,35 @@ namespace ui {
 
         void onStyleUpdate() override;
         void render(IRenderer* renderer) override;
+        // Applies changes queued by addObject/combineWith/refresh, at most once per frame.
+        void update() override;
 
     private:
+        // One line of the pane: an object header, a property group or a field.
+        struct PropertyRow {
+            std::string key;  // Stable identity used to match rows across reconciliations.
+            std::string text;
+            int depth{ 0 };
+        };
+
         UIPropertyPane(const std::string& title, const std::string& styleType, int zIndex);
-        void rebuildPropertyElements();
+        // Subscription to an object's UIPropertyBinding, parallel to objects_.
+        struct BoundObject {
+            UIPropertyBinding* binding{ nullptr };
+            UIPropertyBinding::SubscriptionId subscription{ 0 };
+            std::string objectKey;
+            std::vector<class UILabel*> fieldRows; // Resolved lazily, reset on reconcile.
+            std::vector<std::string> fieldPrefixes;
+        };
+
+        void scheduleReconcile();
+        void reconcilePropertyElements();
+        void bindObject(const std::shared_ptr<IExposable>& obj);
+        void applyLiveUpdates();
+        class UILabel* resolveFieldRow(BoundObject& bound, UIPropertyBinding::FieldId field);
+        void collectRows(std::vector<PropertyRow>& rows, std::vector<std::string>& objectKeys) const;
+        void appendDescriptionRows(std::vector<PropertyRow>& rows, std::unordered_map<std::string, int>& keyCounts,
+                                   const std::string& parentKey, const UIPropertyDescription& description, int depth) const;
         void renderPropertyTree(const UIPropertyDescription& description, glm::vec2& position);
         void renderBeautification(IRenderer* renderer, const glm::vec2& position, float width, const glm::vec4& color);
         void toggleSection();
@@ -39,6 +68,15 @@ namespace ui {
         float separatorHeight_{ 2.0f };
         glm::vec2 padding_{ 5.0f, 5.0f };
         std::unordered_map<std::string, std::function<void(UIElement*)>> customRenderers_;
+        bool reconcilePending_{ false };
+        std::vector<BoundObject> boundObjects_;
+        std::unordered_map<std::string, class UILabel*> rowsByKey_; // The rows this pane owns among its children.
+        std::string valueScratch_;
+        float liveUpdateInterval_{ 0.0f };
+        std::chrono::steady_clock::time_point lastLiveUpdate_{};
+
+        static constexpr float kRowHeight = 20.0f;
+        static constexpr float kIndent = 12.0f;
     };
 
 } // namespace ui
@@ -0,0 +1,17 @@
+#pragma once
+#include "UITextEdit.h"
+#include <string>
+
+namespace ui {
+
+// Multi-line variant of UITextField for scripts and expressions. Return inserts
+// a newline, Up/Down move between lines, and only visible lines are drawn.
+class UITextArea : public UITextEdit {
+public:
+    static std::unique_ptr<UITextArea> create();
+
+private:
+    UITextArea();
+};
+
+} // namespace ui
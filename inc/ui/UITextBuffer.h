@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ui {
+
+    // Gap buffer holding UTF-8 text. Edits at the cursor are O(edit size); moving
+    // the edit point costs O(distance moved). A line-start index is maintained
+    // incrementally so line lookups never rescan the text.
+    class UITextBuffer {
+    public:
+        explicit UITextBuffer(std::size_t initialCapacity = 64);
+
+        std::size_t size() const { return data_.size() - gapSize(); }
+        bool empty() const { return size() == 0; }
+        char at(std::size_t pos) const { return pos < gapStart_ ? data_[pos] : data_[pos + gapSize()]; }
+
+        void assign(std::string_view text);
+        void insert(std::size_t pos, std::string_view text);
+        void erase(std::size_t pos, std::size_t count);
+
+        std::string substr(std::size_t pos, std::size_t count) const;
+        std::string str() const { return substr(0, size()); }
+
+        // UTF-8 navigation. Positions are byte offsets on code point boundaries.
+        std::size_t nextBoundary(std::size_t pos) const;
+        std::size_t prevBoundary(std::size_t pos) const;
+        char32_t codepointAt(std::size_t pos) const;
+
+        // Line index ('\n' separated). lineEnd excludes the newline.
+        std::size_t lineCount() const { return lineStarts_.size(); }
+        std::size_t lineStart(std::size_t line) const { return lineStarts_[line]; }
+        std::size_t lineEnd(std::size_t line) const;
+        std::size_t lineOf(std::size_t pos) const;
+
+        // Bumped on every edit; lets callers key caches on the content.
+        std::uint64_t getRevision() const { return revision_; }
+
+    private:
+        std::size_t gapSize() const { return gapEnd_ - gapStart_; }
+        void moveGap(std::size_t pos);
+        void ensureGap(std::size_t minimum);
+
+        std::vector<char> data_;
+        std::size_t gapStart_{ 0 };
+        std::size_t gapEnd_{ 0 };
+        std::vector<std::size_t> lineStarts_{ 0 };
+        std::uint64_t revision_{ 0 };
+    };
+
+} // namespace ui
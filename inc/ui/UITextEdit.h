@@ -0,0 +1,53 @@
+#pragma once
+#include "UIElement.h"
+#include "UITextBuffer.h"
+#include "UITextMetrics.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace ui {
+
+    // Shared editing core for UITextField (single line) and UITextArea (multi
+    // line). Text lives in a gap buffer, cursor movement is UTF-8 aware, and
+    // rendering only measures and draws the part of the text inside the viewport.
+    class UITextEdit : public UIElement {
+    public:
+        void render(IRenderer* renderer) override;
+        bool handleInput(IMouseEvent* mouseEvent) override;
+        bool handleInput(IKeyboardEvent* keyboardEvent) override;
+        bool handleInput(ITextInputEvent* textEvent) override;
+        void onStyleUpdate() override;
+
+        void setText(const std::string& text);
+        std::string getText() const { return buffer_.str(); }
+        const UITextBuffer& getBuffer() const { return buffer_; }
+
+        std::size_t getCursor() const { return cursor_; }
+        void setCursor(std::size_t pos);
+        bool isMultiLine() const { return multiLine_; }
+
+    protected:
+        explicit UITextEdit(bool multiLine);
+
+        void insertAtCursor(std::string_view text);
+        void eraseRange(std::size_t pos, std::size_t count);
+        void moveCursorVertically(int lines);
+        void ensureCursorVisible(const glm::vec2& viewportSize);
+        void renderLine(IRenderer* renderer, std::size_t line, const glm::vec2& origin, float viewportWidth,
+                        const glm::vec4& color, float fontSize);
+
+        static constexpr float kTextInset = 5.0f;
+        static constexpr float kLineSpacing = 1.2f;
+
+        UITextBuffer buffer_;
+        UITextMetrics metrics_;
+        std::size_t cursor_{ 0 };
+        float preferredX_{ -1.0f };     // Column kept while moving up/down; -1 when unset.
+        glm::vec2 scroll_{ 0.0f, 0.0f }; // Viewport offset into the text.
+        float lineHeight_{ 0.0f };      // From the last render; 0 before the first one.
+        float alignOffset_{ 0.0f };     // Horizontal alignment shift applied at the last render.
+        bool multiLine_;
+    };
+
+} // namespace ui
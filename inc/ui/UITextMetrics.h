@@ -0,0 +1,52 @@
+#pragma once
+#include "IRenderer.h"
+#include "UITextBuffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ui {
+
+    // Caches horizontal text metrics for a UITextBuffer. Each line keeps prefix
+    // widths at code point boundaries, extended lazily only as far as a query
+    // needs, and truncated (not discarded) by edits. Glyph advances are measured
+    // once per code point and font size, so kerning between glyphs is ignored.
+    class UITextMetrics {
+    public:
+        void setRenderer(IRenderer* renderer);
+        bool hasRenderer() const { return renderer_ != nullptr; }
+        void setFontSize(float fontSize);
+
+        // Call after every buffer edit that starts at (line, byteInLine). lineDelta
+        // is the number of lines added (positive) or removed (negative).
+        void onEdit(std::size_t line, std::size_t byteInLine, std::ptrdiff_t lineDelta);
+        void invalidateAll();
+
+        // Width of the first byteInLine bytes of the line.
+        float prefixWidth(const UITextBuffer& buffer, std::size_t line, std::size_t byteInLine);
+        float lineWidth(const UITextBuffer& buffer, std::size_t line);
+        // Byte offset (within the line) of the boundary closest to x.
+        std::size_t byteAtX(const UITextBuffer& buffer, std::size_t line, float x);
+        // Last boundary at or before x / first boundary at or after x.
+        std::size_t floorByteAtX(const UITextBuffer& buffer, std::size_t line, float x);
+        std::size_t ceilByteAtX(const UITextBuffer& buffer, std::size_t line, float x);
+
+    private:
+        struct LineMetrics {
+            std::vector<std::uint32_t> offsets{ 0 }; // Code point boundaries (bytes from line start).
+            std::vector<float> widths{ 0.0f };       // Prefix width at each boundary.
+        };
+
+        LineMetrics& lineMetrics(const UITextBuffer& buffer, std::size_t line);
+        void extendTo(const UITextBuffer& buffer, std::size_t line, LineMetrics& metrics, std::size_t byteInLine);
+        void extendToX(const UITextBuffer& buffer, std::size_t line, LineMetrics& metrics, float x);
+        float advance(char32_t codepoint, const UITextBuffer& buffer, std::size_t pos, std::size_t length);
+
+        IRenderer* renderer_{ nullptr };
+        float fontSize_{ 0.0f };
+        std::vector<LineMetrics> lines_;
+        std::unordered_map<char32_t, float> advances_;
+    };
+
+} // namespace ui
@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+
+    // Fixed pool of worker threads for fork/join data-parallel work.
+    // The calling thread always takes part, so a pool with no workers simply runs inline.
+    class JobSystem {
+    public:
+        static JobSystem& getInstance();
+
+        size_t getWorkerCount() const { return workers_.size(); }
+
+        // Calls fn(i) for every i in [0, count) and returns once all calls finished.
+        // Indices are claimed in chunks of `grain`. The first exception thrown is rethrown here.
+        // Nested calls from inside a job run inline on the current thread.
+        void parallelFor(size_t count, const std::function<void(size_t)>& fn, size_t grain = 1);
+
+        // True on a thread that is currently executing parallelFor work.
+        static bool isInsideJob();
+
+    private:
+        explicit JobSystem(size_t workerCount);
+        ~JobSystem();
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        struct Batch {
+            const std::function<void(size_t)>* fn{ nullptr };
+            size_t count{ 0 };
+            size_t grain{ 1 };
+            std::atomic<size_t> next{ 0 };
+            std::exception_ptr error;
+            std::mutex errorMutex;
+        };
+
+        void workerLoop();
+        static void runChunks(Batch& batch);
+
+        std::vector<std::jthread> workers_;
+        std::mutex submitMutex_; // One batch in flight at a time.
+        std::mutex mutex_;
+        std::condition_variable wakeCv_;
+        std::condition_variable doneCv_;
+        Batch* current_{ nullptr };
+        size_t generation_{ 0 };
+        size_t busy_{ 0 };
+        bool stopping_{ false };
+    };
+
+} // namespace utils
@@ -0,0 +1,18 @@
+#!/bin/bash
+echo "Running benchmarks..."
+
+# Create build directory if it doesn't exist
+mkdir -p build
+cd build
+
+# Benchmarks are only meaningful in Release; results go to build/bench_output.json
+cmake -DBUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release ..
+cmake --build . --config Release --target bench
+if [ $? -ne 0 ]; then
+    echo "Benchmarks failed!"
+    cd ..
+    exit 1
+fi
+
+echo "Benchmark results written to build/bench_output.json"
+cd ..
@@ -0,0 +1,17 @@
+@echo off
+echo Running benchmarks...
+
+if not exist build mkdir build
+cd build
+
+REM Benchmarks are only meaningful in Release; results go to build\bench_output.json
+cmake -DBUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release ..
+cmake --build . --config Release --target bench
+if errorlevel 1 (
+    echo Benchmarks failed!
+    cd ..
+    exit /b 1
+)
+
+echo Benchmark results written to build\bench_output.json
+cd ..
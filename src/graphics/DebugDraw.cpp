@@ -0,0 +1,195 @@
+#include "graphics/DebugDraw.h"
+#include "graphics/DebugRasterizer.h"
+#include "ui/IRenderer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace graphics {
+
+    namespace {
+        thread_local void* tlsStreams = nullptr;
+
+        template <typename T>
+        void appendAndClear(std::vector<T>& into, std::vector<T>& from) {
+            into.insert(into.end(), from.begin(), from.end());
+            from.clear();
+        }
+
+        template <typename T>
+        void keepAlive(std::vector<T>& into, const std::vector<T>& from, float dt) {
+            for (const T& primitive : from) {
+                if (primitive.lifetime - dt > 0.0f) {
+                    into.push_back(primitive);
+                    into.back().lifetime -= dt;
+                }
+            }
+        }
+    }
+
+    DebugDraw& DebugDraw::getInstance() {
+        static DebugDraw instance;
+        return instance;
+    }
+
+    DebugDraw::Streams& DebugDraw::localStreams() {
+        if (!tlsStreams) {
+            std::lock_guard<std::mutex> lock(registryMutex_);
+            threadStreams_.push_back(std::make_unique<Streams>());
+            tlsStreams = threadStreams_.back().get();
+        }
+        return *static_cast<Streams*>(tlsStreams);
+    }
+
+    void DebugDraw::line(const glm::vec3& a, const glm::vec3& b, const glm::vec4& color, float lifetime, bool overlay) {
+        if (!isEnabled()) return;
+        localStreams().lines.push_back({ a, b, packColor(color), lifetime, overlayFlag(overlay) });
+    }
+
+    void DebugDraw::point(const glm::vec3& position, float size, const glm::vec4& color, float lifetime, bool overlay) {
+        if (!isEnabled()) return;
+        localStreams().points.push_back({ position, size, packColor(color), lifetime, overlayFlag(overlay) });
+    }
+
+    void DebugDraw::box(const glm::vec3& min, const glm::vec3& max, const glm::vec4& color, float lifetime, bool overlay) {
+        if (!isEnabled()) return;
+        localStreams().boxes.push_back({ min, max, packColor(color), lifetime, overlayFlag(overlay) });
+    }
+
+    void DebugDraw::arrow(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color, float headSize, float lifetime, bool overlay) {
+        if (!isEnabled()) return;
+        localStreams().arrows.push_back({ from, to, headSize, packColor(color), lifetime, overlayFlag(overlay) });
+    }
+
+    void DebugDraw::collect() {
+        frame_.clear();
+        appendAndClear(frame_.lines, retained_.lines);
+        appendAndClear(frame_.points, retained_.points);
+        appendAndClear(frame_.boxes, retained_.boxes);
+        appendAndClear(frame_.arrows, retained_.arrows);
+
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        for (auto& streams : threadStreams_) {
+            appendAndClear(frame_.lines, streams->lines);
+            appendAndClear(frame_.points, streams->points);
+            appendAndClear(frame_.boxes, streams->boxes);
+            appendAndClear(frame_.arrows, streams->arrows);
+        }
+    }
+
+    void DebugDraw::emitSegment(const glm::vec3& a, const glm::vec3& b, uint32_t color, uint8_t flags) {
+        segments_.push_back({ toScreen(a), toScreen(b), a.z, b.z, color, flags });
+    }
+
+    void DebugDraw::expand() {
+        segments_.clear();
+        segments_.reserve(frame_.lines.size() + frame_.points.size() * 2 + frame_.boxes.size() * 12 + frame_.arrows.size() * 3);
+
+        for (const Line& l : frame_.lines) {
+            emitSegment(l.a, l.b, l.color, l.flags);
+        }
+
+        // Points are screen-space crosses, `size` pixels across.
+        for (const Point& p : frame_.points) {
+            const glm::vec2 c = toScreen(p.position);
+            const float h = p.size * 0.5f;
+            segments_.push_back({ c - glm::vec2(h, 0.0f), c + glm::vec2(h, 0.0f), p.position.z, p.position.z, p.color, p.flags });
+            segments_.push_back({ c - glm::vec2(0.0f, h), c + glm::vec2(0.0f, h), p.position.z, p.position.z, p.color, p.flags });
+        }
+
+        for (const Box& b : frame_.boxes) {
+            const glm::vec3 lo = b.min;
+            const glm::vec3 hi = b.max;
+            const glm::vec3 corners[8] = {
+                { lo.x, lo.y, lo.z }, { hi.x, lo.y, lo.z }, { hi.x, hi.y, lo.z }, { lo.x, hi.y, lo.z },
+                { lo.x, lo.y, hi.z }, { hi.x, lo.y, hi.z }, { hi.x, hi.y, hi.z }, { lo.x, hi.y, hi.z },
+            };
+            for (int i = 0; i < 4; ++i) {
+                emitSegment(corners[i], corners[(i + 1) % 4], b.color, b.flags);
+                if (lo.z != hi.z) {
+                    emitSegment(corners[i + 4], corners[(i + 1) % 4 + 4], b.color, b.flags);
+                    emitSegment(corners[i], corners[i + 4], b.color, b.flags);
+                }
+            }
+        }
+
+        // Arrow heads are built in screen space so they keep their size at any zoom.
+        for (const Arrow& a : frame_.arrows) {
+            emitSegment(a.from, a.to, a.color, a.flags);
+            const glm::vec2 s0 = toScreen(a.from);
+            const glm::vec2 s1 = toScreen(a.to);
+            const glm::vec2 delta = s1 - s0;
+            const float length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+            if (length <= 0.0f) continue;
+            const glm::vec2 dir = delta / length;
+            const glm::vec2 side(-dir.y, dir.x);
+            const float head = std::min(a.headSize, length * 0.5f);
+            const glm::vec2 base = s1 - dir * head;
+            segments_.push_back({ s1, base + side * (head * 0.5f), a.to.z, a.to.z, a.color, a.flags });
+            segments_.push_back({ s1, base - side * (head * 0.5f), a.to.z, a.to.z, a.color, a.flags });
+        }
+
+        // Depth-tested first, overlay last; within each, group by color so each run is one batch.
+        std::sort(segments_.begin(), segments_.end(), [](const Segment& x, const Segment& y) {
+            if (x.flags != y.flags) return x.flags < y.flags;
+            return x.color < y.color;
+        });
+        lastSegmentCount_ = segments_.size();
+    }
+
+    void DebugDraw::retire(float dt) {
+        retained_.clear();
+        keepAlive(retained_.lines, frame_.lines, dt);
+        keepAlive(retained_.points, frame_.points, dt);
+        keepAlive(retained_.boxes, frame_.boxes, dt);
+        keepAlive(retained_.arrows, frame_.arrows, dt);
+    }
+
+    void DebugDraw::flush(ui::IRenderer* renderer, float dt) {
+        collect();
+        if (renderer) {
+            expand();
+            // The vector path has no depth buffer: depth only orders tested geometry under overlays.
+            for (size_t begin = 0; begin < segments_.size();) {
+                size_t end = begin;
+                batch_.clear();
+                while (end < segments_.size() && segments_[end].color == segments_[begin].color &&
+                       segments_[end].flags == segments_[begin].flags) {
+                    batch_.push_back(segments_[end].a);
+                    batch_.push_back(segments_[end].b);
+                    ++end;
+                }
+                renderer->drawLines(batch_.data(), batch_.size(), unpackColor(segments_[begin].color));
+                begin = end;
+            }
+        }
+        retire(dt);
+    }
+
+    void DebugDraw::flush(DebugRasterizer& target, float dt) {
+        collect();
+        expand();
+        for (const Segment& s : segments_) {
+            target.drawLine(s.a, s.depthA, s.b, s.depthB, s.color, (s.flags & kOverlay) == 0);
+        }
+        retire(dt);
+    }
+
+    void DebugDraw::clear() {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        for (auto& streams : threadStreams_) streams->clear();
+        retained_.clear();
+        frame_.clear();
+    }
+
+    uint32_t DebugDraw::packColor(const glm::vec4& color) {
+        auto channel = [](float v) { return static_cast<uint32_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f); };
+        return channel(color.r) | (channel(color.g) << 8) | (channel(color.b) << 16) | (channel(color.a) << 24);
+    }
+
+    glm::vec4 DebugDraw::unpackColor(uint32_t color) {
+        constexpr float scale = 1.0f / 255.0f;
+        return glm::vec4(static_cast<float>(color & 0xFF) * scale, static_cast<float>((color >> 8) & 0xFF) * scale,
+                         static_cast<float>((color >> 16) & 0xFF) * scale, static_cast<float>(color >> 24) * scale);
+    }
+
+} // namespace graphics
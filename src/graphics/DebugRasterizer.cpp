@@ -0,0 +1,83 @@
+#include "graphics/DebugRasterizer.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+namespace graphics {
+
+    DebugRasterizer::DebugRasterizer(int width, int height)
+        : width_(0), height_(0) {
+        resize(width, height);
+    }
+
+    void DebugRasterizer::resize(int width, int height) {
+        width_ = std::max(width, 0);
+        height_ = std::max(height, 0);
+        color_.assign(static_cast<size_t>(width_) * height_, 0);
+        depth_.assign(static_cast<size_t>(width_) * height_, -std::numeric_limits<float>::infinity());
+    }
+
+    void DebugRasterizer::clear(uint32_t color) {
+        std::fill(color_.begin(), color_.end(), color);
+        std::fill(depth_.begin(), depth_.end(), -std::numeric_limits<float>::infinity());
+    }
+
+    void DebugRasterizer::drawLine(const glm::vec2& a, float depthA, const glm::vec2& b, float depthB, uint32_t color, bool depthTest) {
+        if (width_ == 0 || height_ == 0) return;
+
+        // Liang-Barsky clip against the pixel rect so off-screen geometry costs nothing.
+        float t0 = 0.0f, t1 = 1.0f;
+        const glm::vec2 d = b - a;
+        const float p[4] = { -d.x, d.x, -d.y, d.y };
+        const float q[4] = { a.x, static_cast<float>(width_ - 1) - a.x, a.y, static_cast<float>(height_ - 1) - a.y };
+        for (int i = 0; i < 4; ++i) {
+            if (p[i] == 0.0f) {
+                if (q[i] < 0.0f) return;
+                continue;
+            }
+            const float t = q[i] / p[i];
+            if (p[i] < 0.0f) t0 = std::max(t0, t);
+            else t1 = std::min(t1, t);
+            if (t0 > t1) return;
+        }
+
+        const glm::vec2 start = a + d * t0;
+        const glm::vec2 end = a + d * t1;
+        const float zStart = depthA + (depthB - depthA) * t0;
+        const float zEnd = depthA + (depthB - depthA) * t1;
+
+        const int steps = static_cast<int>(std::ceil(std::max(std::abs(end.x - start.x), std::abs(end.y - start.y))));
+        const float inv = steps > 0 ? 1.0f / static_cast<float>(steps) : 0.0f;
+        for (int i = 0; i <= steps; ++i) {
+            const float t = static_cast<float>(i) * inv;
+            const int x = static_cast<int>(start.x + (end.x - start.x) * t + 0.5f);
+            const int y = static_cast<int>(start.y + (end.y - start.y) * t + 0.5f);
+            if (x < 0 || y < 0 || x >= width_ || y >= height_) continue;
+            const size_t index = static_cast<size_t>(y) * width_ + x;
+            const float z = zStart + (zEnd - zStart) * t;
+            if (depthTest) {
+                if (z < depth_[index]) continue;
+                depth_[index] = z;
+            }
+            color_[index] = color;
+        }
+    }
+
+    bool DebugRasterizer::writePPM(const std::filesystem::path& path) const {
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            spdlog::error("DebugRasterizer: cannot open '{}' for writing", path.string());
+            return false;
+        }
+        file << "P6\n" << width_ << ' ' << height_ << "\n255\n";
+        for (uint32_t pixel : color_) {
+            const char rgb[3] = { static_cast<char>(pixel & 0xFF), static_cast<char>((pixel >> 8) & 0xFF),
+                                  static_cast<char>((pixel >> 16) & 0xFF) };
+            file.write(rgb, 3);
+        }
+        return static_cast<bool>(file);
+    }
+
+} // namespace graphics
@@ -1,8 +1,13 @@
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_opengl.h>
 #include <glm/glm.hpp>
+#include <chrono>
+#include <cstdlib>
 #include <memory>
 #include <iostream>
+#include <filesystem>
+#include <optional>
+#include <string>
 
 #define NANOVG_GL3
 #include <nanovg.h>
@@ -13,9 +18,121 @@
 #include "ui/UIManager.h"
 #include "ui/SDLInputTranslator.h"
 #include "ui/NanoVGRenderer.h"
+#include "ui/HeadlessRenderer.h"
+#include "ui/UIPropertyPane.h"
+#include "ui/SimulationClockInspector.h"
+#include "ui/BodyInspector.h"
 
-int main(int, char**)
+#include "graphics/DebugDraw.h"
+
+#include "physics/PhysicsWorld.h"
+#include "physics/PhysicsBody.h"
+#include "physics/SimulationClock.h"
+
+// Build the demo UI. Shared by the interactive loop and headless replay so a
+// recorded session is replayed against the same element tree.
+static void buildScene(ui::UIManager& uiManager, std::shared_ptr<ui::SimulationClockInspector> clockStats,
+                       std::shared_ptr<ui::BodyInspector> bodyStats)
 {
+    // Create a UI canvas via UIFactory (instead of directly using std::make_unique)
+    auto canvas = ui::UIFactory::createCanvas("canvas", 0);
+    canvas->setPosition(glm::vec2(0.0f, 0.0f));
+    canvas->setSize(glm::vec2(1280.0f, 720.0f));
+
+    // Create a button with the label "Click Me" using its static create method
+    auto button = ui::UIButton::create("Click Me");
+    // Position the button near the center of the canvas
+    button->setPosition(glm::vec2(540.0f, 335.0f));
+    button->setSize(glm::vec2(200.0f, 50.0f));
+    // Set a callback for when the button is clicked
+    button->setOnClick([]() {
+        SDL_Log("Button clicked!");
+        });
+    // Add the button to the canvas
+    canvas->addChild(std::move(button));
+
+    // Register the canvas with the UIManager so it gets updated and rendered
+    uiManager.addCanvas(std::move(canvas));
+
+    // Clock timing and one body's motion state, pushed live through the inspectors' bindings.
+    auto statsPane = ui::UIPropertyPane::create("Simulation", "propertyPane", 1);
+    statsPane->setPosition(glm::vec2(1010.0f, 10.0f));
+    statsPane->setSize(glm::vec2(260.0f, 600.0f));
+    statsPane->addObject(std::move(clockStats));
+    statsPane->addObject(std::move(bodyStats));
+    uiManager.addCanvas(std::move(statsPane));
+}
+
+// A floor and a short stack of boxes, so the simulation clock has something to step.
+// Returns the top box, which the stats pane follows.
+static physics::BodyHandle buildPhysicsScene(physics::PhysicsWorld& world)
+{
+    physics::BodyDesc floor;
+    floor.mass = 0.0f;
+    floor.shape = physics::Shape::box(glm::vec3(10.0f, 0.5f, 10.0f));
+    floor.position = glm::vec3(0.0f, -0.5f, 0.0f);
+    world.createBody(floor);
+
+    physics::BodyHandle top;
+    for (int i = 0; i < 5; ++i) {
+        physics::BodyDesc box;
+        box.shape = physics::Shape::box(glm::vec3(0.5f));
+        box.position = glm::vec3(0.0f, 0.5f + i * 1.0f, 0.0f);
+        top = world.createBody(box);
+    }
+    return top;
+}
+
+int main(int argc, char** argv)
+{
+    // --record <log>      record the translated input stream of this session
+    // --replay <log>      replay a recorded session headlessly and print per-frame timings
+    // --realtime          pace a replay to its recorded timestamps instead of full speed
+    // --sim-hz <rate>     fixed physics step rate (default 240), independent of the frame rate
+    // --max-substeps <n>  physics steps allowed per frame before time is dropped (default 8)
+    std::optional<std::filesystem::path> recordPath;
+    std::optional<std::filesystem::path> replayPath;
+    bool realTimeReplay = false;
+    double simulationRate = 240.0;
+    int maxSubsteps = 8;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        }
+        else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        }
+        else if (arg == "--realtime") {
+            realTimeReplay = true;
+        }
+        else if (arg == "--sim-hz" && i + 1 < argc) {
+            simulationRate = std::atof(argv[++i]);
+        }
+        else if (arg == "--max-substeps" && i + 1 < argc) {
+            maxSubsteps = std::atoi(argv[++i]);
+        }
+    }
+
+    if (replayPath) {
+        ui::UIManager& uiManager = ui::UIManager::getInstance();
+        // Nothing is simulated during replay; the world and clock only back the stats pane.
+        physics::PhysicsWorld world;
+        const physics::BodyHandle topBox = buildPhysicsScene(world);
+        auto clock = std::make_shared<physics::SimulationClock>(simulationRate, maxSubsteps);
+        buildScene(uiManager, std::make_shared<ui::SimulationClockInspector>(clock),
+                   std::make_shared<ui::BodyInspector>(physics::PhysicsBody(world, topBox)));
+        ui::HeadlessRenderer renderer;
+        auto timings = uiManager.replayInput(*replayPath, &renderer,
+            realTimeReplay ? ui::ReplayMode::RealTime : ui::ReplayMode::FullSpeed);
+        std::cout << "frame,events,input_ms,update_ms,render_ms,total_ms\n";
+        for (const auto& timing : timings) {
+            std::cout << timing.frame << ',' << timing.eventCount << ',' << timing.inputMs << ','
+                      << timing.updateMs << ',' << timing.renderMs << ',' << timing.totalMs() << '\n';
+        }
+        return timings.empty() ? 1 : 0;
+    }
+
     // Initialize SDL (video and events)
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS) != 0) {
         std::cerr << "Unable to initialize SDL: " << SDL_GetError() << std::endl;
@@ -61,28 +178,25 @@ int main(int, char**)
     ui::UIManager& uiManager = ui::UIManager::getInstance();
     uiManager.setInputTranslator(std::make_unique<ui::SDLInputTranslator>());
 
-    // Create a UI canvas via UIFactory (instead of directly using std::make_unique)
-    auto canvas = ui::UIFactory::createCanvas("canvas", 0);
-    canvas->setPosition(glm::vec2(0.0f, 0.0f));
-    canvas->setSize(glm::vec2(1280.0f, 720.0f));
+    // Physics runs on its own fixed clock; the frame loop only feeds it wall time.
+    physics::PhysicsWorld world;
+    const physics::BodyHandle topBox = buildPhysicsScene(world);
+    auto clock = std::make_shared<physics::SimulationClock>(simulationRate, maxSubsteps);
+    auto clockStats = std::make_shared<ui::SimulationClockInspector>(clock);
+    auto bodyStats = std::make_shared<ui::BodyInspector>(physics::PhysicsBody(world, topBox));
 
-    // Create a button with the label "Click Me" using its static create method
-    auto button = ui::UIButton::create("Click Me");
-    // Position the button near the center of the canvas
-    button->setPosition(glm::vec2(540.0f, 335.0f));
-    button->setSize(glm::vec2(200.0f, 50.0f));
-    // Set a callback for when the button is clicked
-    button->setOnClick([]() {
-        SDL_Log("Button clicked!");
-        });
-    // Add the button to the canvas
-    canvas->addChild(std::move(button));
+    buildScene(uiManager, clockStats, bodyStats);
+    if (recordPath) {
+        uiManager.startRecording(*recordPath);
+    }
 
-    // Register the canvas with the UIManager so it gets updated and rendered
-    uiManager.addCanvas(std::move(canvas));
+    // One metre is 40 pixels, with the floor near the bottom of the window.
+    graphics::DebugDraw& debugDraw = graphics::DebugDraw::getInstance();
+    debugDraw.setView(glm::vec2(640.0f, 600.0f), 40.0f);
 
     bool running = true;
     SDL_Event event;
+    auto lastFrame = std::chrono::steady_clock::now();
     while (running)
     {
         // Process SDL events
@@ -95,6 +209,26 @@ int main(int, char**)
             uiManager.processInput(&event);
         }
 
+        // Step physics for the wall time since the last frame.
+        const auto now = std::chrono::steady_clock::now();
+        const double frameSeconds = std::chrono::duration<double>(now - lastFrame).count();
+        clock->advance(frameSeconds, [&](float dt) { world.step(dt); });
+        clockStats->publish();
+        bodyStats->publish();
+        lastFrame = now;
+
+        // Bodies are drawn as their bounds, blended between the last two steps by the clock's
+        // alpha to hide the step/frame mismatch. Sleeping bodies are dimmed.
+        const float alpha = clock->getAlpha();
+        for (size_t i = 0; i < world.getBodyCount(); ++i) {
+            const physics::BodyHandle handle = world.handleAt(i);
+            const physics::Aabb bounds = world.getBodies().shapes[i].computeAabb(
+                world.getRenderPosition(handle, alpha), world.getRenderOrientation(handle, alpha));
+            // World y points up and screen y down.
+            debugDraw.box(glm::vec3(bounds.min.x, -bounds.max.y, bounds.min.z), glm::vec3(bounds.max.x, -bounds.min.y, bounds.max.z),
+                          world.isSleeping(handle) ? glm::vec4(0.4f, 0.4f, 0.5f, 1.0f) : glm::vec4(0.3f, 0.8f, 1.0f, 1.0f));
+        }
+
         // Update UI logic
         uiManager.update();
 
@@ -105,6 +239,11 @@ int main(int, char**)
         // Render the UI
         uiManager.render(&renderer);
 
+        // Debug overlay on top of the UI; timed primitives age by the frame time.
+        nvgBeginFrame(vg, 1280.0f, 720.0f, 1.0f);
+        debugDraw.flush(&renderer, static_cast<float>(frameSeconds));
+        nvgEndFrame(vg);
+
         // Swap buffers to display the rendered frame
         SDL_GL_SwapWindow(window);
 
@@ -113,6 +252,7 @@ int main(int, char**)
     }
 
     // Cleanup resources
+    uiManager.stopRecording();
     nvgDeleteGL3(vg);
     SDL_GL_DestroyContext(glContext);
     SDL_DestroyWindow(window);
@@ -0,0 +1,74 @@
+#include "physics/BodyStorage.h"
+#include <utility>
+
+namespace physics {
+
+    std::array<AlignedVector<float>*, BodyStorage::kFloatColumns> BodyStorage::floatColumns() {
+        return { &positionX, &positionY, &positionZ,
+                 &orientationW, &orientationX, &orientationY, &orientationZ,
+                 &velocityX, &velocityY, &velocityZ,
+                 &angularVelocityX, &angularVelocityY, &angularVelocityZ,
+                 &forceX, &forceY, &forceZ,
+                 &torqueX, &torqueY, &torqueZ,
+                 &inverseMass,
+                 &inverseInertiaX, &inverseInertiaY, &inverseInertiaZ,
+                 &previousPositionX, &previousPositionY, &previousPositionZ,
+                 &previousOrientationW, &previousOrientationX, &previousOrientationY, &previousOrientationZ };
+    }
+
+    void BodyStorage::reserve(size_t capacity) {
+        for (auto* column : floatColumns()) column->reserve(capacity);
+        flags.reserve(capacity);
+        restSteps.reserve(capacity);
+        shapes.reserve(capacity);
+    }
+
+    size_t BodyStorage::push() {
+        for (auto* column : floatColumns()) column->push_back(0.0f);
+        orientationW.back() = 1.0f;
+        previousOrientationW.back() = 1.0f;
+        flags.push_back(0);
+        restSteps.push_back(0);
+        shapes.emplace_back();
+        return flags.size() - 1;
+    }
+
+    void BodyStorage::swapRemove(size_t index) {
+        const size_t last = size() - 1;
+        for (auto* column : floatColumns()) {
+            (*column)[index] = (*column)[last];
+            column->pop_back();
+        }
+        flags[index] = flags[last];
+        flags.pop_back();
+        restSteps[index] = restSteps[last];
+        restSteps.pop_back();
+        shapes[index] = shapes[last];
+        shapes.pop_back();
+    }
+
+    void BodyStorage::swap(size_t a, size_t b) {
+        if (a == b) return;
+        for (auto* column : floatColumns()) std::swap((*column)[a], (*column)[b]);
+        std::swap(flags[a], flags[b]);
+        std::swap(restSteps[a], restSteps[b]);
+        std::swap(shapes[a], shapes[b]);
+    }
+
+    void BodyStorage::clear() {
+        for (auto* column : floatColumns()) column->clear();
+        flags.clear();
+        restSteps.clear();
+        shapes.clear();
+    }
+
+    glm::mat3 BodyStorage::inverseInertiaWorld(size_t i) const {
+        const glm::mat3 rotation = glm::mat3_cast(orientation(i));
+        glm::mat3 scaled = rotation;
+        scaled[0] *= inverseInertiaX[i];
+        scaled[1] *= inverseInertiaY[i];
+        scaled[2] *= inverseInertiaZ[i];
+        return scaled * glm::transpose(rotation);
+    }
+
+} // namespace physics
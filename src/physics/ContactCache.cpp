@@ -0,0 +1,132 @@
+#include "physics/ContactCache.h"
+#include <algorithm>
+#include <bit>
+
+namespace physics {
+
+    namespace {
+        constexpr size_t kMinCapacity = 64;
+        // Cosine of the largest normal change that still keeps the old impulses.
+        constexpr float kNormalTolerance = 0.95f;
+    }
+
+    void matchContactPoints(const ContactManifold& previous, ContactManifold& current) {
+        const bool sameNormal = glm::dot(previous.normal, current.normal) > kNormalTolerance;
+        for (int i = 0; i < current.pointCount; ++i) {
+            ContactPoint& point = current.points[i];
+            point.normalImpulse = 0.0f;
+            point.tangentImpulse[0] = point.tangentImpulse[1] = 0.0f;
+            if (!sameNormal) continue;
+            for (int j = 0; j < previous.pointCount; ++j) {
+                const ContactPoint& old = previous.points[j];
+                if (old.feature != point.feature) continue;
+                point.normalImpulse = old.normalImpulse;
+                point.tangentImpulse[0] = old.tangentImpulse[0];
+                point.tangentImpulse[1] = old.tangentImpulse[1];
+                break;
+            }
+        }
+    }
+
+    ContactCache::ContactCache() {
+        rehash(kMinCapacity);
+    }
+
+    size_t ContactCache::findSlot(uint64_t key) const {
+        const size_t mask = slots_.size() - 1;
+        for (size_t slot = homeOf(key);; slot = (slot + 1) & mask) {
+            if (slots_[slot].key == key) return slot;
+            if (slots_[slot].key == kEmptyKey) return SIZE_MAX;
+        }
+    }
+
+    const Contact* ContactCache::find(uint32_t bodyA, uint32_t bodyB) const {
+        const size_t slot = findSlot(keyOf(bodyA, bodyB));
+        return slot == SIZE_MAX ? nullptr : &contacts_[slots_[slot].index];
+    }
+
+    void ContactCache::store(const Contact& contact) {
+        const uint64_t key = keyOf(contact.bodyA, contact.bodyB);
+        const size_t mask = slots_.size() - 1;
+        size_t slot = homeOf(key);
+        for (; slots_[slot].key != kEmptyKey; slot = (slot + 1) & mask) {
+            if (slots_[slot].key == key) {
+                contacts_[slots_[slot].index] = contact;
+                touched_[slots_[slot].index] = 1;
+                return;
+            }
+        }
+
+        slots_[slot] = { key, static_cast<uint32_t>(contacts_.size()) };
+        contacts_.push_back(contact);
+        touched_.push_back(1);
+        if (contacts_.size() * 2 > slots_.size()) rehash(slots_.size() * 2);
+    }
+
+    void ContactCache::keep(uint32_t bodyA, uint32_t bodyB) {
+        const size_t slot = findSlot(keyOf(bodyA, bodyB));
+        if (slot != SIZE_MAX) touched_[slots_[slot].index] = 1;
+    }
+
+    void ContactCache::eraseSlot(size_t hole) {
+        // Backward shift: pull later entries of the probe run into the hole unless that would
+        // move them in front of their home slot.
+        const size_t mask = slots_.size() - 1;
+        for (size_t next = (hole + 1) & mask; slots_[next].key != kEmptyKey; next = (next + 1) & mask) {
+            const size_t home = homeOf(slots_[next].key);
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                slots_[hole] = slots_[next];
+                hole = next;
+            }
+        }
+        slots_[hole].key = kEmptyKey;
+    }
+
+    void ContactCache::removeAt(size_t index) {
+        const Contact& contact = contacts_[index];
+        eraseSlot(findSlot(keyOf(contact.bodyA, contact.bodyB)));
+
+        const size_t last = contacts_.size() - 1;
+        if (index != last) {
+            contacts_[index] = contacts_[last];
+            touched_[index] = touched_[last];
+            slots_[findSlot(keyOf(contacts_[index].bodyA, contacts_[index].bodyB))].index = static_cast<uint32_t>(index);
+        }
+        contacts_.pop_back();
+        touched_.pop_back();
+    }
+
+    void ContactCache::eraseUntouched() {
+        // Backwards, so whatever swaps into a hole has already been looked at.
+        for (size_t i = contacts_.size(); i-- > 0;) {
+            if (!touched_[i]) removeAt(i);
+        }
+        std::fill(touched_.begin(), touched_.end(), uint8_t(0));
+    }
+
+    void ContactCache::eraseBody(uint32_t bodyId) {
+        for (size_t i = contacts_.size(); i-- > 0;) {
+            if (contacts_[i].bodyA == bodyId || contacts_[i].bodyB == bodyId) removeAt(i);
+        }
+    }
+
+    void ContactCache::clear() {
+        contacts_.clear();
+        touched_.clear();
+        rehash(kMinCapacity);
+    }
+
+    void ContactCache::rehash(size_t capacity) {
+        capacity = std::bit_ceil(std::max(capacity, kMinCapacity));
+        slots_.assign(capacity, Slot{ kEmptyKey, 0 });
+        shift_ = 64 - std::countr_zero(capacity);
+        const size_t mask = capacity - 1;
+        for (size_t i = 0; i < contacts_.size(); ++i) {
+            const uint64_t key = keyOf(contacts_[i].bodyA, contacts_[i].bodyB);
+            size_t slot = homeOf(key);
+            while (slots_[slot].key != kEmptyKey) slot = (slot + 1) & mask;
+            slots_[slot] = { key, static_cast<uint32_t>(i) };
+        }
+    }
+
+} // namespace physics
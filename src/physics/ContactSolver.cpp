@@ -0,0 +1,397 @@
+#include "physics/ContactSolver.h"
+#include "utils/JobSystem.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+
+namespace physics {
+
+    namespace {
+        // Caps the push-out speed so deep overlaps (spawning inside each other) separate gently.
+        constexpr float kMaxBiasVelocity = 4.0f;
+        constexpr size_t kPrepareGrain = 64;
+        // Wide groups per job; a color smaller than this is solved inline.
+        constexpr size_t kGroupsPerJob = 8;
+        constexpr uint32_t kPaddingLane = UINT32_MAX;
+        constexpr uint8_t kOverflowColor = 0xFF;
+
+        // Friction directions depend only on the normal, so carried-over tangent impulses stay meaningful.
+        void tangentBasis(const glm::vec3& n, glm::vec3& t1, glm::vec3& t2) {
+            t1 = std::abs(n.x) > 0.57735f ? glm::vec3(n.y, -n.x, 0.0f) : glm::vec3(0.0f, n.z, -n.y);
+            t1 = glm::normalize(t1);
+            t2 = glm::cross(n, t1);
+        }
+
+        float effectiveMass(float inverseMassA, float inverseMassB, const glm::mat3& inverseInertiaA, const glm::mat3& inverseInertiaB,
+                            const glm::vec3& rA, const glm::vec3& rB, const glm::vec3& direction) {
+            const glm::vec3 rnA = glm::cross(rA, direction);
+            const glm::vec3 rnB = glm::cross(rB, direction);
+            const float k = inverseMassA + inverseMassB + glm::dot(rnA, inverseInertiaA * rnA) + glm::dot(rnB, inverseInertiaB * rnB);
+            return k > 0.0f ? 1.0f / k : 0.0f;
+        }
+
+        // World inverse inertia is symmetric, so six components describe it.
+        SimdVec3 mulSymmetric(const SimdFloat* m, const SimdVec3& v) {
+            return { m[0] * v.x + m[3] * v.y + m[4] * v.z,
+                     m[3] * v.x + m[1] * v.y + m[5] * v.z,
+                     m[4] * v.x + m[5] * v.y + m[2] * v.z };
+        }
+
+        SimdVec3 gather(const AlignedVector<float>& x, const AlignedVector<float>& y, const AlignedVector<float>& z, const uint32_t* index) {
+            alignas(32) float bx[SimdFloat::kWidth], by[SimdFloat::kWidth], bz[SimdFloat::kWidth];
+            for (int l = 0; l < SimdFloat::kWidth; ++l) {
+                bx[l] = x[index[l]];
+                by[l] = y[index[l]];
+                bz[l] = z[index[l]];
+            }
+            return { SimdFloat::load(bx), SimdFloat::load(by), SimdFloat::load(bz) };
+        }
+
+        void scatter(AlignedVector<float>& x, AlignedVector<float>& y, AlignedVector<float>& z, const uint32_t* index, const uint8_t* write,
+                     const SimdVec3& v) {
+            alignas(32) float bx[SimdFloat::kWidth], by[SimdFloat::kWidth], bz[SimdFloat::kWidth];
+            v.x.store(bx);
+            v.y.store(by);
+            v.z.store(bz);
+            for (int l = 0; l < SimdFloat::kWidth; ++l) {
+                if (!write[l]) continue;
+                x[index[l]] = bx[l];
+                y[index[l]] = by[l];
+                z[index[l]] = bz[l];
+            }
+        }
+    }
+
+    void ContactSolver::prepare(const BodyStorage& bodies, const std::vector<Contact>& contacts, const std::vector<uint32_t>& contactIndices,
+                                const std::vector<uint32_t>& bodyIndices, const ContactSolverSettings& settings, float dt) {
+        constraints_.resize(contactIndices.size());
+        const float inverseDt = 1.0f / dt;
+
+        utils::JobSystem::getInstance().parallelFor(contactIndices.size(), [&](size_t c) {
+            const ContactManifold& manifold = contacts[contactIndices[c]].manifold;
+            ManifoldConstraint& mc = constraints_[c];
+            mc.contact = contactIndices[c];
+            mc.indexA = bodyIndices[c * 2];
+            mc.indexB = bodyIndices[c * 2 + 1];
+
+            // Static and kinematic bodies act as infinitely heavy.
+            mc.dynamicA = (bodies.flags[mc.indexA] & (kBodyStatic | kBodyKinematic)) == 0;
+            mc.dynamicB = (bodies.flags[mc.indexB] & (kBodyStatic | kBodyKinematic)) == 0;
+            mc.inverseMassA = mc.dynamicA ? bodies.inverseMass[mc.indexA] : 0.0f;
+            mc.inverseMassB = mc.dynamicB ? bodies.inverseMass[mc.indexB] : 0.0f;
+            mc.inverseInertiaA = mc.dynamicA ? bodies.inverseInertiaWorld(mc.indexA) : glm::mat3(0.0f);
+            mc.inverseInertiaB = mc.dynamicB ? bodies.inverseInertiaWorld(mc.indexB) : glm::mat3(0.0f);
+            mc.normal = manifold.normal;
+            tangentBasis(mc.normal, mc.tangents[0], mc.tangents[1]);
+            mc.friction = settings.friction;
+            mc.pointCount = manifold.pointCount;
+
+            const glm::vec3 positionA = bodies.position(mc.indexA);
+            const glm::vec3 positionB = bodies.position(mc.indexB);
+            for (int p = 0; p < manifold.pointCount; ++p) {
+                const ContactPoint& point = manifold.points[p];
+                PointConstraint& pc = mc.points[p];
+                pc.rA = point.position - positionA;
+                pc.rB = point.position - positionB;
+                pc.normalMass = effectiveMass(mc.inverseMassA, mc.inverseMassB, mc.inverseInertiaA, mc.inverseInertiaB, pc.rA, pc.rB, mc.normal);
+                for (int t = 0; t < 2; ++t) {
+                    pc.tangentMass[t] = effectiveMass(mc.inverseMassA, mc.inverseMassB, mc.inverseInertiaA, mc.inverseInertiaB,
+                                                      pc.rA, pc.rB, mc.tangents[t]);
+                }
+
+                // Separated: the bodies may approach by at most the gap this step. Penetrating:
+                // push apart by a fraction of the depth beyond the slop.
+                pc.bias = point.depth < 0.0f
+                    ? point.depth * inverseDt
+                    : std::min(settings.baumgarte * std::max(0.0f, point.depth - settings.slop) * inverseDt, kMaxBiasVelocity);
+
+                const bool warm = settings.warmStarting;
+                pc.normalImpulse = warm ? point.normalImpulse : 0.0f;
+                pc.tangentImpulse[0] = warm ? point.tangentImpulse[0] : 0.0f;
+                pc.tangentImpulse[1] = warm ? point.tangentImpulse[1] : 0.0f;
+            }
+        }, kPrepareGrain);
+
+        colorConstraints(bodies);
+        utils::JobSystem::getInstance().parallelFor(groups_.size(), [&](size_t g) {
+            packGroup(groups_[g]);
+        }, kGroupsPerJob);
+    }
+
+    void ContactSolver::colorConstraints(const BodyStorage& bodies) {
+        // Greedy first-fit in contact order: each manifold takes the lowest color neither of its
+        // dynamic bodies has yet. Serial, so the coloring doesn't depend on the thread count.
+        bodyColors_.assign(bodies.size(), 0);
+        constraintColors_.resize(constraints_.size());
+        overflow_.clear();
+        std::array<uint32_t, kMaxColors> counts{};
+        int colorCount = 0;
+        for (size_t c = 0; c < constraints_.size(); ++c) {
+            const ManifoldConstraint& mc = constraints_[c];
+            uint64_t used = 0;
+            if (mc.dynamicA) used |= bodyColors_[mc.indexA];
+            if (mc.dynamicB) used |= bodyColors_[mc.indexB];
+            if (used == UINT64_MAX) {
+                constraintColors_[c] = kOverflowColor;
+                overflow_.push_back(static_cast<uint32_t>(c));
+                continue;
+            }
+            const int color = std::countr_one(used);
+            const uint64_t bit = uint64_t(1) << color;
+            if (mc.dynamicA) bodyColors_[mc.indexA] |= bit;
+            if (mc.dynamicB) bodyColors_[mc.indexB] |= bit;
+            constraintColors_[c] = static_cast<uint8_t>(color);
+            ++counts[color];
+            colorCount = std::max(colorCount, color + 1);
+        }
+
+        // Each color becomes ceil(count / kWidth) groups; the last one of a color may be partial.
+        colorGroups_.assign(colorCount + 1, 0);
+        std::array<uint32_t, kMaxColors> fill{};
+        for (int color = 0; color < colorCount; ++color) {
+            colorGroups_[color + 1] = colorGroups_[color] + (counts[color] + kWidth - 1) / kWidth;
+            fill[color] = colorGroups_[color] * kWidth;
+        }
+        groups_.resize(colorGroups_[colorCount]);
+        for (WideConstraint& wide : groups_) {
+            std::fill(std::begin(wide.constraint), std::end(wide.constraint), kPaddingLane);
+        }
+        for (size_t c = 0; c < constraints_.size(); ++c) {
+            const uint8_t color = constraintColors_[c];
+            if (color == kOverflowColor) continue;
+            const uint32_t slot = fill[color]++;
+            groups_[slot / kWidth].constraint[slot % kWidth] = static_cast<uint32_t>(c);
+        }
+    }
+
+    void ContactSolver::packGroup(WideConstraint& wide) const {
+        alignas(32) float lanes[kWidth];
+        auto pack = [&](auto get) {
+            for (int l = 0; l < kWidth; ++l) {
+                lanes[l] = wide.constraint[l] == kPaddingLane ? 0.0f : get(constraints_[wide.constraint[l]]);
+            }
+            return SimdFloat::load(lanes);
+        };
+        auto pack3 = [&](auto get) -> SimdVec3 {
+            return { pack([&](const ManifoldConstraint& mc) { return get(mc).x; }),
+                     pack([&](const ManifoldConstraint& mc) { return get(mc).y; }),
+                     pack([&](const ManifoldConstraint& mc) { return get(mc).z; }) };
+        };
+
+        const ManifoldConstraint& first = constraints_[wide.constraint[0]];
+        wide.pointCount = 0;
+        for (int l = 0; l < kWidth; ++l) {
+            const bool padding = wide.constraint[l] == kPaddingLane;
+            const ManifoldConstraint& mc = padding ? first : constraints_[wide.constraint[l]];
+            wide.indexA[l] = mc.indexA;
+            wide.indexB[l] = mc.indexB;
+            wide.writeA[l] = !padding && mc.dynamicA;
+            wide.writeB[l] = !padding && mc.dynamicB;
+            wide.pointCount = std::max(wide.pointCount, mc.pointCount);
+        }
+
+        wide.inverseMassA = pack([](const ManifoldConstraint& mc) { return mc.inverseMassA; });
+        wide.inverseMassB = pack([](const ManifoldConstraint& mc) { return mc.inverseMassB; });
+        static constexpr int kRow[6] = { 0, 1, 2, 0, 0, 1 };
+        static constexpr int kColumn[6] = { 0, 1, 2, 1, 2, 2 };
+        for (int k = 0; k < 6; ++k) {
+            wide.inverseInertiaA[k] = pack([&](const ManifoldConstraint& mc) { return mc.inverseInertiaA[kColumn[k]][kRow[k]]; });
+            wide.inverseInertiaB[k] = pack([&](const ManifoldConstraint& mc) { return mc.inverseInertiaB[kColumn[k]][kRow[k]]; });
+        }
+        wide.normal = pack3([](const ManifoldConstraint& mc) { return mc.normal; });
+        wide.tangents[0] = pack3([](const ManifoldConstraint& mc) { return mc.tangents[0]; });
+        wide.tangents[1] = pack3([](const ManifoldConstraint& mc) { return mc.tangents[1]; });
+        wide.friction = pack([](const ManifoldConstraint& mc) { return mc.friction; });
+
+        // Lanes with fewer points get zero-mass points, which never produce an impulse.
+        for (int p = 0; p < wide.pointCount; ++p) {
+            WidePoint& wp = wide.points[p];
+            auto point = [&](auto get) {
+                return pack([&](const ManifoldConstraint& mc) { return p < mc.pointCount ? get(mc.points[p]) : 0.0f; });
+            };
+            auto point3 = [&](auto get) -> SimdVec3 {
+                return { point([&](const PointConstraint& pc) { return get(pc).x; }),
+                         point([&](const PointConstraint& pc) { return get(pc).y; }),
+                         point([&](const PointConstraint& pc) { return get(pc).z; }) };
+            };
+            wp.rA = point3([](const PointConstraint& pc) { return pc.rA; });
+            wp.rB = point3([](const PointConstraint& pc) { return pc.rB; });
+            wp.normalMass = point([](const PointConstraint& pc) { return pc.normalMass; });
+            wp.bias = point([](const PointConstraint& pc) { return pc.bias; });
+            wp.normalImpulse = point([](const PointConstraint& pc) { return pc.normalImpulse; });
+            for (int t = 0; t < 2; ++t) {
+                wp.tangentMass[t] = point([&](const PointConstraint& pc) { return pc.tangentMass[t]; });
+                wp.tangentImpulse[t] = point([&](const PointConstraint& pc) { return pc.tangentImpulse[t]; });
+            }
+        }
+    }
+
+    template <bool WarmStart>
+    void ContactSolver::solveGroup(BodyStorage& bodies, WideConstraint& wide) {
+        SimdVec3 vA = gather(bodies.velocityX, bodies.velocityY, bodies.velocityZ, wide.indexA);
+        SimdVec3 wA = gather(bodies.angularVelocityX, bodies.angularVelocityY, bodies.angularVelocityZ, wide.indexA);
+        SimdVec3 vB = gather(bodies.velocityX, bodies.velocityY, bodies.velocityZ, wide.indexB);
+        SimdVec3 wB = gather(bodies.angularVelocityX, bodies.angularVelocityY, bodies.angularVelocityZ, wide.indexB);
+        auto apply = [&](const WidePoint& wp, const SimdVec3& impulse) {
+            vA -= impulse * wide.inverseMassA;
+            wA -= mulSymmetric(wide.inverseInertiaA, cross(wp.rA, impulse));
+            vB += impulse * wide.inverseMassB;
+            wB += mulSymmetric(wide.inverseInertiaB, cross(wp.rB, impulse));
+        };
+
+        if constexpr (WarmStart) {
+            for (int p = 0; p < wide.pointCount; ++p) {
+                const WidePoint& wp = wide.points[p];
+                apply(wp, wide.normal * wp.normalImpulse + wide.tangents[0] * wp.tangentImpulse[0] + wide.tangents[1] * wp.tangentImpulse[1]);
+            }
+        } else {
+            // Same order as the scalar path: friction first, then the normal pass.
+            for (int p = 0; p < wide.pointCount; ++p) {
+                WidePoint& wp = wide.points[p];
+                const SimdFloat limit = wide.friction * wp.normalImpulse;
+                const SimdFloat lower = SimdFloat::zero() - limit;
+                for (int t = 0; t < 2; ++t) {
+                    const SimdVec3 dv = vB + cross(wB, wp.rB) - vA - cross(wA, wp.rA);
+                    const SimdFloat lambda = SimdFloat::zero() - wp.tangentMass[t] * dot(dv, wide.tangents[t]);
+                    const SimdFloat previous = wp.tangentImpulse[t];
+                    wp.tangentImpulse[t] = min(max(previous + lambda, lower), limit);
+                    apply(wp, wide.tangents[t] * (wp.tangentImpulse[t] - previous));
+                }
+            }
+
+            for (int p = 0; p < wide.pointCount; ++p) {
+                WidePoint& wp = wide.points[p];
+                const SimdVec3 dv = vB + cross(wB, wp.rB) - vA - cross(wA, wp.rA);
+                const SimdFloat lambda = wp.normalMass * (wp.bias - dot(dv, wide.normal));
+                const SimdFloat previous = wp.normalImpulse;
+                wp.normalImpulse = max(previous + lambda, SimdFloat::zero());
+                apply(wp, wide.normal * (wp.normalImpulse - previous));
+            }
+        }
+
+        // Lanes of one group never share a dynamic body, so the scatter order doesn't matter.
+        scatter(bodies.velocityX, bodies.velocityY, bodies.velocityZ, wide.indexA, wide.writeA, vA);
+        scatter(bodies.angularVelocityX, bodies.angularVelocityY, bodies.angularVelocityZ, wide.indexA, wide.writeA, wA);
+        scatter(bodies.velocityX, bodies.velocityY, bodies.velocityZ, wide.indexB, wide.writeB, vB);
+        scatter(bodies.angularVelocityX, bodies.angularVelocityY, bodies.angularVelocityZ, wide.indexB, wide.writeB, wB);
+    }
+
+    void ContactSolver::warmStartScalar(BodyStorage& bodies, const ManifoldConstraint& mc) {
+        glm::vec3 vA = bodies.velocity(mc.indexA), wA = bodies.angularVelocity(mc.indexA);
+        glm::vec3 vB = bodies.velocity(mc.indexB), wB = bodies.angularVelocity(mc.indexB);
+        for (int p = 0; p < mc.pointCount; ++p) {
+            const PointConstraint& pc = mc.points[p];
+            const glm::vec3 impulse = mc.normal * pc.normalImpulse
+                                    + mc.tangents[0] * pc.tangentImpulse[0] + mc.tangents[1] * pc.tangentImpulse[1];
+            vA -= impulse * mc.inverseMassA;
+            wA -= mc.inverseInertiaA * glm::cross(pc.rA, impulse);
+            vB += impulse * mc.inverseMassB;
+            wB += mc.inverseInertiaB * glm::cross(pc.rB, impulse);
+        }
+        if (mc.dynamicA) {
+            bodies.setVelocity(mc.indexA, vA);
+            bodies.setAngularVelocity(mc.indexA, wA);
+        }
+        if (mc.dynamicB) {
+            bodies.setVelocity(mc.indexB, vB);
+            bodies.setAngularVelocity(mc.indexB, wB);
+        }
+    }
+
+    void ContactSolver::solveScalar(BodyStorage& bodies, ManifoldConstraint& mc) {
+        glm::vec3 vA = bodies.velocity(mc.indexA), wA = bodies.angularVelocity(mc.indexA);
+        glm::vec3 vB = bodies.velocity(mc.indexB), wB = bodies.angularVelocity(mc.indexB);
+        auto apply = [&](const PointConstraint& pc, const glm::vec3& impulse) {
+            vA -= impulse * mc.inverseMassA;
+            wA -= mc.inverseInertiaA * glm::cross(pc.rA, impulse);
+            vB += impulse * mc.inverseMassB;
+            wB += mc.inverseInertiaB * glm::cross(pc.rB, impulse);
+        };
+
+        // Friction first: its bound comes from the normal impulse, which the normal pass then refines.
+        for (int p = 0; p < mc.pointCount; ++p) {
+            PointConstraint& pc = mc.points[p];
+            const float limit = mc.friction * pc.normalImpulse;
+            for (int t = 0; t < 2; ++t) {
+                const glm::vec3 dv = vB + glm::cross(wB, pc.rB) - vA - glm::cross(wA, pc.rA);
+                const float lambda = -pc.tangentMass[t] * glm::dot(dv, mc.tangents[t]);
+                const float previous = pc.tangentImpulse[t];
+                pc.tangentImpulse[t] = std::clamp(previous + lambda, -limit, limit);
+                apply(pc, mc.tangents[t] * (pc.tangentImpulse[t] - previous));
+            }
+        }
+
+        for (int p = 0; p < mc.pointCount; ++p) {
+            PointConstraint& pc = mc.points[p];
+            const glm::vec3 dv = vB + glm::cross(wB, pc.rB) - vA - glm::cross(wA, pc.rA);
+            const float lambda = pc.normalMass * (pc.bias - glm::dot(dv, mc.normal));
+            const float previous = pc.normalImpulse;
+            pc.normalImpulse = std::max(previous + lambda, 0.0f);
+            apply(pc, mc.normal * (pc.normalImpulse - previous));
+        }
+
+        if (mc.dynamicA) {
+            bodies.setVelocity(mc.indexA, vA);
+            bodies.setAngularVelocity(mc.indexA, wA);
+        }
+        if (mc.dynamicB) {
+            bodies.setVelocity(mc.indexB, vB);
+            bodies.setAngularVelocity(mc.indexB, wB);
+        }
+    }
+
+    template <typename Fn>
+    void ContactSolver::forEachColor(Fn&& fn) {
+        // Colors are barriers: a color starts once every group of the previous one is done.
+        for (size_t color = 0; color + 1 < colorGroups_.size(); ++color) {
+            const size_t begin = colorGroups_[color];
+            utils::JobSystem::getInstance().parallelFor(colorGroups_[color + 1] - begin, [&](size_t g) {
+                fn(groups_[begin + g]);
+            }, kGroupsPerJob);
+        }
+    }
+
+    void ContactSolver::warmStart(BodyStorage& bodies) {
+        forEachColor([&](WideConstraint& wide) { solveGroup<true>(bodies, wide); });
+        for (uint32_t c : overflow_) warmStartScalar(bodies, constraints_[c]);
+    }
+
+    void ContactSolver::solveVelocities(BodyStorage& bodies) {
+        forEachColor([&](WideConstraint& wide) { solveGroup<false>(bodies, wide); });
+        for (uint32_t c : overflow_) solveScalar(bodies, constraints_[c]);
+    }
+
+    void ContactSolver::storeImpulses(std::vector<Contact>& contacts) const {
+        alignas(32) float normal[kWidth], tangent0[kWidth], tangent1[kWidth];
+        for (const WideConstraint& wide : groups_) {
+            for (int p = 0; p < wide.pointCount; ++p) {
+                const WidePoint& wp = wide.points[p];
+                wp.normalImpulse.store(normal);
+                wp.tangentImpulse[0].store(tangent0);
+                wp.tangentImpulse[1].store(tangent1);
+                for (int l = 0; l < kWidth; ++l) {
+                    if (wide.constraint[l] == kPaddingLane) continue;
+                    const ManifoldConstraint& mc = constraints_[wide.constraint[l]];
+                    if (p >= mc.pointCount) continue;
+                    ContactPoint& point = contacts[mc.contact].manifold.points[p];
+                    point.normalImpulse = normal[l];
+                    point.tangentImpulse[0] = tangent0[l];
+                    point.tangentImpulse[1] = tangent1[l];
+                }
+            }
+        }
+
+        for (uint32_t c : overflow_) {
+            const ManifoldConstraint& mc = constraints_[c];
+            ContactManifold& manifold = contacts[mc.contact].manifold;
+            for (int p = 0; p < mc.pointCount; ++p) {
+                const PointConstraint& pc = mc.points[p];
+                manifold.points[p].normalImpulse = pc.normalImpulse;
+                manifold.points[p].tangentImpulse[0] = pc.tangentImpulse[0];
+                manifold.points[p].tangentImpulse[1] = pc.tangentImpulse[1];
+            }
+        }
+    }
+
+} // namespace physics
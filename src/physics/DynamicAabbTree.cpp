@@ -0,0 +1,319 @@
+#include "physics/DynamicAabbTree.h"
+#include "utils/JobSystem.h"
+#include <algorithm>
+
+namespace physics {
+
+    DynamicAabbTree::DynamicAabbTree(float margin, float displacementMultiplier)
+        : margin_(margin), displacementMultiplier_(displacementMultiplier) {
+    }
+
+    uint32_t DynamicAabbTree::allocateNode() {
+        if (freeList_ == kNull) {
+            nodes_.emplace_back();
+            nodes_.back().height = 0;
+            return static_cast<uint32_t>(nodes_.size() - 1);
+        }
+        const uint32_t node = freeList_;
+        freeList_ = nodes_[node].parent;
+        nodes_[node] = Node{};
+        nodes_[node].height = 0;
+        return node;
+    }
+
+    void DynamicAabbTree::freeNode(uint32_t node) {
+        nodes_[node].parent = freeList_;
+        nodes_[node].height = -1;
+        freeList_ = node;
+    }
+
+    ProxyId DynamicAabbTree::createProxy(const Aabb& aabb, uint32_t userData) {
+        const uint32_t proxy = allocateNode();
+        nodes_[proxy].aabb = aabb.fattened(margin_);
+        nodes_[proxy].userData = userData;
+        nodes_[proxy].moved = true;
+        insertLeaf(proxy);
+        moveBuffer_.push_back(proxy);
+        ++proxyCount_;
+        return proxy;
+    }
+
+    void DynamicAabbTree::destroyProxy(ProxyId proxy) {
+        if (proxy >= nodes_.size() || !nodes_[proxy].isLeaf() || nodes_[proxy].height < 0) return;
+        if (nodes_[proxy].moved) {
+            std::replace(moveBuffer_.begin(), moveBuffer_.end(), proxy, kNull);
+        }
+        removeLeaf(proxy);
+        freeNode(proxy);
+        --proxyCount_;
+    }
+
+    void DynamicAabbTree::moveProxy(ProxyId proxy, const Aabb& aabb, const glm::vec3& displacement) {
+        Node& node = nodes_[proxy];
+
+        // Predict motion: stretch the fat box along this step's displacement.
+        Aabb fat = aabb.fattened(margin_);
+        const glm::vec3 d = displacement * displacementMultiplier_;
+        for (int axis = 0; axis < 3; ++axis) {
+            if (d[axis] < 0.0f) fat.min[axis] += d[axis];
+            else fat.max[axis] += d[axis];
+        }
+
+        // Still inside its fat box and the box isn't grossly oversized: nothing to do.
+        if (node.aabb.contains(aabb)) {
+            const Aabb huge = fat.fattened(4.0f * margin_);
+            if (huge.contains(node.aabb)) return;
+        }
+
+        removeLeaf(proxy);
+        nodes_[proxy].aabb = fat;
+        insertLeaf(proxy);
+        if (!nodes_[proxy].moved) {
+            nodes_[proxy].moved = true;
+            moveBuffer_.push_back(proxy);
+        }
+    }
+
+    void DynamicAabbTree::insertLeaf(uint32_t leaf) {
+        if (root_ == kNull) {
+            root_ = leaf;
+            nodes_[leaf].parent = kNull;
+            return;
+        }
+
+        // Descend towards the cheapest sibling by the surface-area heuristic.
+        const Aabb leafAabb = nodes_[leaf].aabb;
+        uint32_t index = root_;
+        while (!nodes_[index].isLeaf()) {
+            const Node& node = nodes_[index];
+            const float area = node.aabb.area();
+            const float combinedArea = Aabb::merge(node.aabb, leafAabb).area();
+            const float cost = 2.0f * combinedArea;
+            const float inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto descendCost = [&](uint32_t child) {
+                const Aabb merged = Aabb::merge(leafAabb, nodes_[child].aabb);
+                const float growth = nodes_[child].isLeaf() ? merged.area() : merged.area() - nodes_[child].aabb.area();
+                return growth + inheritanceCost;
+            };
+            const float cost1 = descendCost(node.child1);
+            const float cost2 = descendCost(node.child2);
+
+            if (cost < cost1 && cost < cost2) break;
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        const uint32_t sibling = index;
+        const uint32_t oldParent = nodes_[sibling].parent;
+        const uint32_t newParent = allocateNode();
+        nodes_[newParent].parent = oldParent;
+        nodes_[newParent].aabb = Aabb::merge(leafAabb, nodes_[sibling].aabb);
+        nodes_[newParent].height = nodes_[sibling].height + 1;
+        nodes_[newParent].child1 = sibling;
+        nodes_[newParent].child2 = leaf;
+        nodes_[sibling].parent = newParent;
+        nodes_[leaf].parent = newParent;
+
+        if (oldParent == kNull) {
+            root_ = newParent;
+        }
+        else if (nodes_[oldParent].child1 == sibling) {
+            nodes_[oldParent].child1 = newParent;
+        }
+        else {
+            nodes_[oldParent].child2 = newParent;
+        }
+
+        refitUpwards(nodes_[leaf].parent);
+    }
+
+    void DynamicAabbTree::removeLeaf(uint32_t leaf) {
+        if (leaf == root_) {
+            root_ = kNull;
+            return;
+        }
+
+        const uint32_t parent = nodes_[leaf].parent;
+        const uint32_t grandParent = nodes_[parent].parent;
+        const uint32_t sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+        if (grandParent == kNull) {
+            root_ = sibling;
+            nodes_[sibling].parent = kNull;
+            freeNode(parent);
+            return;
+        }
+
+        if (nodes_[grandParent].child1 == parent) nodes_[grandParent].child1 = sibling;
+        else nodes_[grandParent].child2 = sibling;
+        nodes_[sibling].parent = grandParent;
+        freeNode(parent);
+        refitUpwards(grandParent);
+    }
+
+    void DynamicAabbTree::refitUpwards(uint32_t index) {
+        while (index != kNull) {
+            index = balance(index);
+            Node& node = nodes_[index];
+            node.height = 1 + std::max(nodes_[node.child1].height, nodes_[node.child2].height);
+            node.aabb = Aabb::merge(nodes_[node.child1].aabb, nodes_[node.child2].aabb);
+            index = node.parent;
+        }
+    }
+
+    // Rotates the taller grandchild up when A's subtrees differ in height by more than one.
+    // Returns the index now at A's position.
+    uint32_t DynamicAabbTree::balance(uint32_t iA) {
+        Node& A = nodes_[iA];
+        if (A.isLeaf() || A.height < 2) return iA;
+
+        const uint32_t iB = A.child1;
+        const uint32_t iC = A.child2;
+        const int32_t heightDelta = nodes_[iC].height - nodes_[iB].height;
+
+        auto rotateUp = [&](uint32_t iUp, uint32_t iOther, bool upIsChild2) {
+            Node& up = nodes_[iUp];
+            const uint32_t iF = up.child1;
+            const uint32_t iG = up.child2;
+
+            // Up replaces A under A's old parent; A becomes a child of Up.
+            up.child1 = iA;
+            up.parent = A.parent;
+            A.parent = iUp;
+            if (up.parent != kNull) {
+                if (nodes_[up.parent].child1 == iA) nodes_[up.parent].child1 = iUp;
+                else nodes_[up.parent].child2 = iUp;
+            }
+            else {
+                root_ = iUp;
+            }
+
+            // Keep the taller grandchild under Up; the shorter one takes Up's old slot in A.
+            const bool keepF = nodes_[iF].height > nodes_[iG].height;
+            const uint32_t iKeep = keepF ? iF : iG;
+            const uint32_t iMove = keepF ? iG : iF;
+            up.child2 = iKeep;
+            if (upIsChild2) A.child2 = iMove;
+            else A.child1 = iMove;
+            nodes_[iMove].parent = iA;
+
+            A.aabb = Aabb::merge(nodes_[iOther].aabb, nodes_[iMove].aabb);
+            up.aabb = Aabb::merge(A.aabb, nodes_[iKeep].aabb);
+            A.height = 1 + std::max(nodes_[iOther].height, nodes_[iMove].height);
+            up.height = 1 + std::max(A.height, nodes_[iKeep].height);
+            return iUp;
+        };
+
+        if (heightDelta > 1) return rotateUp(iC, iB, true);
+        if (heightDelta < -1) return rotateUp(iB, iC, false);
+        return iA;
+    }
+
+    template <typename Visitor>
+    void DynamicAabbTree::query(const Aabb& aabb, Visitor&& visitor) const {
+        if (root_ == kNull) return;
+        uint32_t stackStorage[128];
+        std::vector<uint32_t> overflow;
+        size_t top = 0;
+        auto push = [&](uint32_t node) {
+            if (top < 128) stackStorage[top++] = node;
+            else overflow.push_back(node);
+        };
+        push(root_);
+        while (top > 0 || !overflow.empty()) {
+            uint32_t index;
+            if (!overflow.empty()) {
+                index = overflow.back();
+                overflow.pop_back();
+            }
+            else {
+                index = stackStorage[--top];
+            }
+            const Node& node = nodes_[index];
+            if (!node.aabb.overlaps(aabb)) continue;
+            if (node.isLeaf()) {
+                if (!visitor(index)) return;
+            }
+            else {
+                push(node.child1);
+                push(node.child2);
+            }
+        }
+    }
+
+    void DynamicAabbTree::findPairs(std::vector<BroadphasePair>& pairs) {
+        pairs.clear();
+        moveBuffer_.erase(std::remove(moveBuffer_.begin(), moveBuffer_.end(), kNull), moveBuffer_.end());
+        if (moveBuffer_.empty()) return;
+
+        // Each chunk of moved proxies queries the (read-only) tree into its own buffer.
+        constexpr size_t kChunk = 64;
+        const size_t chunks = (moveBuffer_.size() + kChunk - 1) / kChunk;
+        if (chunkPairs_.size() < chunks) chunkPairs_.resize(chunks);
+
+        utils::JobSystem::getInstance().parallelFor(chunks, [&](size_t chunk) {
+            std::vector<BroadphasePair>& out = chunkPairs_[chunk];
+            out.clear();
+            const size_t end = std::min(moveBuffer_.size(), (chunk + 1) * kChunk);
+            for (size_t m = chunk * kChunk; m < end; ++m) {
+                const ProxyId queryProxy = moveBuffer_[m];
+                const uint32_t queryUser = nodes_[queryProxy].userData;
+                query(nodes_[queryProxy].aabb, [&](uint32_t other) {
+                    // Two moved proxies find each other twice; only the lower id reports.
+                    if (other == queryProxy || (nodes_[other].moved && other < queryProxy)) return true;
+                    const uint32_t otherUser = nodes_[other].userData;
+                    out.push_back({ std::min(queryUser, otherUser), std::max(queryUser, otherUser) });
+                    return true;
+                });
+            }
+        });
+
+        size_t total = 0;
+        for (size_t c = 0; c < chunks; ++c) total += chunkPairs_[c].size();
+        pairs.reserve(total);
+        for (size_t c = 0; c < chunks; ++c) {
+            pairs.insert(pairs.end(), chunkPairs_[c].begin(), chunkPairs_[c].end());
+        }
+        std::sort(pairs.begin(), pairs.end());
+        pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+        for (ProxyId proxy : moveBuffer_) nodes_[proxy].moved = false;
+        moveBuffer_.clear();
+    }
+
+    void DynamicAabbTree::queryAabb(const Aabb& aabb, const std::function<bool(uint32_t)>& visitor) const {
+        query(aabb, [&](uint32_t leaf) { return visitor(nodes_[leaf].userData); });
+    }
+
+    void DynamicAabbTree::rayCast(const glm::vec3& origin, const glm::vec3& direction, float maxT,
+                                  const std::function<float(uint32_t, float)>& visitor) const {
+        if (root_ == kNull) return;
+        std::vector<uint32_t> stack{ root_ };
+        while (!stack.empty()) {
+            const uint32_t index = stack.back();
+            stack.pop_back();
+            const Node& node = nodes_[index];
+            if (node.aabb.rayCast(origin, direction, maxT) < 0.0f) continue;
+            if (node.isLeaf()) {
+                const float value = visitor(node.userData, maxT);
+                if (value == 0.0f) return;
+                if (value > 0.0f) maxT = std::min(maxT, value);
+            }
+            else {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+        }
+    }
+
+    float DynamicAabbTree::getAreaRatio() const {
+        if (root_ == kNull) return 0.0f;
+        float total = 0.0f;
+        for (const Node& node : nodes_) {
+            if (node.height >= 0) total += node.aabb.area();
+        }
+        const float rootArea = nodes_[root_].aabb.area();
+        return rootArea > 0.0f ? total / rootArea : 0.0f;
+    }
+
+} // namespace physics
@@ -0,0 +1,494 @@
+#include "physics/FluidSystem.h"
+#include "physics/MortonOrder.h"
+#include "physics/PhysicsWorld.h"
+#include "physics/SimdFloat.h"
+#include "utils/JobSystem.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+
+namespace physics {
+
+    namespace {
+        constexpr size_t kChunkSize = 1024;
+        constexpr float kPi = 3.14159265358979f;
+        // Reference distance of the artificial pressure, as a fraction of h; the exponent is 4.
+        constexpr float kTensileDistance = 0.2f;
+
+        // Neighbour data of one block of SimdFloat::kWidth neighbours. Lanes past the end of the
+        // list sit two kernel radii away, where every kernel is zero.
+        struct NeighborBlock {
+            static constexpr int W = SimdFloat::kWidth;
+            alignas(32) float x[W], y[W], z[W], a[W];
+
+            void gather(const uint32_t* indices, int count, const float* px, const float* py, const float* pz,
+                        const float* attribute, const glm::vec3& far, float farAttribute) {
+                for (int lane = 0; lane < count; ++lane) {
+                    const uint32_t j = indices[lane];
+                    x[lane] = px[j];
+                    y[lane] = py[j];
+                    z[lane] = pz[j];
+                    a[lane] = attribute ? attribute[j] : 0.0f;
+                }
+                for (int lane = count; lane < W; ++lane) {
+                    x[lane] = far.x;
+                    y[lane] = far.y;
+                    z[lane] = far.z;
+                    a[lane] = farAttribute;
+                }
+            }
+        };
+    }
+
+    FluidSystem::FluidSystem(const FluidSettings& settings) {
+        setSettings(settings);
+    }
+
+    void FluidSystem::setSettings(const FluidSettings& settings) {
+        settings_ = settings;
+        settings_.particleRadius = std::max(settings_.particleRadius, 1e-4f);
+        settings_.restDensity = std::max(settings_.restDensity, 1e-3f);
+        settings_.iterations = std::max(settings_.iterations, 1u);
+        settings_.viscosity = std::clamp(settings_.viscosity, 0.0f, 1.0f);
+        settings_.relaxation = std::max(settings_.relaxation, 1e-6f);
+        settings_.reorderInterval = std::max(settings_.reorderInterval, 1u);
+
+        const float h = 4.0f * settings_.particleRadius;
+        const float h2 = h * h;
+        kernelRadius_ = h;
+        poly6_ = 315.0f / (64.0f * kPi * std::pow(h, 9.0f));
+        spikyGradient_ = -45.0f / (kPi * std::pow(h, 6.0f));
+        tensileReference_ = 1.0f / (h2 - kTensileDistance * kTensileDistance * h2);
+        grid_.setCellSize(h);
+
+        // Calibrate against a particle inside a cubic lattice at rest spacing: its mass makes the
+        // lattice exactly rest density, and its constraint gradient sets the softening scale.
+        const float spacing = 2.0f * settings_.particleRadius;
+        float densitySum = 0.0f, gradientSum = 0.0f;
+        for (int i = -2; i <= 2; ++i) {
+            for (int j = -2; j <= 2; ++j) {
+                for (int k = -2; k <= 2; ++k) {
+                    const float r = spacing * std::sqrt(static_cast<float>(i * i + j * j + k * k));
+                    if (r >= h) continue;
+                    densitySum += poly6_ * std::pow(h2 - r * r, 3.0f);
+                    const float gradient = spikyGradient_ * (h - r) * (h - r);
+                    if (r > 0.0f) gradientSum += gradient * gradient;
+                }
+            }
+        }
+        mass_ = settings_.restDensity / densitySum;
+        const float volume = mass_ / settings_.restDensity;
+        restGradient_ = volume * volume * gradientSum;
+    }
+
+    uint32_t FluidSystem::addParticle(const glm::vec3& position, const glm::vec3& velocity) {
+        x_.push_back(position.x);
+        y_.push_back(position.y);
+        z_.push_back(position.z);
+        vx_.push_back(velocity.x);
+        vy_.push_back(velocity.y);
+        vz_.push_back(velocity.z);
+        density_.push_back(settings_.restDensity);
+        ids_.push_back(nextId_);
+        return nextId_++;
+    }
+
+    size_t FluidSystem::addBlock(const Aabb& region, const glm::vec3& velocity) {
+        const float spacing = 2.0f * settings_.particleRadius;
+        const glm::vec3 first = region.min + glm::vec3(settings_.particleRadius);
+        const glm::ivec3 count = glm::max(glm::ivec3(glm::floor((region.max - first) / spacing)) + glm::ivec3(1), glm::ivec3(0));
+        if (count.x == 0 || count.y == 0 || count.z == 0) {
+            spdlog::warn("FluidSystem: Region is smaller than one particle");
+            return 0;
+        }
+        const size_t total = static_cast<size_t>(count.x) * count.y * count.z;
+        for (auto* column : { &x_, &y_, &z_, &vx_, &vy_, &vz_, &density_ }) column->reserve(column->size() + total);
+        ids_.reserve(ids_.size() + total);
+        for (int k = 0; k < count.z; ++k) {
+            for (int j = 0; j < count.y; ++j) {
+                for (int i = 0; i < count.x; ++i) addParticle(first + glm::vec3(i, j, k) * spacing, velocity);
+            }
+        }
+        return total;
+    }
+
+    void FluidSystem::clear() {
+        for (auto* column : { &x_, &y_, &z_, &vx_, &vy_, &vz_, &density_ }) column->clear();
+        ids_.clear();
+        neighborStart_.clear();
+        neighbors_.clear();
+        contacts_.clear();
+        stepsSinceReorder_ = 0;
+    }
+
+    template <typename Kernel>
+    void FluidSystem::forEachChunk(Kernel&& kernel) {
+        const size_t count = size();
+        const size_t chunks = (count + kChunkSize - 1) / kChunkSize;
+        utils::JobSystem::getInstance().parallelFor(chunks, [&](size_t chunk) {
+            const size_t begin = chunk * kChunkSize;
+            kernel(begin, std::min(begin + kChunkSize, count));
+        });
+    }
+
+    void FluidSystem::step(float dt, PhysicsWorld* world) {
+        const size_t count = size();
+        if (count == 0 || dt <= 0.0f) return;
+        for (auto* column : { &px_, &py_, &pz_, &lambda_, &dx_, &dy_, &dz_ }) column->resize(count);
+
+        if (stepsSinceReorder_ == 0) reorder();
+        stepsSinceReorder_ = (stepsSinceReorder_ + 1) % settings_.reorderInterval;
+
+        const glm::vec3 dv = settings_.gravity * dt;
+        forEachChunk([&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                vx_[i] += dv.x;
+                vy_[i] += dv.y;
+                vz_[i] += dv.z;
+                px_[i] = x_[i] + vx_[i] * dt;
+                py_[i] = y_[i] + vy_[i] * dt;
+                pz_[i] = z_[i] + vz_[i] * dt;
+            }
+        });
+
+        findNeighbors();
+        colliders_.clear();
+        contacts_.clear();
+        contactGroups_.clear();
+        if (world) gatherColliders(*world);
+
+        for (uint32_t iteration = 0; iteration < settings_.iterations; ++iteration) {
+            solveDensity();
+            applyDelta();
+            collide();
+        }
+
+        const float inverseDt = 1.0f / dt;
+        forEachChunk([&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                vx_[i] = (px_[i] - x_[i]) * inverseDt;
+                vy_[i] = (py_[i] - y_[i]) * inverseDt;
+                vz_[i] = (pz_[i] - z_[i]) * inverseDt;
+                x_[i] = px_[i];
+                y_[i] = py_[i];
+                z_[i] = pz_[i];
+            }
+        });
+
+        if (settings_.viscosity > 0.0f) applyViscosity();
+        if (world && !contacts_.empty()) applyCouplingForces(*world, dt);
+    }
+
+    void FluidSystem::reorder() {
+        const size_t count = size();
+        codes_.resize(count);
+        computeMortonCodes(x_.data(), y_.data(), z_.data(), count, settings_.bounds, codes_.data());
+        sortMortonCodes(codes_, order_);
+
+        // Gather each column through the scratch columns, which are free at this point.
+        const auto permute = [&](AlignedVector<float>& column, AlignedVector<float>& scratch) {
+            forEachChunk([&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) scratch[i] = column[order_[i]];
+            });
+            column.swap(scratch);
+        };
+        permute(x_, px_);
+        permute(y_, py_);
+        permute(z_, pz_);
+        permute(vx_, dx_);
+        permute(vy_, dy_);
+        permute(vz_, dz_);
+        AlignedVector<uint32_t> ids(count);
+        for (size_t i = 0; i < count; ++i) ids[i] = ids_[order_[i]];
+        ids_.swap(ids);
+    }
+
+    void FluidSystem::findNeighbors() {
+        const size_t count = size();
+        const float h2 = kernelRadius_ * kernelRadius_;
+        grid_.build(px_.data(), py_.data(), pz_.data(), count);
+        neighborStart_.assign(count + 1, 0);
+
+        // One grid walk into per-chunk lists, then a copy into the flat array once the offsets
+        // are known. The chunk lists keep their capacity from step to step.
+        const size_t chunks = (count + kChunkSize - 1) / kChunkSize;
+        if (chunkNeighbors_.size() < chunks) chunkNeighbors_.resize(chunks);
+        forEachChunk([&](size_t begin, size_t end) {
+            std::vector<uint32_t>& list = chunkNeighbors_[begin / kChunkSize];
+            list.clear();
+            for (size_t i = begin; i < end; ++i) {
+                const glm::vec3 p(px_[i], py_[i], pz_[i]);
+                const size_t first = list.size();
+                grid_.forEachNeighbor(p, [&](uint32_t j) {
+                    const glm::vec3 d = p - glm::vec3(px_[j], py_[j], pz_[j]);
+                    if (j != i && glm::dot(d, d) < h2) list.push_back(j);
+                });
+                // Bucket order depends on thread timing; sorted lists keep the sums reproducible
+                // and walk memory forwards.
+                std::sort(list.begin() + static_cast<std::ptrdiff_t>(first), list.end());
+                neighborStart_[i + 1] = static_cast<uint32_t>(list.size() - first);
+            }
+        });
+        for (size_t i = 0; i < count; ++i) neighborStart_[i + 1] += neighborStart_[i];
+        neighbors_.resize(neighborStart_[count]);
+        utils::JobSystem::getInstance().parallelFor(chunks, [&](size_t chunk) {
+            const std::vector<uint32_t>& list = chunkNeighbors_[chunk];
+            std::copy(list.begin(), list.end(), neighbors_.begin() + neighborStart_[chunk * kChunkSize]);
+        });
+    }
+
+    void FluidSystem::gatherColliders(PhysicsWorld& world) {
+        const size_t count = size();
+        const size_t chunks = (count + kChunkSize - 1) / kChunkSize;
+        std::vector<Aabb> chunkBounds(chunks);
+        forEachChunk([&](size_t begin, size_t end) {
+            Aabb bounds{ glm::vec3(px_[begin], py_[begin], pz_[begin]), glm::vec3(px_[begin], py_[begin], pz_[begin]) };
+            for (size_t i = begin + 1; i < end; ++i) {
+                const glm::vec3 p(px_[i], py_[i], pz_[i]);
+                bounds = { glm::min(bounds.min, p), glm::max(bounds.max, p) };
+            }
+            chunkBounds[begin / kChunkSize] = bounds;
+        });
+        Aabb fluidBounds = chunkBounds[0];
+        for (const Aabb& bounds : chunkBounds) fluidBounds = Aabb::merge(fluidBounds, bounds);
+        fluidBounds = fluidBounds.fattened(kernelRadius_);
+
+        const BodyStorage& bodies = world.getBodies();
+        world.queryAabb(fluidBounds, [&](BodyHandle handle) {
+            const auto index = world.indexOf(handle);
+            if (!index) return true;
+            const uint32_t flags = bodies.flags[*index];
+            colliders_.push_back({ &bodies.shapes[*index], bodies.position(*index), bodies.orientation(*index),
+                                   static_cast<uint32_t>(*index), (flags & (kBodyStatic | kBodyKinematic)) == 0 });
+            return true;
+        });
+
+        // Candidate particles of each collider: through the grid cells its bounds cover, or a
+        // plain scan when that region has more cells than there are particles.
+        for (uint32_t c = 0; c < colliders_.size(); ++c) {
+            const Collider& collider = colliders_[c];
+            const Aabb shapeBounds = collider.shape->computeAabb(collider.position, collider.orientation).fattened(kernelRadius_);
+            if (!shapeBounds.overlaps(fluidBounds)) continue;
+            const Aabb region{ glm::max(shapeBounds.min, fluidBounds.min), glm::min(shapeBounds.max, fluidBounds.max) };
+
+            const SpatialHashGrid::Cell first = grid_.cellOf(region.min);
+            const SpatialHashGrid::Cell last = grid_.cellOf(region.max);
+            const double cells = double(last.x - first.x + 1) * double(last.y - first.y + 1) * double(last.z - first.z + 1);
+            const auto consider = [&](uint32_t i) {
+                if (region.contains(glm::vec3(px_[i], py_[i], pz_[i]))) contacts_.push_back({ i, c, glm::vec3(0.0f) });
+            };
+            if (cells > static_cast<double>(count)) {
+                for (uint32_t i = 0; i < count; ++i) consider(i);
+                continue;
+            }
+            for (int32_t z = first.z; z <= last.z; ++z) {
+                for (int32_t y = first.y; y <= last.y; ++y) {
+                    for (int32_t x = first.x; x <= last.x; ++x) {
+                        // Buckets are shared between cells; keep only the points of this one.
+                        grid_.forEachInCell({ x, y, z }, [&](uint32_t i) {
+                            const SpatialHashGrid::Cell own = grid_.cellOf(glm::vec3(px_[i], py_[i], pz_[i]));
+                            if (own.x == x && own.y == y && own.z == z) consider(i);
+                        });
+                    }
+                }
+            }
+        }
+
+        std::sort(contacts_.begin(), contacts_.end(), [](const Contact& a, const Contact& b) {
+            return a.particle != b.particle ? a.particle < b.particle : a.collider < b.collider;
+        });
+        for (uint32_t k = 0; k < contacts_.size(); ++k) {
+            if (k == 0 || contacts_[k].particle != contacts_[k - 1].particle) contactGroups_.push_back(k);
+        }
+        contactGroups_.push_back(static_cast<uint32_t>(contacts_.size()));
+    }
+
+    void FluidSystem::solveDensity() {
+        constexpr int W = SimdFloat::kWidth;
+        const float h = kernelRadius_;
+        const float h2 = h * h;
+        const float volume = mass_ / settings_.restDensity;
+        const float epsilon = settings_.relaxation * restGradient_;
+        const SimdFloat zero = SimdFloat::zero();
+        const SimdFloat vh = SimdFloat::splat(h);
+        const SimdFloat vh2 = SimdFloat::splat(h2);
+        const SimdFloat tiny = SimdFloat::splat(1e-12f * h2);
+
+        // Density and the constraint multiplier of every particle.
+        forEachChunk([&](size_t begin, size_t end) {
+            NeighborBlock block;
+            for (size_t i = begin; i < end; ++i) {
+                const glm::vec3 p(px_[i], py_[i], pz_[i]);
+                const glm::vec3 far = p + glm::vec3(2.0f * h, 0.0f, 0.0f);
+                const SimdVec3 pi{ SimdFloat::splat(p.x), SimdFloat::splat(p.y), SimdFloat::splat(p.z) };
+                SimdFloat density = zero, squares = zero;
+                SimdVec3 gradient{ zero, zero, zero };
+                for (uint32_t k = neighborStart_[i]; k < neighborStart_[i + 1]; k += W) {
+                    const int lanes = static_cast<int>(std::min<uint32_t>(W, neighborStart_[i + 1] - k));
+                    block.gather(neighbors_.data() + k, lanes, px_.data(), py_.data(), pz_.data(), nullptr, far, 0.0f);
+                    const SimdVec3 d = pi - SimdVec3{ SimdFloat::load(block.x), SimdFloat::load(block.y), SimdFloat::load(block.z) };
+                    const SimdFloat r2 = dot(d, d);
+                    const SimdFloat t = max(vh2 - r2, zero);
+                    density += t * t * t;
+                    const SimdFloat r = sqrt(max(r2, tiny));
+                    const SimdFloat q = max(vh - r, zero);
+                    const SimdFloat q2 = q * q;
+                    squares += q2 * q2;
+                    gradient += d * (q2 / r);
+                }
+                const float rho = mass_ * poly6_ * (density.sum() + h2 * h2 * h2);
+                density_[i] = rho;
+                // Only compression is corrected; a free surface below rest density stays put.
+                const float constraint = std::max(rho / settings_.restDensity - 1.0f, 0.0f);
+                const float scale = volume * spikyGradient_;
+                const glm::vec3 gradientI = glm::vec3(gradient.x.sum(), gradient.y.sum(), gradient.z.sum()) * scale;
+                const float norms = scale * scale * squares.sum() + glm::dot(gradientI, gradientI);
+                lambda_[i] = -constraint / (norms + epsilon);
+            }
+        });
+
+        // Position corrections from the multipliers of both sides of every pair.
+        // Multipliers are constraint errors over restGradient_; the artificial pressure is scaled
+        // to match, so its strength doesn't depend on particle size or rest density.
+        const SimdFloat tensileScale = SimdFloat::splat(tensileReference_);
+        const SimdFloat tensile = SimdFloat::splat(-settings_.tensileStrength / restGradient_);
+        forEachChunk([&](size_t begin, size_t end) {
+            NeighborBlock block;
+            for (size_t i = begin; i < end; ++i) {
+                const glm::vec3 p(px_[i], py_[i], pz_[i]);
+                const glm::vec3 far = p + glm::vec3(2.0f * h, 0.0f, 0.0f);
+                const SimdVec3 pi{ SimdFloat::splat(p.x), SimdFloat::splat(p.y), SimdFloat::splat(p.z) };
+                const SimdFloat lambdaI = SimdFloat::splat(lambda_[i]);
+                SimdVec3 delta{ zero, zero, zero };
+                for (uint32_t k = neighborStart_[i]; k < neighborStart_[i + 1]; k += W) {
+                    const int lanes = static_cast<int>(std::min<uint32_t>(W, neighborStart_[i + 1] - k));
+                    block.gather(neighbors_.data() + k, lanes, px_.data(), py_.data(), pz_.data(), lambda_.data(), far, 0.0f);
+                    const SimdVec3 d = pi - SimdVec3{ SimdFloat::load(block.x), SimdFloat::load(block.y), SimdFloat::load(block.z) };
+                    const SimdFloat r2 = dot(d, d);
+                    const SimdFloat r = sqrt(max(r2, tiny));
+                    const SimdFloat q = max(vh - r, zero);
+                    // s_corr = -k (W(r) / W(0.2 h))^4, the poly6 ratio being ((h^2 - r^2) / (h^2 - (0.2 h)^2))^3.
+                    const SimdFloat t = max(vh2 - r2, zero) * tensileScale;
+                    const SimdFloat ratio = t * t * t;
+                    const SimdFloat ratio2 = ratio * ratio;
+                    const SimdFloat weight = lambdaI + SimdFloat::load(block.a) + tensile * ratio2 * ratio2;
+                    delta += d * (weight * q * q / r);
+                }
+                const float scale = volume * spikyGradient_;
+                dx_[i] = delta.x.sum() * scale;
+                dy_[i] = delta.y.sum() * scale;
+                dz_[i] = delta.z.sum() * scale;
+            }
+        });
+    }
+
+    void FluidSystem::applyDelta() {
+        // Nearly coincident particles (stacked in a corner, say) can ask for huge corrections;
+        // moving further than a particle radius per iteration only launches them.
+        const float limit2 = settings_.particleRadius * settings_.particleRadius;
+        forEachChunk([&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const float length2 = dx_[i] * dx_[i] + dy_[i] * dy_[i] + dz_[i] * dz_[i];
+                const float scale = length2 > limit2 ? std::sqrt(limit2 / length2) : 1.0f;
+                px_[i] += dx_[i] * scale;
+                py_[i] += dy_[i] * scale;
+                pz_[i] += dz_[i] * scale;
+            }
+        });
+    }
+
+    void FluidSystem::collide() {
+        const float radius = settings_.particleRadius;
+        const glm::vec3 low = settings_.bounds.min + glm::vec3(radius);
+        const glm::vec3 high = glm::max(settings_.bounds.max - glm::vec3(radius), low);
+        forEachChunk([&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                px_[i] = std::clamp(px_[i], low.x, high.x);
+                py_[i] = std::clamp(py_[i], low.y, high.y);
+                pz_[i] = std::clamp(pz_[i], low.z, high.z);
+            }
+        });
+        if (contacts_.empty()) return;
+
+        // One job item per particle run, so a particle is only ever moved by one thread.
+        const size_t groups = contactGroups_.size() - 1;
+        utils::JobSystem::getInstance().parallelFor(groups, [&](size_t group) {
+            for (uint32_t k = contactGroups_[group]; k < contactGroups_[group + 1]; ++k) {
+                Contact& contact = contacts_[k];
+                const Collider& collider = colliders_[contact.collider];
+                const uint32_t i = contact.particle;
+                const glm::vec3 p(px_[i], py_[i], pz_[i]);
+                glm::vec3 normal;
+                const float distance = collider.shape->signedDistance(glm::conjugate(collider.orientation) * (p - collider.position), normal);
+                if (distance >= radius) continue;
+                const glm::vec3 push = collider.orientation * normal * (radius - distance);
+                px_[i] += push.x;
+                py_[i] += push.y;
+                pz_[i] += push.z;
+                contact.push += push;
+            }
+        }, 64);
+    }
+
+    void FluidSystem::applyViscosity() {
+        constexpr int W = SimdFloat::kWidth;
+        const float h = kernelRadius_;
+        const SimdFloat zero = SimdFloat::zero();
+        const SimdFloat vh2 = SimdFloat::splat(h * h);
+        const float scale = settings_.viscosity * mass_ * poly6_;
+
+        // XSPH: blend each velocity towards the kernel-weighted average of its neighbours'.
+        // Results go to the correction columns first so every particle reads the old velocities.
+        forEachChunk([&](size_t begin, size_t end) {
+            NeighborBlock position, velocity;
+            for (size_t i = begin; i < end; ++i) {
+                const glm::vec3 p(x_[i], y_[i], z_[i]);
+                const glm::vec3 far = p + glm::vec3(2.0f * h, 0.0f, 0.0f);
+                const SimdVec3 pi{ SimdFloat::splat(p.x), SimdFloat::splat(p.y), SimdFloat::splat(p.z) };
+                const SimdVec3 vi{ SimdFloat::splat(vx_[i]), SimdFloat::splat(vy_[i]), SimdFloat::splat(vz_[i]) };
+                SimdVec3 sum{ zero, zero, zero };
+                for (uint32_t k = neighborStart_[i]; k < neighborStart_[i + 1]; k += W) {
+                    const int lanes = static_cast<int>(std::min<uint32_t>(W, neighborStart_[i + 1] - k));
+                    const uint32_t* indices = neighbors_.data() + k;
+                    position.gather(indices, lanes, x_.data(), y_.data(), z_.data(), density_.data(), far, 1.0f);
+                    velocity.gather(indices, lanes, vx_.data(), vy_.data(), vz_.data(), nullptr, glm::vec3(0.0f), 0.0f);
+                    const SimdVec3 d = pi - SimdVec3{ SimdFloat::load(position.x), SimdFloat::load(position.y), SimdFloat::load(position.z) };
+                    const SimdFloat t = max(vh2 - dot(d, d), zero);
+                    const SimdVec3 vj{ SimdFloat::load(velocity.x), SimdFloat::load(velocity.y), SimdFloat::load(velocity.z) };
+                    sum += (vj - vi) * (t * t * t / SimdFloat::load(position.a));
+                }
+                dx_[i] = vx_[i] + scale * sum.x.sum();
+                dy_[i] = vy_[i] + scale * sum.y.sum();
+                dz_[i] = vz_[i] + scale * sum.z.sum();
+            }
+        });
+        vx_.swap(dx_);
+        vy_.swap(dy_);
+        vz_.swap(dz_);
+    }
+
+    void FluidSystem::applyCouplingForces(PhysicsWorld& world, float dt) {
+        // Pushing a particle by `push` gave it momentum mass * push / dt within this step; the
+        // body gets the opposite, spread over the world's next step.
+        std::vector<glm::vec3> forces(colliders_.size(), glm::vec3(0.0f));
+        std::vector<glm::vec3> torques(colliders_.size(), glm::vec3(0.0f));
+        const float scale = -mass_ / (dt * dt);
+        for (const Contact& contact : contacts_) {
+            const Collider& collider = colliders_[contact.collider];
+            if (!collider.dynamic || contact.push == glm::vec3(0.0f)) continue;
+            const glm::vec3 force = contact.push * scale;
+            const glm::vec3 p(x_[contact.particle], y_[contact.particle], z_[contact.particle]);
+            forces[contact.collider] += force;
+            torques[contact.collider] += glm::cross(p - collider.position, force);
+        }
+        // Handles first: waking a body can move others in the dense order.
+        std::vector<BodyHandle> handles(colliders_.size());
+        for (size_t c = 0; c < colliders_.size(); ++c) handles[c] = world.handleAt(colliders_[c].bodyIndex);
+        for (size_t c = 0; c < colliders_.size(); ++c) {
+            if (forces[c] == glm::vec3(0.0f)) continue;
+            world.applyForce(handles[c], forces[c]);
+            world.applyTorque(handles[c], torques[c]);
+        }
+    }
+
+} // namespace physics
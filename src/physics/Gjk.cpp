@@ -0,0 +1,342 @@
+#include "physics/Gjk.h"
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace physics {
+
+    namespace {
+        constexpr int kMaxGjkIterations = 64;
+        constexpr int kMaxEpaIterations = 64;
+        constexpr float kGjkRelativeTolerance = 1e-6f;
+        constexpr float kEpaTolerance = 1e-4f;
+
+        // Point of the Minkowski difference A - B along with the shape points that formed it.
+        struct Vertex {
+            glm::vec3 a, b, w;
+        };
+
+        struct Simplex {
+            Vertex v[4];
+            float lambda[4];
+            int count{ 0 };
+
+            void keep(std::initializer_list<int> indices, std::initializer_list<float> weights) {
+                Vertex kept[4];
+                int n = 0;
+                for (int i : indices) kept[n++] = v[i];
+                n = 0;
+                for (float weight : weights) lambda[n++] = weight;
+                for (int i = 0; i < n; ++i) v[i] = kept[i];
+                count = n;
+            }
+
+            glm::vec3 point() const {
+                glm::vec3 p(0.0f);
+                for (int i = 0; i < count; ++i) p += v[i].w * lambda[i];
+                return p;
+            }
+        };
+
+        template <typename Support>
+        Vertex makeVertex(const ConvexInstance& a, const ConvexInstance& b, const glm::vec3& direction, Support support) {
+            const glm::vec3 pa = support(a, direction);
+            const glm::vec3 pb = support(b, -direction);
+            return { pa, pb, pa - pb };
+        }
+
+        // Closest point of a triangle to the origin (Ericson, Real-Time Collision Detection 5.1.5),
+        // reducing the simplex to the feature that contains it.
+        void solveTriangle(Simplex& s) {
+            const glm::vec3 a = s.v[0].w, b = s.v[1].w, c = s.v[2].w;
+            const glm::vec3 ab = b - a, ac = c - a;
+            const float d1 = glm::dot(ab, -a), d2 = glm::dot(ac, -a);
+            if (d1 <= 0.0f && d2 <= 0.0f) return s.keep({ 0 }, { 1.0f });
+
+            const float d3 = glm::dot(ab, -b), d4 = glm::dot(ac, -b);
+            if (d3 >= 0.0f && d4 <= d3) return s.keep({ 1 }, { 1.0f });
+
+            const float vc = d1 * d4 - d3 * d2;
+            if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+                const float t = d1 / (d1 - d3);
+                return s.keep({ 0, 1 }, { 1.0f - t, t });
+            }
+
+            const float d5 = glm::dot(ab, -c), d6 = glm::dot(ac, -c);
+            if (d6 >= 0.0f && d5 <= d6) return s.keep({ 2 }, { 1.0f });
+
+            const float vb = d5 * d2 - d1 * d6;
+            if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+                const float t = d2 / (d2 - d6);
+                return s.keep({ 0, 2 }, { 1.0f - t, t });
+            }
+
+            const float va = d3 * d6 - d5 * d4;
+            if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+                const float t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+                return s.keep({ 1, 2 }, { 1.0f - t, t });
+            }
+
+            const float denom = 1.0f / (va + vb + vc);
+            const float v = vb * denom, w = vc * denom;
+            s.lambda[0] = 1.0f - v - w;
+            s.lambda[1] = v;
+            s.lambda[2] = w;
+        }
+
+        void solveSegment(Simplex& s) {
+            const glm::vec3 a = s.v[0].w;
+            const glm::vec3 ab = s.v[1].w - a;
+            const float lengthSq = glm::dot(ab, ab);
+            const float t = lengthSq > 0.0f ? glm::dot(-a, ab) / lengthSq : 0.0f;
+            if (t <= 0.0f) return s.keep({ 0 }, { 1.0f });
+            if (t >= 1.0f) return s.keep({ 1 }, { 1.0f });
+            s.lambda[0] = 1.0f - t;
+            s.lambda[1] = t;
+        }
+
+        // Returns true when the origin is inside the tetrahedron; otherwise reduces to the
+        // closest face feature.
+        bool solveTetrahedron(Simplex& s) {
+            static constexpr int kFaces[4][4] = { { 0, 1, 2, 3 }, { 0, 2, 3, 1 }, { 0, 3, 1, 2 }, { 1, 3, 2, 0 } };
+            float bestDistance = std::numeric_limits<float>::max();
+            Simplex best;
+            bool outside = false;
+            for (const auto& face : kFaces) {
+                const glm::vec3 a = s.v[face[0]].w;
+                const glm::vec3 n = glm::cross(s.v[face[1]].w - a, s.v[face[2]].w - a);
+                const float originSide = glm::dot(-a, n);
+                const float oppositeSide = glm::dot(s.v[face[3]].w - a, n);
+                // A flat tetrahedron has no inside; treat every face as a candidate.
+                if (originSide * oppositeSide >= 0.0f && std::abs(oppositeSide) > 1e-12f) continue;
+                outside = true;
+                Simplex triangle;
+                triangle.v[0] = s.v[face[0]];
+                triangle.v[1] = s.v[face[1]];
+                triangle.v[2] = s.v[face[2]];
+                triangle.count = 3;
+                solveTriangle(triangle);
+                const glm::vec3 p = triangle.point();
+                const float distance = glm::dot(p, p);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = triangle;
+                }
+            }
+            if (!outside) return true;
+            s = best;
+            return false;
+        }
+
+        // Shared GJK loop; `support` picks core or full-shape support points.
+        template <typename Support>
+        GjkResult runGjk(const ConvexInstance& a, const ConvexInstance& b, Simplex& s, Support support) {
+            GjkResult result;
+            glm::vec3 direction = b.position - a.position;
+            if (glm::dot(direction, direction) < 1e-12f) direction = glm::vec3(1.0f, 0.0f, 0.0f);
+            s.v[0] = makeVertex(a, b, direction, support);
+            s.lambda[0] = 1.0f;
+            s.count = 1;
+            glm::vec3 v = s.v[0].w;
+
+            for (; result.iterations < kMaxGjkIterations; ++result.iterations) {
+                const float vv = glm::dot(v, v);
+                if (vv < 1e-12f) {
+                    result.overlap = true;
+                    return result;
+                }
+                const Vertex w = makeVertex(a, b, -v, support);
+
+                // Converged: the new point gets no closer to the origin than v.
+                if (vv - glm::dot(v, w.w) <= kGjkRelativeTolerance * vv) break;
+                bool duplicate = false;
+                for (int i = 0; i < s.count; ++i) duplicate |= s.v[i].w == w.w;
+                if (duplicate) break;
+
+                s.v[s.count] = w;
+                s.lambda[s.count] = 0.0f;
+                ++s.count;
+                switch (s.count) {
+                    case 2: solveSegment(s); break;
+                    case 3: solveTriangle(s); break;
+                    default:
+                        if (solveTetrahedron(s)) {
+                            result.overlap = true;
+                            return result;
+                        }
+                        break;
+                }
+                const glm::vec3 next = s.point();
+                if (glm::dot(next, next) >= vv) break; // No progress; numerical floor reached.
+                v = next;
+            }
+
+            result.pointA = glm::vec3(0.0f);
+            result.pointB = glm::vec3(0.0f);
+            for (int i = 0; i < s.count; ++i) {
+                result.pointA += s.v[i].a * s.lambda[i];
+                result.pointB += s.v[i].b * s.lambda[i];
+            }
+            result.distance = glm::length(result.pointA - result.pointB);
+            return result;
+        }
+
+        const auto kCoreSupport = [](const ConvexInstance& shape, const glm::vec3& d) { return shape.coreSupport(d); };
+        const auto kFullSupport = [](const ConvexInstance& shape, const glm::vec3& d) { return shape.support(d); };
+
+        struct Face {
+            int index[3];
+            glm::vec3 normal;
+            float distance;
+            bool alive;
+        };
+
+        // Barycentric coordinates of p in triangle abc.
+        glm::vec3 barycentric(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+            const glm::vec3 v0 = b - a, v1 = c - a, v2 = p - a;
+            const float d00 = glm::dot(v0, v0), d01 = glm::dot(v0, v1), d11 = glm::dot(v1, v1);
+            const float d20 = glm::dot(v2, v0), d21 = glm::dot(v2, v1);
+            const float denom = d00 * d11 - d01 * d01;
+            if (std::abs(denom) < 1e-20f) return { 1.0f, 0.0f, 0.0f };
+            const float v = (d11 * d20 - d01 * d21) / denom;
+            const float w = (d00 * d21 - d01 * d20) / denom;
+            return { 1.0f - v - w, v, w };
+        }
+
+        // Grows a GJK simplex that touches the origin into a full tetrahedron.
+        bool blowUpSimplex(const ConvexInstance& a, const ConvexInstance& b, Simplex& s) {
+            constexpr float kEpsilon = 1e-6f;
+            static const glm::vec3 kAxes[6] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+
+            if (s.count == 1) {
+                for (const glm::vec3& axis : kAxes) {
+                    const Vertex w = makeVertex(a, b, axis, kFullSupport);
+                    if (glm::length(w.w - s.v[0].w) > kEpsilon) {
+                        s.v[s.count++] = w;
+                        break;
+                    }
+                }
+            }
+            if (s.count == 2) {
+                const glm::vec3 line = s.v[1].w - s.v[0].w;
+                const glm::vec3 absLine = glm::abs(line);
+                const glm::vec3 axis = absLine.x <= absLine.y && absLine.x <= absLine.z ? glm::vec3(1, 0, 0)
+                                     : absLine.y <= absLine.z ? glm::vec3(0, 1, 0) : glm::vec3(0, 0, 1);
+                const glm::vec3 p1 = glm::cross(line, axis);
+                const glm::vec3 p2 = glm::cross(line, p1);
+                for (const glm::vec3& direction : { p1, -p1, p2, -p2 }) {
+                    const Vertex w = makeVertex(a, b, direction, kFullSupport);
+                    if (glm::length(glm::cross(w.w - s.v[0].w, line)) > kEpsilon * glm::length(line)) {
+                        s.v[s.count++] = w;
+                        break;
+                    }
+                }
+            }
+            if (s.count == 3) {
+                glm::vec3 normal = glm::cross(s.v[1].w - s.v[0].w, s.v[2].w - s.v[0].w);
+                const float length = glm::length(normal);
+                if (length < 1e-12f) return false;
+                normal = normal / length;
+                for (const glm::vec3& direction : { normal, -normal }) {
+                    const Vertex w = makeVertex(a, b, direction, kFullSupport);
+                    if (std::abs(glm::dot(w.w - s.v[0].w, normal)) > kEpsilon) {
+                        s.v[s.count++] = w;
+                        break;
+                    }
+                }
+            }
+            return s.count == 4;
+        }
+    }
+
+    GjkResult gjkDistance(const ConvexInstance& a, const ConvexInstance& b) {
+        Simplex simplex;
+        return runGjk(a, b, simplex, kCoreSupport);
+    }
+
+    bool epaPenetration(const ConvexInstance& a, const ConvexInstance& b, EpaResult& result) {
+        Simplex simplex;
+        const GjkResult gjk = runGjk(a, b, simplex, kFullSupport);
+        if (!gjk.overlap && gjk.distance > 1e-5f) return false;
+        if (!blowUpSimplex(a, b, simplex)) return false;
+
+        // Scratch reused across calls on the same thread; the narrowphase runs many pairs per step.
+        thread_local std::vector<Vertex> vertices;
+        thread_local std::vector<Face> faces;
+        thread_local std::vector<std::pair<int, int>> horizon;
+        vertices.assign(simplex.v, simplex.v + 4);
+        faces.clear();
+
+        const glm::vec3 interior = (vertices[0].w + vertices[1].w + vertices[2].w + vertices[3].w) * 0.25f;
+        auto addFace = [&](int i, int j, int k) {
+            glm::vec3 normal = glm::cross(vertices[j].w - vertices[i].w, vertices[k].w - vertices[i].w);
+            const float length = glm::length(normal);
+            if (length < 1e-12f) {
+                // Sliver: keep it for topology but never pick it.
+                faces.push_back({ { i, j, k }, glm::vec3(0.0f), std::numeric_limits<float>::max(), true });
+                return;
+            }
+            normal = normal / length;
+            if (glm::dot(normal, vertices[i].w - interior) < 0.0f) {
+                std::swap(j, k);
+                normal = -normal;
+            }
+            faces.push_back({ { i, j, k }, normal, glm::dot(normal, vertices[i].w), true });
+        };
+        addFace(0, 1, 2);
+        addFace(0, 3, 1);
+        addFace(0, 2, 3);
+        addFace(1, 3, 2);
+
+        const Face* closest = nullptr;
+        for (int iteration = 0; iteration < kMaxEpaIterations; ++iteration) {
+            closest = nullptr;
+            for (const Face& face : faces) {
+                if (face.alive && (!closest || face.distance < closest->distance)) closest = &face;
+            }
+            if (!closest || closest->distance == std::numeric_limits<float>::max()) return false;
+
+            const Vertex w = makeVertex(a, b, closest->normal, kFullSupport);
+            const float reach = glm::dot(w.w, closest->normal);
+            if (reach - closest->distance < kEpaTolerance * std::max(1.0f, closest->distance)) break;
+
+            // Remove every face the new point sees; the boundary of the hole is the horizon.
+            horizon.clear();
+            const int newIndex = static_cast<int>(vertices.size());
+            for (Face& face : faces) {
+                if (!face.alive || glm::dot(face.normal, w.w - vertices[face.index[0]].w) <= 0.0f) continue;
+                face.alive = false;
+                for (int e = 0; e < 3; ++e) {
+                    const std::pair<int, int> edge{ face.index[e], face.index[(e + 1) % 3] };
+                    auto shared = std::find(horizon.begin(), horizon.end(), std::pair<int, int>{ edge.second, edge.first });
+                    if (shared != horizon.end()) horizon.erase(shared);
+                    else horizon.push_back(edge);
+                }
+            }
+            if (horizon.empty()) break;
+            vertices.push_back(w);
+            for (const auto& [from, to] : horizon) addFace(from, to, newIndex);
+            closest = nullptr;
+        }
+        if (!closest) {
+            for (const Face& face : faces) {
+                if (face.alive && (!closest || face.distance < closest->distance)) closest = &face;
+            }
+            if (!closest) return false;
+        }
+
+        const Vertex& v0 = vertices[closest->index[0]];
+        const Vertex& v1 = vertices[closest->index[1]];
+        const Vertex& v2 = vertices[closest->index[2]];
+        const glm::vec3 weights = barycentric(closest->normal * closest->distance, v0.w, v1.w, v2.w);
+        result.normal = closest->normal;
+        result.depth = std::max(closest->distance, 0.0f);
+        result.pointA = v0.a * weights.x + v1.a * weights.y + v2.a * weights.z;
+        result.pointB = v0.b * weights.x + v1.b * weights.y + v2.b * weights.z;
+        return true;
+    }
+
+} // namespace physics
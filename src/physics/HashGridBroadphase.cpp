@@ -0,0 +1,171 @@
+#include "physics/HashGridBroadphase.h"
+#include "utils/JobSystem.h"
+#include <algorithm>
+
+namespace physics {
+
+    namespace {
+        constexpr size_t kPairChunk = 1024;
+
+        float largestSide(const Aabb& aabb) {
+            const glm::vec3 size = aabb.max - aabb.min;
+            return std::max(size.x, std::max(size.y, size.z));
+        }
+    }
+
+    HashGridBroadphase::HashGridBroadphase(float cellSize, float margin)
+        : cellSize_(cellSize), margin_(margin) {
+    }
+
+    ProxyId HashGridBroadphase::createProxy(const Aabb& aabb, uint32_t userData) {
+        ProxyId proxy;
+        if (!freeProxies_.empty()) {
+            proxy = freeProxies_.back();
+            freeProxies_.pop_back();
+        }
+        else {
+            proxy = static_cast<ProxyId>(proxies_.size());
+            proxies_.emplace_back();
+        }
+        proxies_[proxy] = { aabb.fattened(margin_), userData, true };
+        ++proxyCount_;
+        return proxy;
+    }
+
+    void HashGridBroadphase::destroyProxy(ProxyId proxy) {
+        if (proxy >= proxies_.size() || !proxies_[proxy].alive) return;
+        proxies_[proxy].alive = false;
+        freeProxies_.push_back(proxy);
+        --proxyCount_;
+    }
+
+    void HashGridBroadphase::moveProxy(ProxyId proxy, const Aabb& aabb, const glm::vec3& /*displacement*/) {
+        // The grid is rebuilt from scratch each call; nothing to predict.
+        proxies_[proxy].aabb = aabb.fattened(margin_);
+    }
+
+    float HashGridBroadphase::chooseCellSize() {
+        if (cellSize_ > 0.0f) return cellSize_;
+        sizes_.clear();
+        for (const Proxy& proxy : proxies_) {
+            if (proxy.alive) sizes_.push_back(largestSide(proxy.aabb));
+        }
+        // The median keeps a minority of large bodies from inflating every cell; they take the
+        // oversized path instead.
+        const auto nth = sizes_.begin() + static_cast<std::ptrdiff_t>(sizes_.size() / 2);
+        std::nth_element(sizes_.begin(), nth, sizes_.end());
+        return *nth;
+    }
+
+    void HashGridBroadphase::findPairs(std::vector<BroadphasePair>& pairs) {
+        pairs.clear();
+        small_.clear();
+        large_.clear();
+        if (proxyCount_ < 2) return;
+
+        // Two boxes no larger than a cell can only overlap if their centers are in adjacent cells.
+        const float cellSize = chooseCellSize();
+        centerX_.clear();
+        centerY_.clear();
+        centerZ_.clear();
+        smallAabbs_.clear();
+        for (size_t i = 0; i < proxies_.size(); ++i) {
+            const Proxy& proxy = proxies_[i];
+            if (!proxy.alive) continue;
+            if (largestSide(proxy.aabb) > cellSize) {
+                large_.push_back(static_cast<ProxyId>(i));
+                continue;
+            }
+            const glm::vec3 c = proxy.aabb.center();
+            centerX_.push_back(c.x);
+            centerY_.push_back(c.y);
+            centerZ_.push_back(c.z);
+            smallAabbs_.push_back(proxy.aabb);
+            small_.push_back(static_cast<ProxyId>(i));
+        }
+        grid_.setCellSize(cellSize);
+        grid_.build(centerX_.data(), centerY_.data(), centerZ_.data(), small_.size());
+
+        auto report = [&](std::vector<BroadphasePair>& out, ProxyId a, ProxyId b) {
+            const uint32_t ua = proxies_[a].userData;
+            const uint32_t ub = proxies_[b].userData;
+            out.push_back({ std::min(ua, ub), std::max(ua, ub) });
+        };
+
+        // Walk in bucket order so neighbouring queries reuse the same cache lines.
+        const std::vector<uint32_t>& order = grid_.getSortedIndices();
+        const size_t chunks = (order.size() + kPairChunk - 1) / kPairChunk;
+        if (chunkPairs_.size() < chunks + 1) chunkPairs_.resize(chunks + 1);
+        utils::JobSystem::getInstance().parallelFor(chunks, [&](size_t chunk) {
+            std::vector<BroadphasePair>& out = chunkPairs_[chunk];
+            out.clear();
+            const size_t end = std::min(order.size(), (chunk + 1) * kPairChunk);
+            for (size_t k = chunk * kPairChunk; k < end; ++k) {
+                const uint32_t i = order[k];
+                const Aabb& aabb = smallAabbs_[i];
+                grid_.forEachHalfNeighbor(glm::vec3(centerX_[i], centerY_[i], centerZ_[i]), [&](uint32_t j) {
+                    // Only pairs sharing a bucket are seen from both ends; the final unique() drops those.
+                    if (j != i && aabb.overlaps(smallAabbs_[j])) report(out, small_[i], small_[j]);
+                });
+            }
+        });
+
+        // Oversized proxies are expected to be few (terrain, walls). Each walks the cells its box
+        // covers, grown by one cell for the centers of small boxes poking in, or scans every
+        // small proxy when that is cheaper.
+        std::vector<BroadphasePair>& largeOut = chunkPairs_[chunks];
+        largeOut.clear();
+        for (size_t l = 0; l < large_.size(); ++l) {
+            const Aabb& aabb = proxies_[large_[l]].aabb;
+            const SpatialHashGrid::Cell lo = grid_.cellOf(aabb.min - glm::vec3(cellSize));
+            const SpatialHashGrid::Cell hi = grid_.cellOf(aabb.max + glm::vec3(cellSize));
+            const double cells = double(hi.x - lo.x + 1) * double(hi.y - lo.y + 1) * double(hi.z - lo.z + 1);
+            if (cells < static_cast<double>(small_.size())) {
+                for (int32_t z = lo.z; z <= hi.z; ++z) {
+                    for (int32_t y = lo.y; y <= hi.y; ++y) {
+                        for (int32_t x = lo.x; x <= hi.x; ++x) {
+                            grid_.forEachInCell({ x, y, z }, [&](uint32_t j) {
+                                if (aabb.overlaps(smallAabbs_[j])) report(largeOut, large_[l], small_[j]);
+                            });
+                        }
+                    }
+                }
+            }
+            else {
+                for (size_t j = 0; j < small_.size(); ++j) {
+                    if (aabb.overlaps(smallAabbs_[j])) report(largeOut, large_[l], small_[j]);
+                }
+            }
+            for (size_t m = l + 1; m < large_.size(); ++m) {
+                if (aabb.overlaps(proxies_[large_[m]].aabb)) report(largeOut, large_[l], large_[m]);
+            }
+        }
+
+        size_t total = 0;
+        for (size_t c = 0; c <= chunks; ++c) total += chunkPairs_[c].size();
+        pairs.reserve(total);
+        for (size_t c = 0; c <= chunks; ++c) {
+            pairs.insert(pairs.end(), chunkPairs_[c].begin(), chunkPairs_[c].end());
+        }
+        std::sort(pairs.begin(), pairs.end());
+        // Points sharing a bucket, and oversized proxies walking colliding buckets, report twice.
+        pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+    }
+
+    void HashGridBroadphase::queryAabb(const Aabb& aabb, const std::function<bool(uint32_t)>& visitor) const {
+        for (const Proxy& proxy : proxies_) {
+            if (proxy.alive && proxy.aabb.overlaps(aabb) && !visitor(proxy.userData)) return;
+        }
+    }
+
+    void HashGridBroadphase::rayCast(const glm::vec3& origin, const glm::vec3& direction, float maxT,
+                                     const std::function<float(uint32_t, float)>& visitor) const {
+        for (const Proxy& proxy : proxies_) {
+            if (!proxy.alive || proxy.aabb.rayCast(origin, direction, maxT) < 0.0f) continue;
+            const float value = visitor(proxy.userData, maxT);
+            if (value == 0.0f) return;
+            if (value > 0.0f) maxT = std::min(maxT, value);
+        }
+    }
+
+} // namespace physics
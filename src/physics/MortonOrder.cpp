@@ -0,0 +1,86 @@
+#include "physics/MortonOrder.h"
+#include "utils/JobSystem.h"
+#include <algorithm>
+#include <array>
+
+namespace physics {
+
+    namespace {
+        constexpr size_t kSortChunk = 16384;
+        constexpr int kDigitBits = 8;
+        constexpr size_t kBuckets = size_t(1) << kDigitBits;
+    }
+
+    void computeMortonCodes(const float* x, const float* y, const float* z, size_t count, const Aabb& bounds, uint64_t* codes) {
+        constexpr float kMaxCell = static_cast<float>((1u << kMortonBitsPerAxis) - 1);
+        const glm::vec3 extent = glm::max(bounds.max - bounds.min, glm::vec3(1e-20f));
+        const glm::vec3 scale = glm::vec3(kMaxCell) / extent;
+        const glm::vec3 origin = bounds.min;
+        const size_t chunks = (count + kSortChunk - 1) / kSortChunk;
+        utils::JobSystem::getInstance().parallelFor(chunks, [&](size_t chunk) {
+            const size_t end = std::min(count, (chunk + 1) * kSortChunk);
+            for (size_t i = chunk * kSortChunk; i < end; ++i) {
+                // max(0, v) first so NaN quantizes to 0.
+                const auto quantize = [&](float v, int axis) {
+                    return static_cast<uint32_t>(std::min(std::max(0.0f, (v - origin[axis]) * scale[axis]), kMaxCell));
+                };
+                codes[i] = mortonEncode(quantize(x[i], 0), quantize(y[i], 1), quantize(z[i], 2));
+            }
+        });
+    }
+
+    void sortMortonCodes(std::vector<uint64_t>& keys, std::vector<uint32_t>& order) {
+        const size_t count = keys.size();
+        order.resize(count);
+        for (size_t i = 0; i < count; ++i) order[i] = static_cast<uint32_t>(i);
+        if (count < 2) return;
+
+        // Digits where every key agrees don't reorder anything.
+        uint64_t allOr = 0, allAnd = ~uint64_t(0);
+        for (uint64_t key : keys) {
+            allOr |= key;
+            allAnd &= key;
+        }
+        const uint64_t varying = allOr ^ allAnd;
+
+        auto& jobs = utils::JobSystem::getInstance();
+        const size_t chunks = (count + kSortChunk - 1) / kSortChunk;
+        std::vector<uint64_t> keysOut(count);
+        std::vector<uint32_t> orderOut(count);
+        std::vector<std::array<uint32_t, kBuckets>> offsets(chunks);
+
+        for (int shift = 0; shift < 64; shift += kDigitBits) {
+            if (((varying >> shift) & (kBuckets - 1)) == 0) continue;
+
+            jobs.parallelFor(chunks, [&](size_t chunk) {
+                auto& histogram = offsets[chunk];
+                histogram.fill(0);
+                const size_t end = std::min(count, (chunk + 1) * kSortChunk);
+                for (size_t i = chunk * kSortChunk; i < end; ++i) ++histogram[(keys[i] >> shift) & (kBuckets - 1)];
+            });
+
+            // Exclusive scan, digit-major then chunk order, keeps equal digits in input order.
+            uint32_t running = 0;
+            for (size_t digit = 0; digit < kBuckets; ++digit) {
+                for (size_t chunk = 0; chunk < chunks; ++chunk) {
+                    const uint32_t n = offsets[chunk][digit];
+                    offsets[chunk][digit] = running;
+                    running += n;
+                }
+            }
+
+            jobs.parallelFor(chunks, [&](size_t chunk) {
+                auto& next = offsets[chunk];
+                const size_t end = std::min(count, (chunk + 1) * kSortChunk);
+                for (size_t i = chunk * kSortChunk; i < end; ++i) {
+                    const uint32_t slot = next[(keys[i] >> shift) & (kBuckets - 1)]++;
+                    keysOut[slot] = keys[i];
+                    orderOut[slot] = order[i];
+                }
+            });
+            keys.swap(keysOut);
+            order.swap(orderOut);
+        }
+    }
+
+} // namespace physics
@@ -0,0 +1,471 @@
+#include "physics/NBodyGravity.h"
+#include "physics/MortonOrder.h"
+#include "utils/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+
+namespace physics {
+
+    namespace {
+        constexpr size_t kPointsPerJob = 128;
+        constexpr size_t kNodesPerJob = 32;
+        // Deepest possible path (one level per Morton bit) times the most children per node.
+        constexpr size_t kWalkStack = (kMortonBitsPerAxis + 1) * 8;
+
+        // Symmetric 3x3 stored as xx, xy, xz, yy, yz, zz.
+        glm::vec3 symmetricTimes(const float* s, const glm::vec3& v) {
+            return { s[0] * v.x + s[1] * v.y + s[2] * v.z,
+                     s[1] * v.x + s[3] * v.y + s[4] * v.z,
+                     s[2] * v.x + s[4] * v.y + s[5] * v.z };
+        }
+
+        // Fully symmetric 3x3x3 stored as xxx, xxy, xxz, xyy, xyz, xzz, yyy, yyz, yzz, zzz.
+        constexpr int kThird[3][3][3] = {
+            { { 0, 1, 2 }, { 1, 3, 4 }, { 2, 4, 5 } },
+            { { 1, 3, 4 }, { 3, 6, 7 }, { 4, 7, 8 } },
+            { { 2, 4, 5 }, { 4, 7, 8 }, { 5, 8, 9 } },
+        };
+        constexpr int kSymmetric[6][2] = { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 1, 1 }, { 1, 2 }, { 2, 2 } };
+
+        // (K t)_ij, symmetric.
+        void thirdTimes(const float* k, const glm::vec3& t, float* out) {
+            for (int s = 0; s < 6; ++s) {
+                const auto& row = kThird[kSymmetric[s][0]][kSymmetric[s][1]];
+                out[s] = k[row[0]] * t.x + k[row[1]] * t.y + k[row[2]] * t.z;
+            }
+        }
+
+        // Local expansion evaluated at offset t: g + T t + K(t, t) / 2.
+        glm::vec3 expand(const glm::vec3& field, const float* tidal, const float* third, const glm::vec3& t) {
+            float kt[6];
+            thirdTimes(third, t, kt);
+            return field + symmetricTimes(tidal, t) + 0.5f * symmetricTimes(kt, t);
+        }
+
+        // Adds m * (3 d d^T - |d|^2 I), the traceless quadrupole of a point mass at offset d.
+        void addQuadrupole(float* q, float m, const glm::vec3& d) {
+            const float d2 = glm::dot(d, d);
+            q[0] += m * (3.0f * d.x * d.x - d2);
+            q[1] += m * 3.0f * d.x * d.y;
+            q[2] += m * 3.0f * d.x * d.z;
+            q[3] += m * (3.0f * d.y * d.y - d2);
+            q[4] += m * 3.0f * d.y * d.z;
+            q[5] += m * (3.0f * d.z * d.z - d2);
+        }
+    }
+
+    NBodyGravity::NBodyGravity(const GravitySettings& settings) {
+        setSettings(settings);
+    }
+
+    void NBodyGravity::setSettings(const GravitySettings& settings) {
+        settings_ = settings;
+        settings_.theta = std::clamp(settings.theta, 0.05f, 1.0f);
+        settings_.softening = std::max(settings.softening, 0.0f);
+        settings_.leafSize = std::max(settings.leafSize, 1u);
+    }
+
+    void NBodyGravity::computeAccelerations(const float* x, const float* y, const float* z, const float* mass, size_t count,
+                                            float* ax, float* ay, float* az) {
+        if (count == 0) return;
+        if (settings_.method == GravityMethod::Direct) {
+            evaluateDirect(x, y, z, mass, count, ax, ay, az);
+            return;
+        }
+
+        sortPoints(x, y, z, mass, count);
+        buildTree();
+        computeMoments();
+        ax_.assign(count, 0.0f);
+        ay_.assign(count, 0.0f);
+        az_.assign(count, 0.0f);
+        if (settings_.method == GravityMethod::BarnesHut) {
+            evaluateBarnesHut();
+        } else {
+            evaluateMultipole();
+        }
+
+        utils::JobSystem::getInstance().parallelFor(count, [&](size_t k) {
+            const uint32_t i = order_[k];
+            ax[i] = ax_[k];
+            ay[i] = ay_[k];
+            az[i] = az_[k];
+        }, 4096);
+    }
+
+    void NBodyGravity::applyForces(BodyStorage& bodies, size_t awakeCount) {
+        // Every dynamic body is a source; static and kinematic ones have no mass to pull with.
+        bodyIndices_.clear();
+        bodyX_.clear(); bodyY_.clear(); bodyZ_.clear(); bodyMass_.clear();
+        for (size_t i = 0; i < bodies.size(); ++i) {
+            if ((bodies.flags[i] & (kBodyStatic | kBodyKinematic)) || bodies.inverseMass[i] <= 0.0f) continue;
+            bodyIndices_.push_back(static_cast<uint32_t>(i));
+            bodyX_.push_back(bodies.positionX[i]);
+            bodyY_.push_back(bodies.positionY[i]);
+            bodyZ_.push_back(bodies.positionZ[i]);
+            bodyMass_.push_back(1.0f / bodies.inverseMass[i]);
+        }
+        const size_t count = bodyIndices_.size();
+        bodyAx_.resize(count);
+        bodyAy_.resize(count);
+        bodyAz_.resize(count);
+        computeAccelerations(bodyX_.data(), bodyY_.data(), bodyZ_.data(), bodyMass_.data(), count,
+                             bodyAx_.data(), bodyAy_.data(), bodyAz_.data());
+
+        for (size_t k = 0; k < count; ++k) {
+            const uint32_t i = bodyIndices_[k];
+            if (i >= awakeCount) continue;
+            bodies.forceX[i] += bodyAx_[k] * bodyMass_[k];
+            bodies.forceY[i] += bodyAy_[k] * bodyMass_[k];
+            bodies.forceZ[i] += bodyAz_[k] * bodyMass_[k];
+        }
+    }
+
+    void NBodyGravity::evaluateDirect(const float* x, const float* y, const float* z, const float* mass, size_t count,
+                                      float* ax, float* ay, float* az) const {
+        // See sumPoints() for how a point skips itself.
+        const float eps2 = settings_.softening * settings_.softening;
+        const float g = settings_.gravitationalConstant;
+        utils::JobSystem::getInstance().parallelFor(count, [&](size_t i) {
+            const float xi = x[i], yi = y[i], zi = z[i];
+            float sx = 0.0f, sy = 0.0f, sz = 0.0f;
+            // Straight SoA loop with no branches, so the compiler can vectorize it.
+            for (size_t j = 0; j < count; ++j) {
+                const float dx = x[j] - xi, dy = y[j] - yi, dz = z[j] - zi;
+                const float d2 = dx * dx + dy * dy + dz * dz;
+                const float inv = 1.0f / std::sqrt(d2 + eps2);
+                const float w = d2 > 0.0f ? mass[j] * inv * inv * inv : 0.0f;
+                sx += dx * w;
+                sy += dy * w;
+                sz += dz * w;
+            }
+            ax[i] = g * sx;
+            ay[i] = g * sy;
+            az[i] = g * sz;
+        }, kPointsPerJob);
+    }
+
+    void NBodyGravity::sortPoints(const float* x, const float* y, const float* z, const float* mass, size_t count) {
+        // A cube around the points, so every octree level halves all three axes.
+        Aabb bounds{ glm::vec3(x[0], y[0], z[0]), glm::vec3(x[0], y[0], z[0]) };
+        for (size_t i = 1; i < count; ++i) {
+            const glm::vec3 p(x[i], y[i], z[i]);
+            bounds.min = glm::min(bounds.min, p);
+            bounds.max = glm::max(bounds.max, p);
+        }
+        const glm::vec3 extent = bounds.max - bounds.min;
+        const float half = 0.5f * std::max({ extent.x, extent.y, extent.z, 1e-6f }) * 1.001f;
+        const glm::vec3 center = bounds.center();
+        const Aabb cube{ center - glm::vec3(half), center + glm::vec3(half) };
+
+        codes_.resize(count);
+        computeMortonCodes(x, y, z, count, cube, codes_.data());
+        sortMortonCodes(codes_, order_);
+
+        px_.resize(count);
+        py_.resize(count);
+        pz_.resize(count);
+        pm_.resize(count);
+        utils::JobSystem::getInstance().parallelFor(count, [&](size_t k) {
+            const uint32_t i = order_[k];
+            px_[k] = x[i];
+            py_[k] = y[i];
+            pz_[k] = z[i];
+            pm_[k] = mass[i];
+        }, 4096);
+    }
+
+    void NBodyGravity::buildTree() {
+        nodes_.clear();
+        nodes_.push_back({});
+        nodes_[0].begin = 0;
+        nodes_[0].end = static_cast<uint32_t>(codes_.size());
+        levelStart_.assign({ 0, 1 });
+        auto& jobs = utils::JobSystem::getInstance();
+
+        // Each node is a run of codes sharing a prefix; its children split the run on the next
+        // three bits. All nodes of a level are split in parallel.
+        for (int level = 0; level < kMortonBitsPerAxis; ++level) {
+            const uint32_t first = levelStart_[level];
+            const uint32_t last = levelStart_[level + 1];
+            const int shift = 3 * (kMortonBitsPerAxis - 1 - level);
+            const auto octant = [&](uint32_t k) { return (codes_[k] >> shift) & 7u; };
+            // Calls visit(begin, end) for each non-empty octant of the node, in order.
+            const auto forEachOctant = [&](const Node& node, auto&& visit) {
+                uint32_t begin = node.begin;
+                while (begin < node.end) {
+                    const uint64_t digit = octant(begin);
+                    uint32_t lo = begin + 1, hi = node.end;
+                    while (lo < hi) {
+                        const uint32_t mid = lo + (hi - lo) / 2;
+                        if (octant(mid) == digit) lo = mid + 1; else hi = mid;
+                    }
+                    visit(begin, lo);
+                    begin = lo;
+                }
+            };
+
+            childCounts_.assign(last - first, 0);
+            jobs.parallelFor(last - first, [&](size_t k) {
+                const Node& node = nodes_[first + k];
+                if (node.end - node.begin <= settings_.leafSize) return;
+                uint32_t children = 0;
+                forEachOctant(node, [&](uint32_t, uint32_t) { ++children; });
+                childCounts_[k] = children;
+            }, kNodesPerJob);
+
+            uint32_t next = last;
+            for (uint32_t k = 0; k < last - first; ++k) {
+                Node& node = nodes_[first + k];
+                node.firstChild = childCounts_[k] ? next : 0;
+                node.childCount = childCounts_[k];
+                next += childCounts_[k];
+            }
+            if (next == last) break;
+
+            nodes_.resize(next);
+            jobs.parallelFor(last - first, [&](size_t k) {
+                const Node& node = nodes_[first + k];
+                uint32_t child = node.firstChild;
+                for (uint32_t c = 0; c < node.childCount; ++c) nodes_[child + c] = {};
+                forEachOctant(node, [&](uint32_t begin, uint32_t end) {
+                    nodes_[child].begin = begin;
+                    nodes_[child].end = end;
+                    ++child;
+                });
+            }, kNodesPerJob);
+            levelStart_.push_back(next);
+        }
+    }
+
+    void NBodyGravity::computeMoments() {
+        auto& jobs = utils::JobSystem::getInstance();
+        for (size_t level = levelStart_.size() - 1; level-- > 0;) {
+            const uint32_t first = levelStart_[level];
+            jobs.parallelFor(levelStart_[level + 1] - first, [&](size_t k) {
+                Node& node = nodes_[first + k];
+                std::fill(std::begin(node.quadrupole), std::end(node.quadrupole), 0.0f);
+                glm::vec3 weighted(0.0f), mean(0.0f);
+                float mass = 0.0f;
+                if (node.childCount == 0) {
+                    for (uint32_t i = node.begin; i < node.end; ++i) {
+                        const glm::vec3 p(px_[i], py_[i], pz_[i]);
+                        mass += pm_[i];
+                        weighted += p * pm_[i];
+                        mean += p;
+                    }
+                } else {
+                    for (uint32_t c = node.firstChild; c < node.firstChild + node.childCount; ++c) {
+                        const Node& child = nodes_[c];
+                        mass += child.mass;
+                        weighted += child.centerOfMass * child.mass;
+                        mean += child.centerOfMass * static_cast<float>(child.end - child.begin);
+                    }
+                }
+                node.mass = mass;
+                // Massless nodes (test particles) still need a center to measure distances from.
+                node.centerOfMass = mass > 0.0f ? weighted / mass : mean / static_cast<float>(node.end - node.begin);
+
+                float radius = 0.0f;
+                if (node.childCount == 0) {
+                    for (uint32_t i = node.begin; i < node.end; ++i) {
+                        const glm::vec3 d = glm::vec3(px_[i], py_[i], pz_[i]) - node.centerOfMass;
+                        radius = std::max(radius, glm::length(d));
+                        addQuadrupole(node.quadrupole, pm_[i], d);
+                    }
+                } else {
+                    // Parallel axis theorem: child moments shifted to this center of mass.
+                    for (uint32_t c = node.firstChild; c < node.firstChild + node.childCount; ++c) {
+                        const Node& child = nodes_[c];
+                        const glm::vec3 d = child.centerOfMass - node.centerOfMass;
+                        radius = std::max(radius, glm::length(d) + child.radius);
+                        for (int q = 0; q < 6; ++q) node.quadrupole[q] += child.quadrupole[q];
+                        addQuadrupole(node.quadrupole, child.mass, d);
+                    }
+                }
+                node.radius = radius;
+            }, kNodesPerJob);
+        }
+    }
+
+    glm::vec3 NBodyGravity::cellAcceleration(const Node& source, const glm::vec3& r) const {
+        // Monopole plus quadrupole of the source at offset r = target - centerOfMass:
+        // g = G (-M r / d^3 + Q r / d^5 - 5/2 (r.Q.r) r / d^7).
+        const float d2 = glm::dot(r, r) + settings_.softening * settings_.softening;
+        const float inv2 = 1.0f / d2;
+        const float inv3 = inv2 * std::sqrt(inv2);
+        const float inv5 = inv3 * inv2;
+        const glm::vec3 qr = symmetricTimes(source.quadrupole, r);
+        const float rqr = glm::dot(r, qr);
+        return settings_.gravitationalConstant * (r * (-source.mass * inv3 - 2.5f * rqr * inv5 * inv2) + qr * inv5);
+    }
+
+    glm::vec3 NBodyGravity::sumPoints(const glm::vec3& p, const Node& source) const {
+        // A point at zero distance (the target itself) is selected out rather than relying on
+        // softening: with softening 0 its weight is inf, and 0 * inf would be NaN.
+        const float eps2 = settings_.softening * settings_.softening;
+        float sx = 0.0f, sy = 0.0f, sz = 0.0f;
+        for (uint32_t j = source.begin; j < source.end; ++j) {
+            const float dx = px_[j] - p.x, dy = py_[j] - p.y, dz = pz_[j] - p.z;
+            const float d2 = dx * dx + dy * dy + dz * dz;
+            const float inv = 1.0f / std::sqrt(d2 + eps2);
+            const float w = d2 > 0.0f ? pm_[j] * inv * inv * inv : 0.0f;
+            sx += dx * w;
+            sy += dy * w;
+            sz += dz * w;
+        }
+        return settings_.gravitationalConstant * glm::vec3(sx, sy, sz);
+    }
+
+    void NBodyGravity::evaluateBarnesHut() {
+        const float theta2 = settings_.theta * settings_.theta;
+        const size_t count = px_.size();
+        // Points go in Morton order, so consecutive walks open mostly the same nodes.
+        utils::JobSystem::getInstance().parallelFor(count, [&](size_t i) {
+            const glm::vec3 p(px_[i], py_[i], pz_[i]);
+            glm::vec3 acceleration(0.0f);
+            uint32_t stack[kWalkStack];
+            size_t top = 0;
+            stack[top++] = 0;
+            while (top > 0) {
+                const Node& node = nodes_[stack[--top]];
+                if (node.mass <= 0.0f) continue;
+                const glm::vec3 r = p - node.centerOfMass;
+                if (node.radius * node.radius < theta2 * glm::dot(r, r)) {
+                    acceleration += cellAcceleration(node, r);
+                } else if (node.childCount == 0) {
+                    acceleration += sumPoints(p, node);
+                } else {
+                    for (uint32_t c = 0; c < node.childCount; ++c) stack[top++] = node.firstChild + c;
+                }
+            }
+            ax_[i] = acceleration.x;
+            ay_[i] = acceleration.y;
+            az_[i] = acceleration.z;
+        }, kPointsPerJob);
+    }
+
+    void NBodyGravity::evaluateMultipole() {
+        auto& jobs = utils::JobSystem::getInstance();
+        locals_.assign(nodes_.size(), LocalExpansion{ glm::vec3(0.0f), {}, {} });
+
+        // Split the top of the tree into disjoint subtrees small enough to balance across
+        // workers. Each one is walked against the whole tree and only writes its own nodes
+        // and points.
+        const size_t taskPoints = std::max<size_t>(px_.size() / 64, settings_.leafSize * 4);
+        tasks_.assign(1, 0);
+        for (bool split = true; split;) {
+            split = false;
+            std::vector<uint32_t> next;
+            for (uint32_t t : tasks_) {
+                const Node& node = nodes_[t];
+                if (node.childCount > 0 && node.end - node.begin > taskPoints) {
+                    for (uint32_t c = 0; c < node.childCount; ++c) next.push_back(node.firstChild + c);
+                    split = true;
+                } else {
+                    next.push_back(t);
+                }
+            }
+            tasks_.swap(next);
+        }
+        jobs.parallelFor(tasks_.size(), [&](size_t k) { interact(tasks_[k], 0); });
+
+        // Downward pass: parents hand their expansion to their children, shifted to the
+        // children's centers.
+        for (size_t level = 0; level + 1 < levelStart_.size(); ++level) {
+            const uint32_t first = levelStart_[level];
+            jobs.parallelFor(levelStart_[level + 1] - first, [&](size_t k) {
+                const Node& node = nodes_[first + k];
+                const LocalExpansion& parent = locals_[first + k];
+                for (uint32_t c = node.firstChild; c < node.firstChild + node.childCount; ++c) {
+                    LocalExpansion& child = locals_[c];
+                    const glm::vec3 t = nodes_[c].centerOfMass - node.centerOfMass;
+                    float kt[6];
+                    thirdTimes(parent.third, t, kt);
+                    child.field += expand(parent.field, parent.tidal, parent.third, t);
+                    for (int q = 0; q < 6; ++q) child.tidal[q] += parent.tidal[q] + kt[q];
+                    for (int q = 0; q < 10; ++q) child.third[q] += parent.third[q];
+                }
+            }, kNodesPerJob);
+        }
+
+        // Leaves evaluate their expansion at each point.
+        jobs.parallelFor(nodes_.size(), [&](size_t n) {
+            const Node& node = nodes_[n];
+            if (node.childCount != 0) return;
+            const LocalExpansion& local = locals_[n];
+            for (uint32_t i = node.begin; i < node.end; ++i) {
+                const glm::vec3 a = expand(local.field, local.tidal, local.third, glm::vec3(px_[i], py_[i], pz_[i]) - node.centerOfMass);
+                ax_[i] += a.x;
+                ay_[i] += a.y;
+                az_[i] += a.z;
+            }
+        }, kNodesPerJob);
+    }
+
+    void NBodyGravity::addMultipoleToLocal(LocalExpansion& local, const Node& source, const glm::vec3& r) const {
+        // Derivatives of 1/d contracted with the source moments; the traceless quadrupole makes
+        // every trace term vanish. Field and tidal include the quadrupole, the third order only
+        // the monopole.
+        const float g = settings_.gravitationalConstant;
+        const float inv2 = 1.0f / (glm::dot(r, r) + settings_.softening * settings_.softening);
+        const float inv1 = std::sqrt(inv2);
+        const float inv3 = inv1 * inv2;
+        const float inv5 = inv3 * inv2;
+        const float inv7 = inv5 * inv2;
+        const float inv9 = inv7 * inv2;
+        const float m = source.mass;
+        const float* q = source.quadrupole;
+        const glm::vec3 qr = symmetricTimes(q, r);
+        const float rqr = glm::dot(r, qr);
+
+        local.field += g * (r * (-m * inv3 - 2.5f * rqr * inv7) + qr * inv5);
+        for (int s = 0; s < 6; ++s) {
+            const int i = kSymmetric[s][0], j = kSymmetric[s][1];
+            const float delta = i == j ? 1.0f : 0.0f;
+            const float monopole = m * (3.0f * r[i] * r[j] * inv5 - delta * inv3);
+            const float quadrupole = 17.5f * r[i] * r[j] * rqr * inv9 - 5.0f * (r[i] * qr[j] + r[j] * qr[i]) * inv7
+                                   - 2.5f * delta * rqr * inv7 + q[s] * inv5;
+            local.tidal[s] += g * (monopole + quadrupole);
+        }
+        for (int i = 0; i < 3; ++i) {
+            for (int j = i; j < 3; ++j) {
+                for (int k = j; k < 3; ++k) {
+                    const float deltas = (j == k ? r[i] : 0.0f) + (i == k ? r[j] : 0.0f) + (i == j ? r[k] : 0.0f);
+                    local.third[kThird[i][j][k]] += g * m * (3.0f * deltas * inv5 - 15.0f * r[i] * r[j] * r[k] * inv7);
+                }
+            }
+        }
+    }
+
+    void NBodyGravity::interact(uint32_t targetIndex, uint32_t sourceIndex) {
+        const Node& target = nodes_[targetIndex];
+        const Node& source = nodes_[sourceIndex];
+        if (source.mass <= 0.0f) return;
+
+        // Well separated: the source's field expanded to second order about the target.
+        const glm::vec3 r = target.centerOfMass - source.centerOfMass;
+        const float reach = target.radius + source.radius;
+        if (reach * reach < settings_.theta * settings_.theta * glm::dot(r, r)) {
+            addMultipoleToLocal(locals_[targetIndex], source, r);
+            return;
+        }
+
+        if (target.childCount == 0 && source.childCount == 0) {
+            for (uint32_t i = target.begin; i < target.end; ++i) {
+                const glm::vec3 a = sumPoints(glm::vec3(px_[i], py_[i], pz_[i]), source);
+                ax_[i] += a.x;
+                ay_[i] += a.y;
+                az_[i] += a.z;
+            }
+            return;
+        }
+        // Open the bigger node.
+        if (source.childCount == 0 || (target.childCount != 0 && target.radius > source.radius)) {
+            for (uint32_t c = target.firstChild; c < target.firstChild + target.childCount; ++c) interact(c, sourceIndex);
+        } else {
+            for (uint32_t c = source.firstChild; c < source.firstChild + source.childCount; ++c) interact(targetIndex, c);
+        }
+    }
+
+} // namespace physics
@@ -0,0 +1,435 @@
+#include "physics/Narrowphase.h"
+#include "physics/Gjk.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace physics {
+
+    namespace {
+        using CollideFn = bool (*)(const ConvexInstance&, const ConvexInstance&, float, ContactManifold&);
+
+        // Below this core distance GJK's witness points are too noisy to give a normal; use EPA.
+        constexpr float kCoreTolerance = 1e-5f;
+
+        // Box-box feature id tags; the low bits hold face and vertex keys or the edge pair.
+        constexpr uint32_t kFeatureReferenceA = 1u << 30;
+        constexpr uint32_t kFeatureEdgePair = 1u << 31;
+        // Incident vertices this far outside a reference side plane still count as inside, so equal
+        // faces resting on each other keep their four corners (and feature ids) despite small tilts.
+        constexpr float kClipTolerance = 0.005f;
+
+        void addPoint(ContactManifold& manifold, const glm::vec3& position, float depth) {
+            manifold.points[0] = { position, depth };
+            manifold.pointCount = 1;
+        }
+
+        // Keeps at most four points: the deepest, the one farthest from it, and the two spanning
+        // the largest area on either side of that line.
+        void reducePoints(const ContactPoint* points, int count, const glm::vec3& normal, ContactManifold& manifold) {
+            if (count <= ContactManifold::kMaxPoints) {
+                std::copy(points, points + count, manifold.points);
+                manifold.pointCount = count;
+                return;
+            }
+            int deepest = 0;
+            for (int i = 1; i < count; ++i) {
+                if (points[i].depth > points[deepest].depth) deepest = i;
+            }
+            const glm::vec3 p0 = points[deepest].position;
+            int farthest = deepest;
+            float farthestDistance = -1.0f;
+            for (int i = 0; i < count; ++i) {
+                const glm::vec3 d = points[i].position - p0;
+                if (glm::dot(d, d) > farthestDistance) {
+                    farthestDistance = glm::dot(d, d);
+                    farthest = i;
+                }
+            }
+            const glm::vec3 edge = points[farthest].position - p0;
+            int left = deepest, right = deepest;
+            float leftArea = 0.0f, rightArea = 0.0f;
+            for (int i = 0; i < count; ++i) {
+                const float area = glm::dot(glm::cross(edge, points[i].position - p0), normal);
+                if (area > leftArea) { leftArea = area; left = i; }
+                if (area < rightArea) { rightArea = area; right = i; }
+            }
+            manifold.pointCount = 0;
+            for (int index : { deepest, farthest, left, right }) {
+                bool duplicate = false;
+                for (int k = 0; k < manifold.pointCount; ++k) duplicate |= manifold.points[k].position == points[index].position;
+                if (!duplicate) manifold.points[manifold.pointCount++] = points[index];
+            }
+        }
+
+        // Closest points between segments p1q1 and p2q2 (Ericson 5.1.9).
+        void closestSegmentPoints(const glm::vec3& p1, const glm::vec3& q1, const glm::vec3& p2, const glm::vec3& q2,
+                                  glm::vec3& c1, glm::vec3& c2) {
+            constexpr float kEpsilon = 1e-12f;
+            const glm::vec3 d1 = q1 - p1, d2 = q2 - p2, r = p1 - p2;
+            const float a = glm::dot(d1, d1), e = glm::dot(d2, d2), f = glm::dot(d2, r);
+            float s = 0.0f, t = 0.0f;
+            if (a <= kEpsilon && e <= kEpsilon) {
+                // Both degenerate to points.
+            }
+            else if (a <= kEpsilon) {
+                t = glm::clamp(f / e, 0.0f, 1.0f);
+            }
+            else {
+                const float c = glm::dot(d1, r);
+                if (e <= kEpsilon) {
+                    s = glm::clamp(-c / a, 0.0f, 1.0f);
+                }
+                else {
+                    const float b = glm::dot(d1, d2);
+                    const float denom = a * e - b * b;
+                    s = denom != 0.0f ? glm::clamp((b * f - c * e) / denom, 0.0f, 1.0f) : 0.0f;
+                    t = (b * s + f) / e;
+                    if (t < 0.0f) {
+                        t = 0.0f;
+                        s = glm::clamp(-c / a, 0.0f, 1.0f);
+                    }
+                    else if (t > 1.0f) {
+                        t = 1.0f;
+                        s = glm::clamp((b - c) / a, 0.0f, 1.0f);
+                    }
+                }
+            }
+            c1 = p1 + d1 * s;
+            c2 = p2 + d2 * t;
+        }
+
+        // Two round cores (points) with radii; shared by the sphere and capsule paths.
+        bool collideRoundPoints(const glm::vec3& centerA, float radiusA, const glm::vec3& centerB, float radiusB,
+                                float margin, ContactManifold& manifold) {
+            const glm::vec3 d = centerB - centerA;
+            const float distance = glm::length(d);
+            const float separation = distance - radiusA - radiusB;
+            if (separation > margin) return false;
+            const glm::vec3 normal = distance > 1e-6f ? d / distance : glm::vec3(0.0f, 1.0f, 0.0f);
+            const glm::vec3 surfaceA = centerA + normal * radiusA;
+            const glm::vec3 surfaceB = centerB - normal * radiusB;
+            manifold.normal = normal;
+            addPoint(manifold, (surfaceA + surfaceB) * 0.5f, -separation);
+            return true;
+        }
+
+        glm::vec3 capsuleEnd(const ConvexInstance& capsule, float sign) {
+            return capsule.position + capsule.orientation * glm::vec3(0.0f, sign * capsule.shape->halfHeight, 0.0f);
+        }
+
+        bool collideSpheres(const ConvexInstance& a, const ConvexInstance& b, float margin, ContactManifold& manifold) {
+            return collideRoundPoints(a.position, a.shape->radius, b.position, b.shape->radius, margin, manifold);
+        }
+
+        bool collideSphereCapsule(const ConvexInstance& a, const ConvexInstance& b, float margin, ContactManifold& manifold) {
+            glm::vec3 onSegment, unused;
+            closestSegmentPoints(capsuleEnd(b, -1.0f), capsuleEnd(b, 1.0f), a.position, a.position, onSegment, unused);
+            return collideRoundPoints(a.position, a.shape->radius, onSegment, b.shape->radius, margin, manifold);
+        }
+
+        bool collideCapsules(const ConvexInstance& a, const ConvexInstance& b, float margin, ContactManifold& manifold) {
+            const glm::vec3 a0 = capsuleEnd(a, -1.0f), a1 = capsuleEnd(a, 1.0f);
+            const glm::vec3 b0 = capsuleEnd(b, -1.0f), b1 = capsuleEnd(b, 1.0f);
+            glm::vec3 ca, cb;
+            closestSegmentPoints(a0, a1, b0, b1, ca, cb);
+            if (!collideRoundPoints(ca, a.shape->radius, cb, b.shape->radius, margin, manifold)) return false;
+
+            // Parallel capsules lying on each other: a second point from the other end keeps them from rocking.
+            const glm::vec3 axisA = glm::normalize(a1 - a0), axisB = glm::normalize(b1 - b0);
+            if (std::abs(glm::dot(axisA, axisB)) > 0.99f) {
+                ContactManifold second;
+                const glm::vec3 other = glm::dot(ca - a0, axisA) > glm::length(a1 - a0) * 0.5f ? a0 : a1;
+                glm::vec3 onB, unused;
+                closestSegmentPoints(b0, b1, other, other, onB, unused);
+                if (collideRoundPoints(other, a.shape->radius, onB, b.shape->radius, margin, second) &&
+                    glm::length(second.points[0].position - manifold.points[0].position) > 1e-3f) {
+                    second.points[0].feature = 1;
+                    manifold.points[manifold.pointCount++] = second.points[0];
+                }
+            }
+            return true;
+        }
+
+        bool collideSphereBox(const ConvexInstance& a, const ConvexInstance& b, float margin, ContactManifold& manifold) {
+            const glm::vec3 h = b.shape->halfExtents;
+            const float radius = a.shape->radius;
+            const glm::quat inverse = glm::conjugate(b.orientation);
+            const glm::vec3 local = inverse * (a.position - b.position);
+            const glm::vec3 clamped = glm::clamp(local, -h, h);
+
+            glm::vec3 normalLocal;
+            glm::vec3 boxPoint;
+            float separation;
+            if (!(local == clamped)) {
+                const glm::vec3 diff = local - clamped;
+                const float distance = glm::length(diff);
+                separation = distance - radius;
+                if (separation > margin) return false;
+                normalLocal = -diff / distance;
+                boxPoint = clamped;
+            }
+            else {
+                // Center inside the box: leave through the nearest face.
+                int axis = 0;
+                float best = std::numeric_limits<float>::max();
+                for (int i = 0; i < 3; ++i) {
+                    const float gap = h[i] - std::abs(local[i]);
+                    if (gap < best) {
+                        best = gap;
+                        axis = i;
+                    }
+                }
+                const float side = local[axis] >= 0.0f ? 1.0f : -1.0f;
+                normalLocal = glm::vec3(0.0f);
+                normalLocal[axis] = -side;
+                boxPoint = local;
+                boxPoint[axis] = side * h[axis];
+                separation = -(best + radius);
+            }
+            const glm::vec3 spherePoint = local + normalLocal * radius;
+            manifold.normal = b.orientation * normalLocal;
+            addPoint(manifold, b.position + b.orientation * ((boxPoint + spherePoint) * 0.5f), -separation);
+            return true;
+        }
+
+        // Face contact: clip the incident box face against the reference face's side planes.
+        void boxFaceContact(const glm::mat3& refAxes, const glm::vec3& refCenter, const glm::vec3& refHalf, int refAxis,
+                            const glm::mat3& incAxes, const glm::vec3& incCenter, const glm::vec3& incHalf,
+                            float margin, bool refIsA, ContactManifold& manifold) {
+            const glm::vec3 normal = refAxes[refAxis] * (glm::dot(incCenter - refCenter, refAxes[refAxis]) < 0.0f ? -1.0f : 1.0f);
+
+            // Incident face: the one most anti-parallel to the reference normal.
+            int incAxis = 0;
+            float bestDot = -1.0f;
+            for (int i = 0; i < 3; ++i) {
+                const float d = std::abs(glm::dot(incAxes[i], normal));
+                if (d > bestDot) {
+                    bestDot = d;
+                    incAxis = i;
+                }
+            }
+            const float incSign = glm::dot(incAxes[incAxis], normal) > 0.0f ? -1.0f : 1.0f;
+            const glm::vec3 faceCenter = incCenter + incAxes[incAxis] * (incSign * incHalf[incAxis]);
+            const glm::vec3 u = incAxes[(incAxis + 1) % 3] * incHalf[(incAxis + 1) % 3];
+            const glm::vec3 v = incAxes[(incAxis + 2) % 3] * incHalf[(incAxis + 2) % 3];
+
+            glm::vec3 polygon[8] = { faceCenter + u + v, faceCenter - u + v, faceCenter - u - v, faceCenter + u - v };
+            // Each vertex remembers where it came from: an incident face corner (0-3), or the
+            // crossing of a clip plane with the edge leaving an earlier vertex.
+            uint32_t keys[8] = { 0, 1, 2, 3 };
+            int count = 4;
+            glm::vec3 clipped[8];
+            uint32_t clippedKeys[8];
+            uint32_t plane = 0;
+            for (int side = 1; side <= 2; ++side) {
+                const int axis = (refAxis + side) % 3;
+                for (float sign : { 1.0f, -1.0f }) {
+                    const glm::vec3 planeNormal = refAxes[axis] * sign;
+                    const float offset = glm::dot(planeNormal, refCenter) + refHalf[axis] + kClipTolerance;
+                    ++plane;
+                    int out = 0;
+                    for (int i = 0; i < count; ++i) {
+                        const glm::vec3& p = polygon[i];
+                        const glm::vec3& q = polygon[(i + 1) % count];
+                        const float dp = glm::dot(planeNormal, p) - offset;
+                        const float dq = glm::dot(planeNormal, q) - offset;
+                        if (dp <= 0.0f && out < 8) {
+                            clippedKeys[out] = keys[i];
+                            clipped[out++] = p;
+                        }
+                        // Strict crossings only: a vertex lying on the plane is kept by its own iteration.
+                        if (((dp < 0.0f && dq > 0.0f) || (dp > 0.0f && dq < 0.0f)) && out < 8) {
+                            clippedKeys[out] = (plane << 4) | (keys[i] & 0xF);
+                            clipped[out++] = p + (q - p) * (dp / (dp - dq));
+                        }
+                    }
+                    count = out;
+                    std::copy(clipped, clipped + count, polygon);
+                    std::copy(clippedKeys, clippedKeys + count, keys);
+                    if (count == 0) return;
+                }
+            }
+
+            // Feature id: which box is the reference, both faces (axis and side), and the vertex key.
+            const uint32_t refFace = static_cast<uint32_t>(refAxis * 2) | (glm::dot(normal, refAxes[refAxis]) < 0.0f ? 1u : 0u);
+            const uint32_t incFace = static_cast<uint32_t>(incAxis * 2) | (incSign < 0.0f ? 1u : 0u);
+            const uint32_t faceFeature = (refIsA ? kFeatureReferenceA : 0u) | (refFace << 16) | (incFace << 8);
+
+            const float planeOffset = glm::dot(normal, refCenter) + refHalf[refAxis];
+            ContactPoint points[8];
+            int pointCount = 0;
+            for (int i = 0; i < count; ++i) {
+                const float separation = glm::dot(normal, polygon[i]) - planeOffset;
+                if (separation <= margin) {
+                    points[pointCount++] = { polygon[i] - normal * (separation * 0.5f), -separation, faceFeature | keys[i] };
+                }
+            }
+            manifold.normal = refIsA ? normal : -normal;
+            reducePoints(points, pointCount, normal, manifold);
+        }
+
+        bool collideBoxes(const ConvexInstance& a, const ConvexInstance& b, float margin, ContactManifold& manifold) {
+            const glm::mat3 ra = glm::mat3_cast(a.orientation);
+            const glm::mat3 rb = glm::mat3_cast(b.orientation);
+            const glm::vec3 ha = a.shape->halfExtents;
+            const glm::vec3 hb = b.shape->halfExtents;
+            const glm::vec3 d = b.position - a.position;
+
+            auto separationAlong = [&](const glm::vec3& n) {
+                float projection = 0.0f;
+                for (int i = 0; i < 3; ++i) {
+                    projection += ha[i] * std::abs(glm::dot(ra[i], n)) + hb[i] * std::abs(glm::dot(rb[i], n));
+                }
+                return std::abs(glm::dot(d, n)) - projection;
+            };
+
+            // Separating axis test over the 15 candidate axes, tracking the best of each kind.
+            float faceA = -std::numeric_limits<float>::max(), faceB = faceA, edge = faceA;
+            int faceAAxis = 0, faceBAxis = 0, edgeA = 0, edgeB = 0;
+            glm::vec3 edgeNormal(0.0f);
+            for (int i = 0; i < 3; ++i) {
+                const float sa = separationAlong(ra[i]);
+                if (sa > margin) return false;
+                if (sa > faceA) { faceA = sa; faceAAxis = i; }
+                const float sb = separationAlong(rb[i]);
+                if (sb > margin) return false;
+                if (sb > faceB) { faceB = sb; faceBAxis = i; }
+            }
+            for (int i = 0; i < 3; ++i) {
+                for (int j = 0; j < 3; ++j) {
+                    glm::vec3 n = glm::cross(ra[i], rb[j]);
+                    const float length = glm::length(n);
+                    if (length < 1e-5f) continue; // Parallel edges; covered by the face axes.
+                    n = n / length;
+                    const float s = separationAlong(n);
+                    if (s > margin) return false;
+                    if (s > edge) { edge = s; edgeA = i; edgeB = j; edgeNormal = n; }
+                }
+            }
+
+            // Face contacts give stable multi-point manifolds, so edges must win clearly. The
+            // relative slack scales with |separation| so it also holds for speculative (positive) gaps.
+            constexpr float kRelativeTolerance = 0.05f;
+            constexpr float kAbsoluteTolerance = 0.01f;
+            auto clearlyGreater = [](float s, float reference) {
+                return s > reference + kRelativeTolerance * std::abs(reference) + kAbsoluteTolerance;
+            };
+            const float bestFace = std::max(faceA, faceB);
+            if (clearlyGreater(edge, bestFace)) {
+                const glm::vec3 n = glm::dot(edgeNormal, d) < 0.0f ? -edgeNormal : edgeNormal;
+                glm::vec3 onA = a.position, onB = b.position;
+                for (int k = 0; k < 3; ++k) {
+                    if (k != edgeA) onA += ra[k] * (glm::dot(ra[k], n) > 0.0f ? ha[k] : -ha[k]);
+                    if (k != edgeB) onB += rb[k] * (glm::dot(rb[k], n) > 0.0f ? -hb[k] : hb[k]);
+                }
+                glm::vec3 ca, cb;
+                closestSegmentPoints(onA - ra[edgeA] * ha[edgeA], onA + ra[edgeA] * ha[edgeA],
+                                     onB - rb[edgeB] * hb[edgeB], onB + rb[edgeB] * hb[edgeB], ca, cb);
+                manifold.normal = n;
+                addPoint(manifold, (ca + cb) * 0.5f, -edge);
+                manifold.points[0].feature = kFeatureEdgePair | static_cast<uint32_t>(edgeA * 3 + edgeB);
+                return true;
+            }
+            if (clearlyGreater(faceB, faceA)) {
+                boxFaceContact(rb, b.position, hb, faceBAxis, ra, a.position, ha, margin, false, manifold);
+            }
+            else {
+                boxFaceContact(ra, a.position, ha, faceAAxis, rb, b.position, hb, margin, true, manifold);
+            }
+            return manifold.pointCount > 0;
+        }
+
+        // Any convex pair: GJK on the cores, EPA when the cores themselves overlap.
+        bool collideConvex(const ConvexInstance& a, const ConvexInstance& b, float margin, ContactManifold& manifold) {
+            const GjkResult gjk = gjkDistance(a, b);
+            const float radiusA = a.shape->coreRadius();
+            const float radiusB = b.shape->coreRadius();
+            if (!gjk.overlap && gjk.distance > kCoreTolerance) {
+                const float separation = gjk.distance - radiusA - radiusB;
+                if (separation > margin) return false;
+                const glm::vec3 normal = (gjk.pointB - gjk.pointA) / gjk.distance;
+                const glm::vec3 surfaceA = gjk.pointA + normal * radiusA;
+                const glm::vec3 surfaceB = gjk.pointB - normal * radiusB;
+                manifold.normal = normal;
+                addPoint(manifold, (surfaceA + surfaceB) * 0.5f, -separation);
+                return true;
+            }
+
+            EpaResult epa;
+            if (!epaPenetration(a, b, epa)) {
+                // Exactly touching; any normal along the center line will do.
+                const glm::vec3 d = b.position - a.position;
+                const float length = glm::length(d);
+                manifold.normal = length > 1e-6f ? d / length : glm::vec3(0.0f, 1.0f, 0.0f);
+                addPoint(manifold, (a.position + b.position) * 0.5f, 0.0f);
+                return true;
+            }
+            manifold.normal = epa.normal;
+            addPoint(manifold, (epa.pointA + epa.pointB) * 0.5f, epa.depth);
+            return true;
+        }
+
+        // Dedicated routines by shape pair. Only one order is specialised; the table flips the other.
+        template <ShapeType A, ShapeType B>
+        struct FastPath : std::false_type {};
+
+        template <>
+        struct FastPath<ShapeType::Sphere, ShapeType::Sphere> : std::true_type {
+            static constexpr CollideFn run = &collideSpheres;
+        };
+        template <>
+        struct FastPath<ShapeType::Sphere, ShapeType::Box> : std::true_type {
+            static constexpr CollideFn run = &collideSphereBox;
+        };
+        template <>
+        struct FastPath<ShapeType::Sphere, ShapeType::Capsule> : std::true_type {
+            static constexpr CollideFn run = &collideSphereCapsule;
+        };
+        template <>
+        struct FastPath<ShapeType::Capsule, ShapeType::Capsule> : std::true_type {
+            static constexpr CollideFn run = &collideCapsules;
+        };
+        template <>
+        struct FastPath<ShapeType::Box, ShapeType::Box> : std::true_type {
+            static constexpr CollideFn run = &collideBoxes;
+        };
+
+        template <ShapeType A, ShapeType B>
+        bool collidePair(const ConvexInstance& a, const ConvexInstance& b, float margin, ContactManifold& manifold) {
+            if constexpr (FastPath<A, B>::value) {
+                return FastPath<A, B>::run(a, b, margin, manifold);
+            }
+            else if constexpr (FastPath<B, A>::value) {
+                if (!FastPath<B, A>::run(b, a, margin, manifold)) return false;
+                manifold.normal = -manifold.normal;
+                return true;
+            }
+            else {
+                return collideConvex(a, b, margin, manifold);
+            }
+        }
+
+        template <size_t... I>
+        constexpr std::array<CollideFn, sizeof...(I)> makeCollideTable(std::index_sequence<I...>) {
+            return { { &collidePair<static_cast<ShapeType>(I / kShapeTypeCount), static_cast<ShapeType>(I % kShapeTypeCount)>... } };
+        }
+
+        constexpr auto kCollideTable = makeCollideTable(std::make_index_sequence<kShapeTypeCount * kShapeTypeCount>{});
+    }
+
+    bool collide(const Shape& shapeA, const glm::vec3& positionA, const glm::quat& orientationA,
+                 const Shape& shapeB, const glm::vec3& positionB, const glm::quat& orientationB,
+                 float margin, ContactManifold& manifold) {
+        manifold.pointCount = 0;
+        const ConvexInstance a{ &shapeA, positionA, orientationA };
+        const ConvexInstance b{ &shapeB, positionB, orientationB };
+        const size_t index = static_cast<size_t>(shapeA.type) * kShapeTypeCount + static_cast<size_t>(shapeB.type);
+        if (index >= kCollideTable.size()) return false;
+        return kCollideTable[index](a, b, margin, manifold);
+    }
+
+} // namespace physics
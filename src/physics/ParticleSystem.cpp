@@ -0,0 +1,348 @@
+#include "physics/ParticleSystem.h"
+#include "physics/SimdFloat.h"
+#include "physics/VectorField.h"
+#include "utils/JobSystem.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+
+namespace physics {
+
+    namespace {
+        constexpr size_t kChunkSize = 1024;
+        constexpr int W = SimdFloat::kWidth;
+
+        // PCG output hash; spawn index and seed pick a stream, so emission can run in parallel
+        // and still give every particle the same numbers.
+        uint32_t hash(uint32_t x) {
+            const uint32_t state = x * 747796405u + 2891336453u;
+            const uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+            return (word >> 22u) ^ word;
+        }
+
+        struct Random {
+            uint32_t state;
+            Random(uint32_t seed, uint32_t index) : state(hash(seed ^ hash(index))) {}
+            // Uniform in [0, 1).
+            float next() {
+                state = hash(state);
+                return static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+            }
+            float signedNext() { return 2.0f * next() - 1.0f; }
+        };
+
+        ParticleEmitterDesc sanitized(const ParticleEmitterDesc& desc) {
+            ParticleEmitterDesc result = desc;
+            result.rate = std::max(result.rate, 0.0f);
+            result.minLifetime = std::max(result.minLifetime, 1e-3f);
+            result.maxLifetime = std::max(result.maxLifetime, result.minLifetime);
+            result.drag = std::max(result.drag, 0.0f);
+            result.capacity = std::max(result.capacity, 1u);
+            return result;
+        }
+    }
+
+    void ParticleSystem::Columns::resize(size_t size) {
+        // Padded to a whole vector, so the last block of a kernel can load past the end.
+        for (auto* column : { &x, &y, &z, &vx, &vy, &vz, &life, &lifeRate }) column->resize(size + W);
+    }
+
+    uint32_t ParticleSystem::addEmitter(const ParticleEmitterDesc& desc) {
+        auto slot = std::find_if(emitters_.begin(), emitters_.end(), [](const Emitter& e) { return e.removed; });
+        if (slot == emitters_.end()) slot = emitters_.emplace(emitters_.end());
+        *slot = Emitter{};
+        const auto index = static_cast<uint32_t>(slot - emitters_.begin());
+        setEmitter(index, desc);
+        return index;
+    }
+
+    void ParticleSystem::setEmitter(uint32_t emitter, const ParticleEmitterDesc& desc) {
+        Emitter& e = emitters_[emitter];
+        const uint32_t previous = e.desc.capacity;
+        e.desc = sanitized(desc);
+        if (e.live.x.empty() || e.desc.capacity != previous) {
+            e.live.resize(e.desc.capacity);
+            e.spare.resize(e.desc.capacity);
+            e.ax.clear();
+            e.ay.clear();
+            e.az.clear();
+            e.accelerated = false;
+            e.count = std::min<size_t>(e.count, e.desc.capacity);
+        }
+    }
+
+    void ParticleSystem::removeEmitter(uint32_t emitter) {
+        emitters_[emitter] = Emitter{};
+        emitters_[emitter].removed = true;
+        emitters_[emitter].emitting = false;
+    }
+
+    void ParticleSystem::burst(uint32_t emitter, uint32_t count) {
+        emitters_[emitter].pendingBurst += count;
+    }
+
+    void ParticleSystem::clear() {
+        emitters_.clear();
+        chunks_.clear();
+    }
+
+    size_t ParticleSystem::size() const {
+        size_t total = 0;
+        for (const Emitter& e : emitters_) total += e.count;
+        return total;
+    }
+
+    void ParticleSystem::collectChunks(std::vector<Chunk>& chunks) const {
+        chunks.clear();
+        for (uint32_t e = 0; e < emitters_.size(); ++e) {
+            const auto count = static_cast<uint32_t>(emitters_[e].count);
+            for (uint32_t begin = 0; begin < count; begin += kChunkSize) {
+                chunks.push_back({ e, begin, std::min<uint32_t>(begin + kChunkSize, count), 0 });
+            }
+        }
+    }
+
+    template <typename Kernel>
+    void ParticleSystem::forEachChunk(Kernel&& kernel) const {
+        std::vector<Chunk> chunks;
+        collectChunks(chunks);
+        utils::JobSystem::getInstance().parallelFor(chunks.size(), [&](size_t c) {
+            kernel(chunks[c].emitter, chunks[c].begin, chunks[c].end);
+        });
+    }
+
+    void ParticleSystem::applyAccelerationField(const VectorField& field, float scale) {
+        for (Emitter& e : emitters_) {
+            if (e.count == 0 || e.accelerated) continue;
+            // First field this step: the columns are overwritten rather than cleared and added to.
+            e.ax.resize(e.desc.capacity + W);
+            e.ay.resize(e.desc.capacity + W);
+            e.az.resize(e.desc.capacity + W);
+        }
+        forEachChunk([&](uint32_t emitter, uint32_t begin, uint32_t end) {
+            Emitter& e = emitters_[emitter];
+            std::array<float, kChunkSize> fx, fy, fz;
+            field.sample(e.live.x.data() + begin, e.live.y.data() + begin, e.live.z.data() + begin, end - begin,
+                         fx.data(), fy.data(), fz.data());
+            for (uint32_t i = begin; i < end; ++i) {
+                const uint32_t k = i - begin;
+                if (e.accelerated) {
+                    e.ax[i] += fx[k] * scale;
+                    e.ay[i] += fy[k] * scale;
+                    e.az[i] += fz[k] * scale;
+                }
+                else {
+                    e.ax[i] = fx[k] * scale;
+                    e.ay[i] = fy[k] * scale;
+                    e.az[i] = fz[k] * scale;
+                }
+            }
+        });
+        for (Emitter& e : emitters_) e.accelerated = e.accelerated || e.count > 0;
+    }
+
+    void ParticleSystem::step(float dt) {
+        if (dt <= 0.0f) return;
+        integrate(dt);
+        for (Emitter& e : emitters_) {
+            e.accelerated = false;
+            if (!e.removed) emit(e, dt);
+        }
+    }
+
+    void ParticleSystem::integrate(float dt) {
+        collectChunks(chunks_);
+        if (chunks_.empty()) return;
+        utils::JobSystem& jobs = utils::JobSystem::getInstance();
+
+        // Age everything and count the survivors. The kernel below reads back the stored ages,
+        // so both passes agree on who died to the bit.
+        const SimdFloat step = SimdFloat::splat(dt);
+        jobs.parallelFor(chunks_.size(), [&](size_t c) {
+            Chunk& chunk = chunks_[c];
+            Columns& live = emitters_[chunk.emitter].live;
+            for (uint32_t i = chunk.begin; i < chunk.end; i += W) {
+                (SimdFloat::load(live.life.data() + i) + SimdFloat::load(live.lifeRate.data() + i) * step).store(live.life.data() + i);
+            }
+            uint32_t survivors = 0;
+            for (uint32_t i = chunk.begin; i < chunk.end; ++i) survivors += live.life[i] < 1.0f;
+            chunk.survivors = survivors;
+        });
+
+        // Exclusive scan per emitter: each chunk's survivors go right after the previous chunk's.
+        std::vector<uint32_t> counts(emitters_.size(), 0);
+        for (Chunk& chunk : chunks_) {
+            const uint32_t survivors = chunk.survivors;
+            chunk.survivors = counts[chunk.emitter];
+            counts[chunk.emitter] += survivors;
+        }
+
+        jobs.parallelFor(chunks_.size(), [&](size_t c) {
+            const Chunk& chunk = chunks_[c];
+            Emitter& e = emitters_[chunk.emitter];
+            const Columns& in = e.live;
+            Columns& out = e.spare;
+            const glm::vec3 g = gravity_ * e.desc.gravityScale;
+            const SimdFloat gx = SimdFloat::splat(g.x), gy = SimdFloat::splat(g.y), gz = SimdFloat::splat(g.z);
+            const SimdFloat keep = SimdFloat::splat(std::max(1.0f - e.desc.drag * dt, 0.0f));
+            alignas(32) float block[6][W];
+            uint32_t next = chunk.survivors;
+            for (uint32_t i = chunk.begin; i < chunk.end; i += W) {
+                SimdVec3 v{ SimdFloat::load(in.vx.data() + i), SimdFloat::load(in.vy.data() + i), SimdFloat::load(in.vz.data() + i) };
+                SimdVec3 a{ gx, gy, gz };
+                if (e.accelerated) {
+                    a += SimdVec3{ SimdFloat::load(e.ax.data() + i), SimdFloat::load(e.ay.data() + i), SimdFloat::load(e.az.data() + i) };
+                }
+                v = (v + a * step) * keep;
+                const SimdVec3 x = SimdVec3{ SimdFloat::load(in.x.data() + i), SimdFloat::load(in.y.data() + i),
+                                             SimdFloat::load(in.z.data() + i) } + v * step;
+
+                const uint32_t lanes = std::min<uint32_t>(W, chunk.end - i);
+                bool allAlive = lanes == W;
+                for (uint32_t lane = 0; lane < lanes && allAlive; ++lane) allAlive = in.life[i + lane] < 1.0f;
+                if (allAlive) {
+                    x.x.store(out.x.data() + next);
+                    x.y.store(out.y.data() + next);
+                    x.z.store(out.z.data() + next);
+                    v.x.store(out.vx.data() + next);
+                    v.y.store(out.vy.data() + next);
+                    v.z.store(out.vz.data() + next);
+                    SimdFloat::load(in.life.data() + i).store(out.life.data() + next);
+                    SimdFloat::load(in.lifeRate.data() + i).store(out.lifeRate.data() + next);
+                    next += W;
+                    continue;
+                }
+                x.x.store(block[0]);
+                x.y.store(block[1]);
+                x.z.store(block[2]);
+                v.x.store(block[3]);
+                v.y.store(block[4]);
+                v.z.store(block[5]);
+                for (uint32_t lane = 0; lane < lanes; ++lane) {
+                    if (in.life[i + lane] >= 1.0f) continue;
+                    out.x[next] = block[0][lane];
+                    out.y[next] = block[1][lane];
+                    out.z[next] = block[2][lane];
+                    out.vx[next] = block[3][lane];
+                    out.vy[next] = block[4][lane];
+                    out.vz[next] = block[5][lane];
+                    out.life[next] = in.life[i + lane];
+                    out.lifeRate[next] = in.lifeRate[i + lane];
+                    ++next;
+                }
+            }
+        });
+
+        for (uint32_t e = 0; e < emitters_.size(); ++e) {
+            Emitter& emitter = emitters_[e];
+            if (emitter.count == 0) continue;
+            std::swap(emitter.live, emitter.spare);
+            emitter.count = counts[e];
+        }
+    }
+
+    void ParticleSystem::emit(Emitter& e, float dt) {
+        const ParticleEmitterDesc& desc = e.desc;
+        uint32_t continuous = 0;
+        if (e.emitting) {
+            const float wanted = desc.rate * dt + e.spawnDebt;
+            continuous = static_cast<uint32_t>(wanted);
+            e.spawnDebt = wanted - static_cast<float>(continuous);
+        }
+        else {
+            e.spawnDebt = 0.0f;
+        }
+        const auto room = static_cast<uint32_t>(desc.capacity - e.count);
+        continuous = std::min(continuous, room);
+        const uint32_t bursts = std::min(e.pendingBurst, room - continuous);
+        e.pendingBurst = 0;
+        const uint32_t total = continuous + bursts;
+        if (total == 0) return;
+
+        // Continuous particles are spread evenly over the step, oldest first, so high rates
+        // stream instead of leaving in pulses. Burst particles all start now.
+        const size_t first = e.count;
+        const uint32_t spawned = e.spawned;
+        Columns& c = e.live;
+        const size_t jobs = (total + kChunkSize - 1) / kChunkSize;
+        utils::JobSystem::getInstance().parallelFor(jobs, [&](size_t job) {
+            const uint32_t begin = static_cast<uint32_t>(job * kChunkSize);
+            const uint32_t end = std::min<uint32_t>(begin + static_cast<uint32_t>(kChunkSize), total);
+            for (uint32_t k = begin; k < end; ++k) {
+                Random random(desc.seed, spawned + k);
+                const glm::vec3 offset(random.signedNext(), random.signedNext(), random.signedNext());
+                const glm::vec3 jitter(random.signedNext(), random.signedNext(), random.signedNext());
+                const float lifetime = desc.minLifetime + (desc.maxLifetime - desc.minLifetime) * random.next();
+                const float age = k < continuous ? (static_cast<float>(continuous - k) - 0.5f) / static_cast<float>(continuous) * dt : 0.0f;
+                const glm::vec3 v = desc.velocity + desc.velocitySpread * jitter;
+                const glm::vec3 p = desc.position + desc.extents * offset + v * age;
+                const size_t i = first + k;
+                c.x[i] = p.x;
+                c.y[i] = p.y;
+                c.z[i] = p.z;
+                c.vx[i] = v.x;
+                c.vy[i] = v.y;
+                c.vz[i] = v.z;
+                c.lifeRate[i] = 1.0f / lifetime;
+                c.life[i] = age * c.lifeRate[i];
+            }
+        });
+        e.count += total;
+        e.spawned += total;
+    }
+
+    size_t ParticleSystem::writeInstances(ParticleInstance* out, size_t capacity) const {
+        std::vector<size_t> base(emitters_.size() + 1, 0);
+        for (size_t e = 0; e < emitters_.size(); ++e) base[e + 1] = base[e] + emitters_[e].count;
+        const size_t written = std::min(base.back(), capacity);
+
+        forEachChunk([&](uint32_t emitter, uint32_t begin, uint32_t end) {
+            const size_t first = base[emitter] + begin;
+            if (first >= written) return;
+            end = static_cast<uint32_t>(std::min<size_t>(end, begin + (written - first)));
+            const Emitter& e = emitters_[emitter];
+            const Columns& c = e.live;
+            const ParticleEmitterDesc& desc = e.desc;
+            // Colour channels go from 0..1 to 0..255 up front, with the rounding offset folded in.
+            const float from[4] = { desc.startColor.x, desc.startColor.y, desc.startColor.z, desc.startColor.w };
+            const float to[4] = { desc.endColor.x, desc.endColor.y, desc.endColor.z, desc.endColor.w };
+            SimdFloat colorStart[4], colorDelta[4];
+            for (int k = 0; k < 4; ++k) {
+                colorStart[k] = SimdFloat::splat(from[k] * 255.0f + 0.5f);
+                colorDelta[k] = SimdFloat::splat((to[k] - from[k]) * 255.0f);
+            }
+            const SimdFloat sizeStart = SimdFloat::splat(desc.startSize);
+            const SimdFloat sizeDelta = SimdFloat::splat(desc.endSize - desc.startSize);
+            const SimdFloat low = SimdFloat::splat(0.0f), high = SimdFloat::splat(255.5f);
+            alignas(32) float size[W];
+            alignas(32) int32_t channel[4][W];
+            ParticleInstance* target = out + first;
+            for (uint32_t i = begin; i < end; i += W) {
+                const SimdFloat t = SimdFloat::load(c.life.data() + i);
+                (sizeStart + sizeDelta * t).store(size);
+                for (int k = 0; k < 4; ++k) {
+                    const SimdFloat value = colorStart[k] + colorDelta[k] * t;
+                    min(max(value, low), high).storeTruncated(channel[k]);
+                }
+                const uint32_t lanes = std::min<uint32_t>(W, end - i);
+                for (uint32_t lane = 0; lane < lanes; ++lane) {
+                    ParticleInstance& instance = *target++;
+                    instance.x = c.x[i + lane];
+                    instance.y = c.y[i + lane];
+                    instance.z = c.z[i + lane];
+                    instance.size = size[lane];
+                    instance.color = static_cast<uint32_t>(channel[0][lane]) | (static_cast<uint32_t>(channel[1][lane]) << 8) |
+                                     (static_cast<uint32_t>(channel[2][lane]) << 16) | (static_cast<uint32_t>(channel[3][lane]) << 24);
+                }
+            }
+        });
+        return written;
+    }
+
+    size_t ParticleSystem::writeInstances(std::vector<ParticleInstance>& out) const {
+        out.resize(size());
+        return writeInstances(out.data(), out.size());
+    }
+
+} // namespace physics
@@ -0,0 +1,14 @@
+#include "physics/PhysicsBody.h"
+
+namespace physics {
+
+    PhysicsBody PhysicsBody::create(PhysicsWorld& world, const BodyDesc& desc) {
+        return PhysicsBody(world, world.createBody(desc));
+    }
+
+    void PhysicsBody::destroy() {
+        if (world_) world_->destroyBody(handle_);
+        handle_ = BodyHandle{};
+    }
+
+} // namespace physics
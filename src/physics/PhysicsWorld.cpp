@@ -0,0 +1,794 @@
+#include "physics/PhysicsWorld.h"
+#include "physics/DynamicAabbTree.h"
+#include "physics/HashGridBroadphase.h"
+#include "physics/SweepAndPrune.h"
+#include "physics/TimeOfImpact.h"
+#include "physics/VectorField.h"
+#include "utils/JobSystem.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <iterator>
+#include <utility>
+
+namespace physics {
+
+    namespace {
+        std::unique_ptr<IBroadphase> makeBroadphase(BroadphaseType type) {
+            switch (type) {
+                case BroadphaseType::AabbTree: break;
+                case BroadphaseType::SweepAndPrune: return std::make_unique<SweepAndPrune>();
+                case BroadphaseType::HashGrid: return std::make_unique<HashGridBroadphase>();
+            }
+            return std::make_unique<DynamicAabbTree>();
+        }
+    }
+
+    PhysicsWorld::PhysicsWorld()
+        : broadphase_(makeBroadphase(BroadphaseType::AabbTree)) {
+        bodies_.reserve(kChunkSize);
+    }
+
+    BodyHandle PhysicsWorld::createBody(const BodyDesc& desc) {
+        uint32_t id;
+        if (!freeSlots_.empty()) {
+            id = freeSlots_.back();
+            freeSlots_.pop_back();
+        }
+        else {
+            id = static_cast<uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+
+        const size_t index = bodies_.push();
+        const bool isStatic = (desc.flags & kBodyStatic) != 0 || desc.mass <= 0.0f;
+        auto inverse = [](float value) { return value > 0.0f ? 1.0f / value : 0.0f; };
+
+        bodies_.setPosition(index, desc.position);
+        bodies_.setOrientation(index, glm::normalize(desc.orientation));
+        bodies_.setVelocity(index, isStatic ? glm::vec3(0.0f) : desc.velocity);
+        bodies_.setAngularVelocity(index, isStatic ? glm::vec3(0.0f) : desc.angularVelocity);
+        bodies_.inverseMass[index] = isStatic ? 0.0f : inverse(desc.mass);
+        const glm::vec3 inertia = desc.inertia.value_or(desc.shape.computeInertia(desc.mass));
+        bodies_.inverseInertiaX[index] = isStatic ? 0.0f : inverse(inertia.x);
+        bodies_.inverseInertiaY[index] = isStatic ? 0.0f : inverse(inertia.y);
+        bodies_.inverseInertiaZ[index] = isStatic ? 0.0f : inverse(inertia.z);
+        bodies_.flags[index] = isStatic ? ((desc.flags | kBodyStatic) & ~kBodySleeping) : desc.flags;
+        bodies_.shapes[index] = desc.shape;
+        bodies_.storePreviousTransform(index);
+
+        slots_[id].dense = static_cast<uint32_t>(index);
+        slots_[id].proxy = broadphase_->createProxy(desc.shape.computeAabb(desc.position, bodies_.orientation(index)), id);
+        const BodyHandle handle{ id, slots_[id].generation };
+        denseToHandle_.push_back(handle);
+
+        // New bodies land past the awake range; move awake ones into it.
+        if (bodies_.flags[index] & kBodySleeping) {
+            bodies_.flags[index] &= ~kBodySleeping;
+            sleepIsland({ id });
+        }
+        else if (!isStatic) {
+            activate(index);
+        }
+        return handle;
+    }
+
+    bool PhysicsWorld::destroyBody(BodyHandle handle) {
+        auto index = indexOf(handle);
+        if (!index) {
+            spdlog::warn("PhysicsWorld: destroyBody called with a stale handle ({}:{})", handle.id, handle.generation);
+            return false;
+        }
+
+        // Whatever rested on the body has to react to it disappearing.
+        wakeIsland(handle.id);
+        wakeTouching(handle.id);
+
+        // Keep the columns packed: step out of the awake range, then the last body moves into the hole.
+        size_t dense = slots_[handle.id].dense;
+        if (dense < activeCount_) {
+            deactivate(dense);
+            dense = activeCount_;
+        }
+        const size_t last = bodies_.size() - 1;
+        bodies_.swapRemove(dense);
+        if (dense != last) {
+            denseToHandle_[dense] = denseToHandle_[last];
+            slots_[denseToHandle_[dense].id].dense = static_cast<uint32_t>(dense);
+        }
+        denseToHandle_.pop_back();
+
+        Slot& slot = slots_[handle.id];
+        broadphase_->destroyProxy(slot.proxy);
+        slot.proxy = kInvalidProxy;
+        std::erase_if(pairs_, [&](const BroadphasePair& pair) { return pair.a == handle.id || pair.b == handle.id; });
+        contactCache_.eraseBody(handle.id);
+        slot.dense = UINT32_MAX;
+        ++slot.generation;
+        freeSlots_.push_back(handle.id);
+        return true;
+    }
+
+    bool PhysicsWorld::isValid(BodyHandle handle) const {
+        return indexOf(handle).has_value();
+    }
+
+    std::optional<size_t> PhysicsWorld::indexOf(BodyHandle handle) const {
+        if (handle.id >= slots_.size()) return std::nullopt;
+        const Slot& slot = slots_[handle.id];
+        if (slot.generation != handle.generation || slot.dense == UINT32_MAX) return std::nullopt;
+        return slot.dense;
+    }
+
+    glm::vec3 PhysicsWorld::getPosition(BodyHandle handle) const {
+        auto index = indexOf(handle);
+        return index ? bodies_.position(*index) : glm::vec3(0.0f);
+    }
+
+    void PhysicsWorld::setPosition(BodyHandle handle, const glm::vec3& position) {
+        if (!isValid(handle)) return;
+        wakeIsland(handle.id);
+        wakeTouching(handle.id);
+        auto index = indexOf(handle);
+        bodies_.setPosition(*index, position);
+        bodies_.storePreviousTransform(*index);
+        // Teleports (including of static bodies) update the broadphase right away.
+        broadphase_->moveProxy(slots_[handle.id].proxy,
+                               bodies_.shapes[*index].computeAabb(position, bodies_.orientation(*index)), glm::vec3(0.0f));
+    }
+
+    glm::quat PhysicsWorld::getOrientation(BodyHandle handle) const {
+        auto index = indexOf(handle);
+        return index ? bodies_.orientation(*index) : glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    void PhysicsWorld::setOrientation(BodyHandle handle, const glm::quat& orientation) {
+        if (!isValid(handle)) return;
+        wakeIsland(handle.id);
+        wakeTouching(handle.id);
+        auto index = indexOf(handle);
+        bodies_.setOrientation(*index, glm::normalize(orientation));
+        bodies_.storePreviousTransform(*index);
+        broadphase_->moveProxy(slots_[handle.id].proxy,
+                               bodies_.shapes[*index].computeAabb(bodies_.position(*index), bodies_.orientation(*index)), glm::vec3(0.0f));
+    }
+
+    glm::vec3 PhysicsWorld::getVelocity(BodyHandle handle) const {
+        auto index = indexOf(handle);
+        return index ? bodies_.velocity(*index) : glm::vec3(0.0f);
+    }
+
+    void PhysicsWorld::setVelocity(BodyHandle handle, const glm::vec3& velocity) {
+        wakeBody(handle);
+        if (auto index = indexOf(handle)) bodies_.setVelocity(*index, velocity);
+    }
+
+    glm::vec3 PhysicsWorld::getAngularVelocity(BodyHandle handle) const {
+        auto index = indexOf(handle);
+        return index ? bodies_.angularVelocity(*index) : glm::vec3(0.0f);
+    }
+
+    void PhysicsWorld::setAngularVelocity(BodyHandle handle, const glm::vec3& angularVelocity) {
+        wakeBody(handle);
+        if (auto index = indexOf(handle)) bodies_.setAngularVelocity(*index, angularVelocity);
+    }
+
+    void PhysicsWorld::applyForce(BodyHandle handle, const glm::vec3& force) {
+        wakeBody(handle);
+        auto index = indexOf(handle);
+        if (!index) return;
+        bodies_.forceX[*index] += force.x;
+        bodies_.forceY[*index] += force.y;
+        bodies_.forceZ[*index] += force.z;
+    }
+
+    void PhysicsWorld::applyForceAtPoint(BodyHandle handle, const glm::vec3& force, const glm::vec3& worldPoint) {
+        wakeBody(handle);
+        auto index = indexOf(handle);
+        if (!index) return;
+        applyForce(handle, force);
+        applyTorque(handle, glm::cross(worldPoint - bodies_.position(*index), force));
+    }
+
+    void PhysicsWorld::applyTorque(BodyHandle handle, const glm::vec3& torque) {
+        wakeBody(handle);
+        auto index = indexOf(handle);
+        if (!index) return;
+        bodies_.torqueX[*index] += torque.x;
+        bodies_.torqueY[*index] += torque.y;
+        bodies_.torqueZ[*index] += torque.z;
+    }
+
+    void PhysicsWorld::applyImpulse(BodyHandle handle, const glm::vec3& impulse) {
+        wakeBody(handle);
+        auto index = indexOf(handle);
+        if (!index) return;
+        const float invMass = bodies_.inverseMass[*index];
+        bodies_.setVelocity(*index, bodies_.velocity(*index) + impulse * invMass);
+    }
+
+    uint32_t PhysicsWorld::getFlags(BodyHandle handle) const {
+        auto index = indexOf(handle);
+        return index ? bodies_.flags[*index] : 0u;
+    }
+
+    template <typename Kernel>
+    void PhysicsWorld::forEachChunk(Kernel&& kernel) {
+        const size_t count = activeCount_;
+        const size_t chunks = (count + kChunkSize - 1) / kChunkSize;
+        utils::JobSystem::getInstance().parallelFor(chunks, [&](size_t chunk) {
+            const size_t begin = chunk * kChunkSize;
+            kernel(begin, std::min(begin + kChunkSize, count));
+        });
+    }
+
+    void PhysicsWorld::addForceProvider(std::shared_ptr<IForceProvider> provider) {
+        if (!provider) {
+            spdlog::warn("PhysicsWorld: addForceProvider called with null");
+            return;
+        }
+        forceProviders_.push_back(std::move(provider));
+    }
+
+    void PhysicsWorld::removeForceProvider(const IForceProvider* provider) {
+        std::erase_if(forceProviders_, [provider](const auto& p) { return p.get() == provider; });
+    }
+
+    void PhysicsWorld::applyAccelerationField(const VectorField& field, float scale) {
+        BodyStorage& b = bodies_;
+        forEachChunk([&](size_t begin, size_t end) {
+            std::array<float, kChunkSize> ax, ay, az;
+            field.sample(b.positionX.data() + begin, b.positionY.data() + begin, b.positionZ.data() + begin, end - begin,
+                         ax.data(), ay.data(), az.data());
+            for (size_t i = begin; i < end; ++i) {
+                if ((b.flags[i] & kBodyKinematic) || b.inverseMass[i] <= 0.0f) continue;
+                const float massScale = scale / b.inverseMass[i];
+                b.forceX[i] += ax[i - begin] * massScale;
+                b.forceY[i] += ay[i - begin] * massScale;
+                b.forceZ[i] += az[i - begin] * massScale;
+            }
+        });
+    }
+
+    void PhysicsWorld::step(float dt) {
+        if (dt <= 0.0f || bodies_.size() == 0) return;
+        lastStepDt_ = dt;
+        storePreviousTransforms();
+        for (const auto& provider : forceProviders_) provider->applyForces(bodies_, activeCount_);
+        integrateVelocities(dt);
+        solveContacts(dt);
+        integratePositions(dt);
+        solveTimeOfImpact();
+        synchronizeBroadphase(dt);
+        updateContacts();
+        clearForces();
+        updateIslands();
+        if (deterministic_) stepChecksum_ = computeChecksum();
+    }
+
+    void PhysicsWorld::setDeterministic(bool enabled) {
+        deterministic_ = enabled;
+        stepChecksum_ = 0;
+    }
+
+    uint64_t PhysicsWorld::computeChecksum() const {
+        // FNV-1a over 32-bit words per chunk of ids, then over the chunk hashes in order, so the
+        // result doesn't depend on the worker count.
+        constexpr uint64_t kOffset = 0xcbf29ce484222325ull;
+        constexpr uint64_t kPrime = 0x100000001b3ull;
+        const auto mix = [](uint64_t hash, uint32_t word) { return (hash ^ word) * kPrime; };
+        const auto mixFloat = [&](uint64_t hash, float value) { return mix(hash, std::bit_cast<uint32_t>(value)); };
+
+        const BodyStorage& b = bodies_;
+        const size_t chunks = (slots_.size() + kChunkSize - 1) / kChunkSize;
+        std::vector<uint64_t> chunkHashes(chunks);
+        utils::JobSystem::getInstance().parallelFor(chunks, [&](size_t chunk) {
+            uint64_t hash = kOffset;
+            const size_t end = std::min(slots_.size(), (chunk + 1) * kChunkSize);
+            for (size_t id = chunk * kChunkSize; id < end; ++id) {
+                const size_t i = slots_[id].dense;
+                if (i == UINT32_MAX) continue;
+                hash = mix(hash, static_cast<uint32_t>(id));
+                hash = mix(hash, slots_[id].generation);
+                hash = mix(hash, b.flags[i]);
+                for (const float value : { b.positionX[i], b.positionY[i], b.positionZ[i],
+                                           b.orientationW[i], b.orientationX[i], b.orientationY[i], b.orientationZ[i],
+                                           b.velocityX[i], b.velocityY[i], b.velocityZ[i],
+                                           b.angularVelocityX[i], b.angularVelocityY[i], b.angularVelocityZ[i] }) {
+                    hash = mixFloat(hash, value);
+                }
+            }
+            chunkHashes[chunk] = hash;
+        });
+
+        uint64_t hash = kOffset;
+        for (const uint64_t chunkHash : chunkHashes) {
+            hash = mix(mix(hash, static_cast<uint32_t>(chunkHash)), static_cast<uint32_t>(chunkHash >> 32));
+        }
+        return hash;
+    }
+
+    void PhysicsWorld::setBroadphase(BroadphaseType type) {
+        broadphaseType_ = type;
+        broadphase_ = makeBroadphase(type);
+        pairs_.clear();
+        for (size_t i = 0; i < bodies_.size(); ++i) {
+            const uint32_t id = denseToHandle_[i].id;
+            slots_[id].proxy = broadphase_->createProxy(bodies_.shapes[i].computeAabb(bodies_.position(i), bodies_.orientation(i)), id);
+        }
+        updatePairs();
+    }
+
+    void PhysicsWorld::synchronizeBroadphase(float dt) {
+        // Only the awake range moves; static and sleeping proxies stay where they are.
+        const size_t count = activeCount_;
+        bounds_.resize(count);
+        forEachChunk([&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                bounds_[i] = bodies_.shapes[i].computeAabb(bodies_.position(i), bodies_.orientation(i));
+                // Bullets are swept over the next step, so every broadphase pairs them with what
+                // lies ahead and the contact update can place speculative contacts there.
+                if (bodies_.flags[i] & kBodyBullet) {
+                    const glm::vec3 next = bodies_.position(i) + bodies_.velocity(i) * dt;
+                    bounds_[i] = Aabb::merge(bounds_[i], bodies_.shapes[i].computeAabb(next, bodies_.orientation(i)));
+                }
+            }
+        });
+
+        // Proxy updates mutate the broadphase, so they stay on this thread.
+        for (size_t i = 0; i < count; ++i) {
+            const glm::vec3 displacement = (bodies_.flags[i] & kBodyBullet) ? glm::vec3(0.0f) : bodies_.velocity(i) * dt;
+            broadphase_->moveProxy(slots_[denseToHandle_[i].id].proxy, bounds_[i], displacement);
+        }
+        updatePairs();
+    }
+
+    bool PhysicsWorld::isDynamicBody(uint32_t bodyId) const {
+        return (bodies_.flags[slots_[bodyId].dense] & (kBodyStatic | kBodyKinematic)) == 0;
+    }
+
+    void PhysicsWorld::updatePairs() {
+        broadphase_->findPairs(newPairs_);
+
+        // Merge new candidates into the persistent set, then retire pairs whose fat bounds separated.
+        mergedPairs_.clear();
+        mergedPairs_.reserve(pairs_.size() + newPairs_.size());
+        std::set_union(pairs_.begin(), pairs_.end(), newPairs_.begin(), newPairs_.end(), std::back_inserter(mergedPairs_));
+        pairs_.clear();
+        for (const BroadphasePair& pair : mergedPairs_) {
+            if (!isDynamicBody(pair.a) && !isDynamicBody(pair.b)) continue;
+            const Aabb& a = broadphase_->getFatAabb(slots_[pair.a].proxy);
+            const Aabb& b = broadphase_->getFatAabb(slots_[pair.b].proxy);
+            if (a.overlaps(b)) pairs_.push_back(pair);
+        }
+    }
+
+    void PhysicsWorld::updateContacts() {
+        pairContacts_.resize(pairs_.size());
+        const size_t chunks = (pairs_.size() + kPairChunkSize - 1) / kPairChunkSize;
+        utils::JobSystem::getInstance().parallelFor(chunks, [&](size_t chunk) {
+            const size_t end = std::min(pairs_.size(), (chunk + 1) * kPairChunkSize);
+            for (size_t p = chunk * kPairChunkSize; p < end; ++p) {
+                const BroadphasePair& pair = pairs_[p];
+                const size_t a = slots_[pair.a].dense;
+                const size_t b = slots_[pair.b].dense;
+                Contact& contact = pairContacts_[p];
+                contact.bodyA = pair.a;
+                contact.bodyB = pair.b;
+                contact.manifold.pointCount = 0;
+                // Nothing moved between two sleeping (or static) bodies; their manifold is kept as is.
+                if (!isActive(pair.a) && !isActive(pair.b)) continue;
+                // Bullets look ahead by the relative motion of one step: the solver then lets them
+                // close at most the gap, which stops them at the surface instead of past it.
+                float margin = kContactMargin;
+                if ((bodies_.flags[a] | bodies_.flags[b]) & kBodyBullet) {
+                    margin += glm::length(bodies_.velocity(a) - bodies_.velocity(b)) * lastStepDt_;
+                }
+                if (!collide(bodies_.shapes[a], bodies_.position(a), bodies_.orientation(a),
+                             bodies_.shapes[b], bodies_.position(b), bodies_.orientation(b),
+                             margin, contact.manifold)) continue;
+                // Lookups only; the cache is not modified until every chunk is done.
+                if (const Contact* previous = contactCache_.find(pair.a, pair.b)) {
+                    matchContactPoints(previous->manifold, contact.manifold);
+                }
+            }
+        });
+
+        for (const Contact& contact : pairContacts_) {
+            if (!isActive(contact.bodyA) && !isActive(contact.bodyB)) contactCache_.keep(contact.bodyA, contact.bodyB);
+            else if (contact.manifold.pointCount > 0) contactCache_.store(contact);
+        }
+        contactCache_.eraseUntouched();
+
+        // Touching a sleeping island wakes it, unless the toucher is a kinematic body standing still.
+        for (const Contact& contact : pairContacts_) {
+            if (contact.manifold.pointCount == 0 || isActive(contact.bodyA) == isActive(contact.bodyB)) continue;
+            const uint32_t mover = isActive(contact.bodyA) ? contact.bodyA : contact.bodyB;
+            const uint32_t sleeper = mover == contact.bodyA ? contact.bodyB : contact.bodyA;
+            const size_t index = slots_[mover].dense;
+            const bool still = (bodies_.flags[index] & kBodyKinematic) &&
+                               bodies_.velocity(index) == glm::vec3(0.0f) && bodies_.angularVelocity(index) == glm::vec3(0.0f);
+            if (!still) wakeIsland(sleeper);
+        }
+    }
+
+    void PhysicsWorld::solveContacts(float dt) {
+        // Contacts come from the end of the previous step, which is where the bodies still are.
+        std::vector<Contact>& contacts = contactCache_.getContacts();
+        activeContacts_.clear();
+        contactBodies_.clear();
+        for (size_t c = 0; c < contacts.size(); ++c) {
+            if (!isActive(contacts[c].bodyA) && !isActive(contacts[c].bodyB)) continue;
+            activeContacts_.push_back(static_cast<uint32_t>(c));
+        }
+        if (activeContacts_.empty()) return;
+        // The cache keeps contacts in the order they were made; the solver's colouring and
+        // Gauss-Seidel order follow whatever order it is given.
+        if (deterministic_) {
+            std::sort(activeContacts_.begin(), activeContacts_.end(), [&](uint32_t x, uint32_t y) {
+                return std::pair(contacts[x].bodyA, contacts[x].bodyB) < std::pair(contacts[y].bodyA, contacts[y].bodyB);
+            });
+        }
+        for (const uint32_t c : activeContacts_) {
+            contactBodies_.push_back(slots_[contacts[c].bodyA].dense);
+            contactBodies_.push_back(slots_[contacts[c].bodyB].dense);
+        }
+
+        solver_.prepare(bodies_, contacts, activeContacts_, contactBodies_, solverSettings_, dt);
+        if (solverSettings_.warmStarting) solver_.warmStart(bodies_);
+        for (int i = 0; i < solverSettings_.iterations; ++i) {
+            solver_.solveVelocities(bodies_);
+        }
+        solver_.storeImpulses(contacts);
+    }
+
+    std::optional<RayHit> PhysicsWorld::rayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const {
+        std::optional<RayHit> best;
+        broadphase_->rayCast(origin, direction, maxDistance, [&](uint32_t bodyId, float maxT) {
+            const size_t i = slots_[bodyId].dense;
+            const float t = bodies_.shapes[i].rayCast(bodies_.position(i), bodies_.orientation(i), origin, direction, maxT);
+            if (t < 0.0f) return maxT;
+            best = RayHit{ handleOfId(bodyId), t };
+            return t;
+        });
+        return best;
+    }
+
+    void PhysicsWorld::queryAabb(const Aabb& aabb, const std::function<bool(BodyHandle)>& visitor) const {
+        broadphase_->queryAabb(aabb, [&](uint32_t bodyId) { return visitor(handleOfId(bodyId)); });
+    }
+
+    void PhysicsWorld::storePreviousTransforms() {
+        BodyStorage& b = bodies_;
+        forEachChunk([&](size_t begin, size_t end) {
+            const size_t count = end - begin;
+            std::copy_n(b.positionX.data() + begin, count, b.previousPositionX.data() + begin);
+            std::copy_n(b.positionY.data() + begin, count, b.previousPositionY.data() + begin);
+            std::copy_n(b.positionZ.data() + begin, count, b.previousPositionZ.data() + begin);
+            std::copy_n(b.orientationW.data() + begin, count, b.previousOrientationW.data() + begin);
+            std::copy_n(b.orientationX.data() + begin, count, b.previousOrientationX.data() + begin);
+            std::copy_n(b.orientationY.data() + begin, count, b.previousOrientationY.data() + begin);
+            std::copy_n(b.orientationZ.data() + begin, count, b.previousOrientationZ.data() + begin);
+        });
+    }
+
+    glm::vec3 PhysicsWorld::getRenderPosition(BodyHandle handle, float alpha, RenderBlend blend) const {
+        auto index = indexOf(handle);
+        if (!index) return glm::vec3(0.0f);
+        if (blend == RenderBlend::Extrapolate) {
+            return bodies_.position(*index) + bodies_.velocity(*index) * (alpha * lastStepDt_);
+        }
+        return glm::mix(bodies_.previousPosition(*index), bodies_.position(*index), alpha);
+    }
+
+    glm::quat PhysicsWorld::getRenderOrientation(BodyHandle handle, float alpha, RenderBlend blend) const {
+        auto index = indexOf(handle);
+        if (!index) return glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        const glm::quat current = bodies_.orientation(*index);
+        if (blend == RenderBlend::Extrapolate) {
+            // Same first-order update integratePositions uses.
+            const glm::vec3 w = bodies_.angularVelocity(*index);
+            return glm::normalize(current + glm::quat(0.0f, w.x, w.y, w.z) * current * (0.5f * alpha * lastStepDt_));
+        }
+        return glm::slerp(bodies_.previousOrientation(*index), current, alpha);
+    }
+
+    void PhysicsWorld::integrateVelocities(float dt) {
+        const glm::vec3 gravity = gravity_;
+        const float linearScale = 1.0f / (1.0f + dt * linearDamping_);
+        const float angularScale = 1.0f / (1.0f + dt * angularDamping_);
+        BodyStorage& b = bodies_;
+
+        forEachChunk([&, dt](size_t begin, size_t end) {
+            const float* __restrict invMass = b.inverseMass.data();
+            const uint32_t* __restrict flags = b.flags.data();
+            float* __restrict vx = b.velocityX.data();
+            float* __restrict vy = b.velocityY.data();
+            float* __restrict vz = b.velocityZ.data();
+            const float* __restrict fx = b.forceX.data();
+            const float* __restrict fy = b.forceY.data();
+            const float* __restrict fz = b.forceZ.data();
+
+            // Linear: one straight-line pass per column, no gathers.
+            for (size_t i = begin; i < end; ++i) {
+                // Branch-free: non-dynamic bodies get zero acceleration and a damping factor of one.
+                const float dynamic = (flags[i] & (kBodyStatic | kBodyKinematic | kBodySleeping)) ? 0.0f : 1.0f;
+                const float forceScale = invMass[i] * dt * dynamic;
+                const float gravityScale = dt * dynamic;
+                const float damping = 1.0f + dynamic * (linearScale - 1.0f);
+                vx[i] = (vx[i] + fx[i] * forceScale + gravity.x * gravityScale) * damping;
+                vy[i] = (vy[i] + fy[i] * forceScale + gravity.y * gravityScale) * damping;
+                vz[i] = (vz[i] + fz[i] * forceScale + gravity.z * gravityScale) * damping;
+            }
+
+            // Angular needs the world inertia, so it works per body.
+            for (size_t i = begin; i < end; ++i) {
+                if (flags[i] & (kBodyStatic | kBodyKinematic | kBodySleeping)) continue;
+                const glm::vec3 torque(b.torqueX[i], b.torqueY[i], b.torqueZ[i]);
+                glm::vec3 omega = b.angularVelocity(i);
+                if (torque != glm::vec3(0.0f)) {
+                    omega += (b.inverseInertiaWorld(i) * torque) * dt;
+                }
+                b.setAngularVelocity(i, omega * angularScale);
+            }
+        });
+    }
+
+    void PhysicsWorld::integratePositions(float dt) {
+        BodyStorage& b = bodies_;
+
+        forEachChunk([&, dt](size_t begin, size_t end) {
+            const uint32_t* __restrict flags = b.flags.data();
+            float* __restrict px = b.positionX.data();
+            float* __restrict py = b.positionY.data();
+            float* __restrict pz = b.positionZ.data();
+            const float* __restrict vx = b.velocityX.data();
+            const float* __restrict vy = b.velocityY.data();
+            const float* __restrict vz = b.velocityZ.data();
+
+            for (size_t i = begin; i < end; ++i) {
+                const float moving = (flags[i] & (kBodyStatic | kBodySleeping)) ? 0.0f : dt;
+                px[i] += vx[i] * moving;
+                py[i] += vy[i] * moving;
+                pz[i] += vz[i] * moving;
+            }
+
+            // q' = q + 0.5 * (0, w) * q * dt, renormalised.
+            float* __restrict qw = b.orientationW.data();
+            float* __restrict qx = b.orientationX.data();
+            float* __restrict qy = b.orientationY.data();
+            float* __restrict qz = b.orientationZ.data();
+            const float* __restrict wx = b.angularVelocityX.data();
+            const float* __restrict wy = b.angularVelocityY.data();
+            const float* __restrict wz = b.angularVelocityZ.data();
+            for (size_t i = begin; i < end; ++i) {
+                const float h = (flags[i] & (kBodyStatic | kBodySleeping)) ? 0.0f : 0.5f * dt;
+                const float dw = -(wx[i] * qx[i] + wy[i] * qy[i] + wz[i] * qz[i]) * h;
+                const float dx = (wx[i] * qw[i] + wy[i] * qz[i] - wz[i] * qy[i]) * h;
+                const float dy = (wy[i] * qw[i] + wz[i] * qx[i] - wx[i] * qz[i]) * h;
+                const float dz = (wz[i] * qw[i] + wx[i] * qy[i] - wy[i] * qx[i]) * h;
+                const float nw = qw[i] + dw, nx = qx[i] + dx, ny = qy[i] + dy, nz = qz[i] + dz;
+                const float invLength = 1.0f / std::sqrt(nw * nw + nx * nx + ny * ny + nz * nz);
+                qw[i] = nw * invLength;
+                qx[i] = nx * invLength;
+                qy[i] = ny * invLength;
+                qz[i] = nz * invLength;
+            }
+        });
+    }
+
+    void PhysicsWorld::solveTimeOfImpact() {
+        bullets_.clear();
+        for (size_t i = 0; i < activeCount_; ++i) {
+            if ((bodies_.flags[i] & (kBodyBullet | kBodyKinematic)) == kBodyBullet) bullets_.push_back(static_cast<uint32_t>(i));
+        }
+        if (bullets_.empty()) return;
+
+        // Every bullet is swept against the moves already made this step; nothing is written
+        // until all of them are done, so the order of the jobs doesn't matter.
+        bulletImpacts_.assign(bullets_.size(), 1.0f);
+        utils::JobSystem::getInstance().parallelFor(bullets_.size(), [&](size_t k) {
+            const size_t i = bullets_[k];
+            const Sweep sweep{ bodies_.previousPosition(i), bodies_.position(i), bodies_.previousOrientation(i), bodies_.orientation(i) };
+            // Moving less than the margin: ordinary contacts catch whatever it hits.
+            const float angle = 2.0f * std::acos(std::min(std::abs(glm::dot(sweep.orientation0, sweep.orientation1)), 1.0f));
+            const float travel = glm::length(sweep.position1 - sweep.position0) + angle * bodies_.shapes[i].boundingRadius();
+            if (travel < kContactMargin) return;
+
+            const Aabb swept = Aabb::merge(bodies_.shapes[i].computeAabb(sweep.position0, sweep.orientation0),
+                                           bodies_.shapes[i].computeAabb(sweep.position1, sweep.orientation1));
+            const uint32_t self = denseToHandle_[i].id;
+            float impact = 1.0f;
+            broadphase_->queryAabb(swept, [&](uint32_t other) {
+                if (other == self) return true;
+                const size_t j = slots_[other].dense;
+                const Sweep otherSweep{ bodies_.previousPosition(j), bodies_.position(j),
+                                        bodies_.previousOrientation(j), bodies_.orientation(j) };
+                impact = std::min(impact, timeOfImpact(bodies_.shapes[i], sweep, bodies_.shapes[j], otherSweep, kTimeOfImpactTarget));
+                return true;
+            });
+            bulletImpacts_[k] = impact;
+        });
+
+        // Stop at the impact but keep the velocity; the speculative contact made at the end of
+        // this step resolves it in the next one.
+        for (size_t k = 0; k < bullets_.size(); ++k) {
+            if (bulletImpacts_[k] >= 1.0f) continue;
+            const size_t i = bullets_[k];
+            const Sweep sweep{ bodies_.previousPosition(i), bodies_.position(i), bodies_.previousOrientation(i), bodies_.orientation(i) };
+            bodies_.setPosition(i, sweep.position(bulletImpacts_[k]));
+            bodies_.setOrientation(i, glm::normalize(sweep.orientation(bulletImpacts_[k])));
+        }
+    }
+
+    void PhysicsWorld::clearForces() {
+        // Forces only accumulate on awake bodies (applying one wakes the body).
+        const auto end = static_cast<std::ptrdiff_t>(activeCount_);
+        std::fill(bodies_.forceX.begin(), bodies_.forceX.begin() + end, 0.0f);
+        std::fill(bodies_.forceY.begin(), bodies_.forceY.begin() + end, 0.0f);
+        std::fill(bodies_.forceZ.begin(), bodies_.forceZ.begin() + end, 0.0f);
+        std::fill(bodies_.torqueX.begin(), bodies_.torqueX.begin() + end, 0.0f);
+        std::fill(bodies_.torqueY.begin(), bodies_.torqueY.begin() + end, 0.0f);
+        std::fill(bodies_.torqueZ.begin(), bodies_.torqueZ.begin() + end, 0.0f);
+    }
+
+    void PhysicsWorld::setSleepEnabled(bool enabled) {
+        sleepEnabled_ = enabled;
+        if (enabled) return;
+        for (const auto& island : sleepingIslands_) {
+            if (!island.empty()) wakeIsland(island.front());
+        }
+    }
+
+    bool PhysicsWorld::isSleeping(BodyHandle handle) const {
+        return (getFlags(handle) & kBodySleeping) != 0;
+    }
+
+    void PhysicsWorld::wakeBody(BodyHandle handle) {
+        if (isValid(handle)) wakeIsland(handle.id);
+    }
+
+    float PhysicsWorld::specificKineticEnergy(size_t i) const {
+        // (m v^2 + w^T I w) / 2m, with the angular part in the body's principal frame.
+        const glm::vec3 v = bodies_.velocity(i);
+        const glm::vec3 w = glm::conjugate(bodies_.orientation(i)) * bodies_.angularVelocity(i);
+        const glm::vec3 inverseInertia = bodies_.inverseInertia(i);
+        float angular = 0.0f;
+        for (int axis = 0; axis < 3; ++axis) {
+            if (inverseInertia[axis] > 0.0f) angular += w[axis] * w[axis] * bodies_.inverseMass[i] / inverseInertia[axis];
+        }
+        return 0.5f * (glm::dot(v, v) + angular);
+    }
+
+    void PhysicsWorld::updateIslands() {
+        const size_t count = activeCount_;
+        islandParent_.resize(count);
+        for (size_t i = 0; i < count; ++i) islandParent_[i] = static_cast<uint32_t>(i);
+        auto find = [&](uint32_t i) {
+            while (islandParent_[i] != i) {
+                islandParent_[i] = islandParent_[islandParent_[i]];
+                i = islandParent_[i];
+            }
+            return i;
+        };
+        auto isDynamic = [&](size_t i) { return i < count && !(bodies_.flags[i] & kBodyKinematic); };
+
+        for (size_t i = 0; i < count; ++i) {
+            if (!isDynamic(i)) continue;
+            bodies_.restSteps[i] = specificKineticEnergy(i) < sleepEnergy_ ? bodies_.restSteps[i] + 1 : 0;
+        }
+
+        // Contacts between awake dynamic bodies link islands; static and kinematic bodies don't,
+        // but a moving kinematic body keeps whatever it touches awake.
+        for (const Contact& contact : contactCache_.getContacts()) {
+            const size_t a = slots_[contact.bodyA].dense;
+            const size_t b = slots_[contact.bodyB].dense;
+            if (isDynamic(a) && isDynamic(b)) {
+                const uint32_t rootA = find(static_cast<uint32_t>(a)), rootB = find(static_cast<uint32_t>(b));
+                if (rootA != rootB) islandParent_[std::max(rootA, rootB)] = std::min(rootA, rootB);
+                continue;
+            }
+            for (auto [self, other] : { std::pair{ a, b }, std::pair{ b, a } }) {
+                if (isDynamic(self) && other < count && (bodies_.flags[other] & kBodyKinematic) &&
+                    (bodies_.velocity(other) != glm::vec3(0.0f) || bodies_.angularVelocity(other) != glm::vec3(0.0f))) {
+                    bodies_.restSteps[self] = 0;
+                }
+            }
+        }
+
+        // An island is as restless as its most restless body.
+        islandRest_.assign(count, UINT32_MAX);
+        islandCount_ = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (!isDynamic(i)) continue;
+            const uint32_t root = find(static_cast<uint32_t>(i));
+            if (root == i) ++islandCount_;
+            islandRest_[root] = std::min(islandRest_[root], bodies_.restSteps[i]);
+        }
+        if (!sleepEnabled_) return;
+
+        // Collect ids first: putting bodies to sleep reorders the dense range.
+        islandSlot_.assign(count, UINT32_MAX);
+        size_t sleeperCount = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (!isDynamic(i)) continue;
+            const uint32_t root = find(static_cast<uint32_t>(i));
+            if (islandRest_[root] < sleepSteps_) continue;
+            if (islandSlot_[root] == UINT32_MAX) {
+                islandSlot_[root] = static_cast<uint32_t>(sleeperCount++);
+                if (sleepers_.size() < sleeperCount) sleepers_.emplace_back();
+                sleepers_[islandSlot_[root]].clear();
+            }
+            sleepers_[islandSlot_[root]].push_back(denseToHandle_[i].id);
+        }
+        for (size_t k = 0; k < sleeperCount; ++k) {
+            sleepIsland(sleepers_[k]);
+            --islandCount_;
+        }
+    }
+
+    void PhysicsWorld::sleepIsland(const std::vector<uint32_t>& bodyIds) {
+        uint32_t island;
+        if (!freeIslands_.empty()) {
+            island = freeIslands_.back();
+            freeIslands_.pop_back();
+        }
+        else {
+            island = static_cast<uint32_t>(sleepingIslands_.size());
+            sleepingIslands_.emplace_back();
+        }
+        sleepingIslands_[island] = bodyIds;
+        for (uint32_t id : bodyIds) {
+            const size_t index = slots_[id].dense;
+            slots_[id].island = island;
+            bodies_.flags[index] |= kBodySleeping;
+            bodies_.setVelocity(index, glm::vec3(0.0f));
+            bodies_.setAngularVelocity(index, glm::vec3(0.0f));
+            bodies_.storePreviousTransform(index); // Asleep bodies render where they stopped.
+            if (index < activeCount_) deactivate(index);
+        }
+    }
+
+    void PhysicsWorld::wakeIsland(uint32_t bodyId) {
+        const uint32_t island = slots_[bodyId].island;
+        if (island == kNoIsland) return;
+        for (uint32_t id : sleepingIslands_[island]) {
+            const size_t index = slots_[id].dense;
+            slots_[id].island = kNoIsland;
+            bodies_.flags[index] &= ~kBodySleeping;
+            bodies_.restSteps[index] = 0;
+            activate(index);
+        }
+        sleepingIslands_[island].clear();
+        freeIslands_.push_back(island);
+    }
+
+    void PhysicsWorld::wakeTouching(uint32_t bodyId) {
+        // Waking reorders bodies, never contacts, so walking the cache directly is fine.
+        for (const Contact& contact : contactCache_.getContacts()) {
+            if (contact.bodyA == bodyId) wakeIsland(contact.bodyB);
+            else if (contact.bodyB == bodyId) wakeIsland(contact.bodyA);
+        }
+    }
+
+    void PhysicsWorld::activate(size_t index) {
+        swapDense(index, activeCount_);
+        ++activeCount_;
+    }
+
+    void PhysicsWorld::deactivate(size_t index) {
+        --activeCount_;
+        swapDense(index, activeCount_);
+    }
+
+    void PhysicsWorld::swapDense(size_t a, size_t b) {
+        if (a == b) return;
+        bodies_.swap(a, b);
+        std::swap(denseToHandle_[a], denseToHandle_[b]);
+        slots_[denseToHandle_[a].id].dense = static_cast<uint32_t>(a);
+        slots_[denseToHandle_[b].id].dense = static_cast<uint32_t>(b);
+    }
+
+} // namespace physics
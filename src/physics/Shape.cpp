@@ -0,0 +1,334 @@
+#include "physics/Shape.h"
+#include "physics/Gjk.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PHYSICS_HULL_SSE 1
+#endif
+
+namespace physics {
+
+    namespace {
+        constexpr float kPi = 3.14159265358979f;
+
+        // |R| * h: world extent of a local box with half extents h.
+        glm::vec3 rotatedExtent(const glm::mat3& rotation, const glm::vec3& halfExtents) {
+            glm::vec3 extent(0.0f);
+            for (int axis = 0; axis < 3; ++axis) {
+                extent += glm::abs(rotation[axis]) * halfExtents[axis];
+            }
+            return extent;
+        }
+    }
+
+    size_t ConvexHullData::supportIndex(const glm::vec3& direction) const {
+#ifdef PHYSICS_HULL_SSE
+        const __m128 dx = _mm_set1_ps(direction.x);
+        const __m128 dy = _mm_set1_ps(direction.y);
+        const __m128 dz = _mm_set1_ps(direction.z);
+        __m128 best = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+        __m128i bestIndex = _mm_setzero_si128();
+        __m128i index = _mm_set_epi32(3, 2, 1, 0);
+        const __m128i four = _mm_set1_epi32(4);
+        for (size_t i = 0; i < x.size(); i += 4) {
+            const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(&x[i]), dx),
+                                                     _mm_mul_ps(_mm_load_ps(&y[i]), dy)),
+                                          _mm_mul_ps(_mm_load_ps(&z[i]), dz));
+            const __m128 greater = _mm_cmpgt_ps(dot, best);
+            best = _mm_max_ps(dot, best);
+            bestIndex = _mm_or_si128(_mm_and_si128(_mm_castps_si128(greater), index),
+                                     _mm_andnot_si128(_mm_castps_si128(greater), bestIndex));
+            index = _mm_add_epi32(index, four);
+        }
+        alignas(16) float lanes[4];
+        alignas(16) int32_t laneIndex[4];
+        _mm_store_ps(lanes, best);
+        _mm_store_si128(reinterpret_cast<__m128i*>(laneIndex), bestIndex);
+        int lane = 0;
+        for (int l = 1; l < 4; ++l) {
+            if (lanes[l] > lanes[lane]) lane = l;
+        }
+        return static_cast<size_t>(laneIndex[lane]);
+#else
+        size_t best = 0;
+        float bestDot = -std::numeric_limits<float>::infinity();
+        for (size_t i = 0; i < count; ++i) {
+            const float dot = x[i] * direction.x + y[i] * direction.y + z[i] * direction.z;
+            if (dot > bestDot) {
+                bestDot = dot;
+                best = i;
+            }
+        }
+        return best;
+#endif
+    }
+
+    Shape Shape::sphere(float radius) {
+        Shape shape;
+        shape.type = ShapeType::Sphere;
+        shape.radius = radius;
+        shape.halfExtents = glm::vec3(radius);
+        return shape;
+    }
+
+    Shape Shape::box(const glm::vec3& halfExtents) {
+        Shape shape;
+        shape.type = ShapeType::Box;
+        shape.radius = 0.0f;
+        shape.halfExtents = halfExtents;
+        return shape;
+    }
+
+    Shape Shape::capsule(float radius, float halfHeight) {
+        Shape shape;
+        shape.type = ShapeType::Capsule;
+        shape.radius = radius;
+        shape.halfHeight = halfHeight;
+        shape.halfExtents = glm::vec3(radius, halfHeight + radius, radius);
+        return shape;
+    }
+
+    Shape Shape::cylinder(float radius, float halfHeight) {
+        Shape shape;
+        shape.type = ShapeType::Cylinder;
+        shape.radius = radius;
+        shape.halfHeight = halfHeight;
+        shape.halfExtents = glm::vec3(radius, halfHeight, radius);
+        return shape;
+    }
+
+    Shape Shape::convexHull(const std::vector<glm::vec3>& points) {
+        auto hull = std::make_shared<ConvexHullData>();
+        hull->count = points.size();
+        const size_t padded = (points.size() + 3) & ~size_t(3);
+        hull->x.resize(padded);
+        hull->y.resize(padded);
+        hull->z.resize(padded);
+        hull->bounds = points.empty() ? Aabb{} : Aabb{ points[0], points[0] };
+        for (size_t i = 0; i < padded; ++i) {
+            const glm::vec3& p = points.empty() ? glm::vec3(0.0f) : points[i < points.size() ? i : 0];
+            hull->x[i] = p.x;
+            hull->y[i] = p.y;
+            hull->z[i] = p.z;
+            hull->bounds.min = glm::min(hull->bounds.min, p);
+            hull->bounds.max = glm::max(hull->bounds.max, p);
+        }
+
+        Shape shape;
+        shape.type = ShapeType::ConvexHull;
+        shape.radius = 0.0f;
+        shape.halfExtents = hull->bounds.extents();
+        shape.hull = std::move(hull);
+        return shape;
+    }
+
+    glm::vec3 Shape::support(const glm::vec3& d) const {
+        switch (type) {
+            case ShapeType::Sphere: {
+                const float length = glm::length(d);
+                return length > 0.0f ? d * (radius / length) : glm::vec3(radius, 0.0f, 0.0f);
+            }
+            case ShapeType::Box:
+                return { std::copysign(halfExtents.x, d.x), std::copysign(halfExtents.y, d.y), std::copysign(halfExtents.z, d.z) };
+            case ShapeType::Capsule: {
+                const float length = glm::length(d);
+                const glm::vec3 cap = length > 0.0f ? d * (radius / length) : glm::vec3(0.0f);
+                return cap + glm::vec3(0.0f, std::copysign(halfHeight, d.y), 0.0f);
+            }
+            case ShapeType::Cylinder: {
+                const float radial = std::sqrt(d.x * d.x + d.z * d.z);
+                const float scale = radial > 0.0f ? radius / radial : 0.0f;
+                return { d.x * scale, std::copysign(halfHeight, d.y), d.z * scale };
+            }
+            case ShapeType::ConvexHull:
+                return hull ? hull->vertex(hull->supportIndex(d)) : glm::vec3(0.0f);
+            case ShapeType::Count: break;
+        }
+        return glm::vec3(0.0f);
+    }
+
+    glm::vec3 Shape::coreSupport(const glm::vec3& d) const {
+        switch (type) {
+            case ShapeType::Sphere: return glm::vec3(0.0f);
+            case ShapeType::Capsule: return { 0.0f, std::copysign(halfHeight, d.y), 0.0f };
+            default: return support(d);
+        }
+    }
+
+    Aabb Shape::computeAabb(const glm::vec3& position, const glm::quat& orientation) const {
+        switch (type) {
+            case ShapeType::Sphere:
+                return { position - glm::vec3(radius), position + glm::vec3(radius) };
+            case ShapeType::Capsule:
+            case ShapeType::Cylinder: {
+                const glm::vec3 axis = orientation * glm::vec3(0.0f, 1.0f, 0.0f);
+                glm::vec3 extent = glm::abs(axis) * halfHeight;
+                for (int i = 0; i < 3; ++i) {
+                    // A capsule cap is a sphere; a cylinder cap is a disc perpendicular to the axis.
+                    extent[i] += type == ShapeType::Capsule ? radius : radius * std::sqrt(std::max(0.0f, 1.0f - axis[i] * axis[i]));
+                }
+                return { position - extent, position + extent };
+            }
+            case ShapeType::ConvexHull: {
+                if (!hull) return { position, position };
+                const glm::vec3 center = position + orientation * hull->bounds.center();
+                const glm::vec3 extent = rotatedExtent(glm::mat3_cast(orientation), hull->bounds.extents());
+                return { center - extent, center + extent };
+            }
+            default: {
+                const glm::vec3 extent = rotatedExtent(glm::mat3_cast(orientation), halfExtents);
+                return { position - extent, position + extent };
+            }
+        }
+    }
+
+    float Shape::boundingRadius() const {
+        switch (type) {
+            case ShapeType::Sphere: return radius;
+            case ShapeType::Capsule: return halfHeight + radius;
+            case ShapeType::Cylinder: return std::sqrt(halfHeight * halfHeight + radius * radius);
+            case ShapeType::ConvexHull:
+                return hull ? glm::length(glm::max(glm::abs(hull->bounds.min), glm::abs(hull->bounds.max))) : 0.0f;
+            default: return glm::length(halfExtents);
+        }
+    }
+
+    float Shape::signedDistance(const glm::vec3& p, glm::vec3& normal) const {
+        switch (type) {
+            case ShapeType::Sphere: {
+                const float length = glm::length(p);
+                normal = length > 0.0f ? p / length : glm::vec3(0.0f, 1.0f, 0.0f);
+                return length - radius;
+            }
+            case ShapeType::Capsule: {
+                const glm::vec3 offset = p - glm::vec3(0.0f, glm::clamp(p.y, -halfHeight, halfHeight), 0.0f);
+                const float length = glm::length(offset);
+                normal = length > 0.0f ? offset / length : glm::vec3(1.0f, 0.0f, 0.0f);
+                return length - radius;
+            }
+            case ShapeType::Cylinder: {
+                const float radial = std::sqrt(p.x * p.x + p.z * p.z);
+                const glm::vec3 side = radial > 0.0f ? glm::vec3(p.x, 0.0f, p.z) / radial : glm::vec3(1.0f, 0.0f, 0.0f);
+                const glm::vec3 cap(0.0f, p.y < 0.0f ? -1.0f : 1.0f, 0.0f);
+                const float dr = radial - radius;
+                const float dy = std::abs(p.y) - halfHeight;
+                if (dr > 0.0f || dy > 0.0f) {
+                    const float outR = std::max(dr, 0.0f), outY = std::max(dy, 0.0f);
+                    const float length = std::sqrt(outR * outR + outY * outY);
+                    normal = (side * outR + cap * outY) / length;
+                    return length;
+                }
+                normal = dr > dy ? side : cap;
+                return std::max(dr, dy);
+            }
+            case ShapeType::ConvexHull: {
+                if (!hull) break;
+                const Shape point = Shape::sphere(0.0f);
+                const ConvexInstance self{ this, glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f) };
+                const ConvexInstance probe{ &point, p, glm::quat(1.0f, 0.0f, 0.0f, 0.0f) };
+                const GjkResult result = gjkDistance(self, probe);
+                if (!result.overlap && result.distance > 0.0f) {
+                    normal = (result.pointB - result.pointA) / result.distance;
+                    return result.distance;
+                }
+                EpaResult penetration;
+                if (epaPenetration(self, probe, penetration)) {
+                    normal = penetration.normal;
+                    return -penetration.depth;
+                }
+                // Degenerate polytope: fall back to the hull's bounds.
+                const Shape bounds = Shape::box(hull->bounds.extents());
+                const float distance = bounds.signedDistance(p - hull->bounds.center(), normal);
+                return std::min(distance, 0.0f);
+            }
+            default: break;
+        }
+
+        // Box (and a hull without data, which has no volume to speak of).
+        const glm::vec3 extents = type == ShapeType::Box ? halfExtents : glm::vec3(0.0f);
+        const glm::vec3 q = glm::abs(p) - extents;
+        const glm::vec3 sign(p.x < 0.0f ? -1.0f : 1.0f, p.y < 0.0f ? -1.0f : 1.0f, p.z < 0.0f ? -1.0f : 1.0f);
+        const glm::vec3 outside = glm::max(q, glm::vec3(0.0f));
+        const float length = glm::length(outside);
+        if (length > 0.0f) {
+            normal = sign * outside / length;
+            return length;
+        }
+        const int axis = q.x > q.y ? (q.x > q.z ? 0 : 2) : (q.y > q.z ? 1 : 2);
+        normal = glm::vec3(0.0f);
+        normal[axis] = sign[axis];
+        return q[axis];
+    }
+
+    glm::vec3 Shape::computeInertia(float mass) const {
+        switch (type) {
+            case ShapeType::Sphere:
+                return glm::vec3(0.4f * mass * radius * radius);
+            case ShapeType::Capsule: {
+                // Cylinder plus two hemispheres, mass split by volume.
+                const float length = 2.0f * halfHeight;
+                const float cylinderVolume = kPi * radius * radius * length;
+                const float sphereVolume = 4.0f / 3.0f * kPi * radius * radius * radius;
+                const float cylinderMass = mass * cylinderVolume / (cylinderVolume + sphereVolume);
+                const float hemisphereMass = 0.5f * (mass - cylinderMass);
+                const float r2 = radius * radius;
+                const float axial = cylinderMass * r2 * 0.5f + 2.0f * hemisphereMass * 0.4f * r2;
+                const float transverse = cylinderMass * (length * length / 12.0f + r2 * 0.25f)
+                                       + 2.0f * hemisphereMass * (0.4f * r2 + length * length * 0.25f + 0.375f * length * radius);
+                return { transverse, axial, transverse };
+            }
+            case ShapeType::Cylinder: {
+                const float length = 2.0f * halfHeight;
+                const float transverse = mass * (3.0f * radius * radius + length * length) / 12.0f;
+                return { transverse, 0.5f * mass * radius * radius, transverse };
+            }
+            default: {
+                // Hulls use their bounding box; close enough for gameplay-grade bodies.
+                const glm::vec3 size = halfExtents * 2.0f;
+                const glm::vec3 sq = size * size;
+                return glm::vec3(sq.y + sq.z, sq.x + sq.z, sq.x + sq.y) * (mass / 12.0f);
+            }
+        }
+    }
+
+    float Shape::rayCast(const glm::vec3& position, const glm::quat& orientation,
+                         const glm::vec3& origin, const glm::vec3& direction, float maxT) const {
+        if (type == ShapeType::Sphere) {
+            const glm::vec3 m = origin - position;
+            const float a = glm::dot(direction, direction);
+            const float b = glm::dot(m, direction);
+            const float c = glm::dot(m, m) - radius * radius;
+            if (c <= 0.0f) return 0.0f; // Starts inside.
+            const float disc = b * b - a * c;
+            if (disc < 0.0f || b > 0.0f) return -1.0f;
+            const float t = (-b - std::sqrt(disc)) / a;
+            return t <= maxT ? t : -1.0f;
+        }
+        if (type == ShapeType::Box) {
+            // Slab test in local space.
+            const glm::quat inverse = glm::conjugate(orientation);
+            const Aabb local{ -halfExtents, halfExtents };
+            return local.rayCast(inverse * (origin - position), inverse * direction, maxT);
+        }
+
+        // Everything else: conservative advancement. Step along the ray by the GJK distance,
+        // which can never overshoot the surface of a convex shape.
+        const float speed = glm::length(direction);
+        if (speed <= 0.0f) return -1.0f;
+        const Shape point = Shape::sphere(0.0f);
+        const ConvexInstance target{ this, position, orientation };
+        float t = 0.0f;
+        for (int iteration = 0; iteration < 32 && t <= maxT; ++iteration) {
+            const ConvexInstance probe{ &point, origin + direction * t, glm::quat(1.0f, 0.0f, 0.0f, 0.0f) };
+            const GjkResult result = gjkDistance(target, probe);
+            const float distance = result.distance - coreRadius();
+            if (result.overlap || distance < 1e-4f) return t;
+            t += distance / speed;
+        }
+        return -1.0f;
+    }
+
+} // namespace physics
@@ -0,0 +1,70 @@
+#include "physics/SimulationClock.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace physics {
+
+    SimulationClock::SimulationClock(double stepRate, int maxSubsteps)
+        : stepRate_(240.0), fixedDt_(1.0 / 240.0), maxSubsteps_(8) {
+        setStepRate(stepRate);
+        setMaxSubsteps(maxSubsteps);
+    }
+
+    void SimulationClock::setStepRate(double hz) {
+        if (!(hz > 0.0) || !std::isfinite(hz)) {
+            spdlog::warn("SimulationClock: Ignoring step rate {}", hz);
+            return;
+        }
+        // Keep alpha meaningful across the change.
+        accumulator_ = accumulator_ / fixedDt_ * (1.0 / hz);
+        stepRate_ = hz;
+        fixedDt_ = 1.0 / hz;
+    }
+
+    void SimulationClock::setMaxSubsteps(int maxSubsteps) {
+        if (maxSubsteps < 1) {
+            spdlog::warn("SimulationClock: Ignoring max substeps {}", maxSubsteps);
+            return;
+        }
+        maxSubsteps_ = maxSubsteps;
+    }
+
+    int SimulationClock::advance(double frameSeconds, const std::function<void(float)>& step) {
+        accumulator_ += std::max(frameSeconds, 0.0);
+        int steps = static_cast<int>(accumulator_ / fixedDt_);
+        if (steps > maxSubsteps_) {
+            const double dropped = (steps - maxSubsteps_) * fixedDt_;
+            accumulator_ -= dropped;
+            droppedTime_ += dropped;
+            steps = maxSubsteps_;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const float dt = getFixedDt();
+        for (int i = 0; i < steps; ++i) {
+            step(dt);
+        }
+        const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        accumulator_ = std::max(accumulator_ - steps * fixedDt_, 0.0);
+        simulationTime_ += steps * fixedDt_;
+        stepCount_ += steps;
+        lastSubsteps_ = steps;
+        lastFrameMs_ = frameSeconds * 1000.0;
+        if (steps > 0) lastStepMs_ = elapsedMs / steps;
+        return steps;
+    }
+
+    void SimulationClock::reset() {
+        accumulator_ = 0.0;
+        simulationTime_ = 0.0;
+        stepCount_ = 0;
+        lastSubsteps_ = 0;
+        lastFrameMs_ = 0.0;
+        lastStepMs_ = 0.0;
+        droppedTime_ = 0.0;
+    }
+
+} // namespace physics
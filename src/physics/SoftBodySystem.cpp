@@ -0,0 +1,827 @@
+#include "physics/SoftBodySystem.h"
+#include "physics/PhysicsWorld.h"
+#include "physics/SimdFloat.h"
+#include "utils/JobSystem.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+
+namespace physics {
+
+    namespace {
+        constexpr size_t kChunkSize = 1024;
+        constexpr size_t kConstraintsPerJob = 256;
+        constexpr int kMaxColors = 64;
+
+        // Greedy first-fit in constraint order: each constraint takes the lowest color none of its
+        // particles has yet. Fills `order` with constraint indices sorted by color, overflow last.
+        template <typename ParticlesOf>
+        void computeColoring(size_t count, size_t particleCount, ParticlesOf&& particlesOf,
+                             std::vector<uint32_t>& order, std::vector<uint32_t>& colorStart, uint32_t& overflowBegin) {
+            std::vector<uint64_t> masks(particleCount, 0);
+            std::vector<uint8_t> colors(count);
+            std::array<uint32_t, kMaxColors + 1> counts{};
+            std::vector<uint32_t> members;
+            int colorCount = 0;
+            for (size_t c = 0; c < count; ++c) {
+                members.clear();
+                particlesOf(c, members);
+                uint64_t used = 0;
+                for (uint32_t p : members) used |= masks[p];
+                const int color = std::countr_one(used);
+                colors[c] = static_cast<uint8_t>(color);
+                ++counts[color];
+                if (color == kMaxColors) continue;
+                for (uint32_t p : members) masks[p] |= uint64_t(1) << color;
+                colorCount = std::max(colorCount, color + 1);
+            }
+
+            colorStart.assign(colorCount + 1, 0);
+            for (int color = 0; color < colorCount; ++color) colorStart[color + 1] = colorStart[color] + counts[color];
+            overflowBegin = colorStart[colorCount];
+            std::array<uint32_t, kMaxColors + 1> fill{};
+            for (int color = 0; color < colorCount; ++color) fill[color] = colorStart[color];
+            fill[kMaxColors] = overflowBegin;
+            order.resize(count);
+            for (size_t c = 0; c < count; ++c) order[fill[colors[c]]++] = static_cast<uint32_t>(c);
+        }
+
+        template <typename Column>
+        void permute(Column& column, const std::vector<uint32_t>& order) {
+            Column sorted(column.size());
+            for (size_t i = 0; i < order.size(); ++i) sorted[i] = column[order[i]];
+            column.swap(sorted);
+        }
+
+        // XPBD distance constraints [begin, end), SimdFloat::kWidth at a time when `wide` (every
+        // block then touches distinct particles), otherwise one by one.
+        void solveDistanceRange(const uint32_t* a, const uint32_t* b, const float* rest, const float* compliance,
+                                float* lambda, float* x, float* y, float* z, const float* inverseMass,
+                                size_t begin, size_t end, float inverseH2, bool wide) {
+            constexpr int W = SimdFloat::kWidth;
+            alignas(32) float ax[W], ay[W], az[W], bx[W], by[W], bz[W], wa[W], wb[W], r[W], alpha[W], l[W];
+            const SimdFloat zero = SimdFloat::zero();
+            const SimdFloat tiny = SimdFloat::splat(1e-12f);
+            const int step = wide ? W : 1;
+            for (size_t k = begin; k < end; k += step) {
+                const int lanes = static_cast<int>(std::min<size_t>(step, end - k));
+                for (int lane = 0; lane < W; ++lane) {
+                    if (lane < lanes) {
+                        const uint32_t i = a[k + lane], j = b[k + lane];
+                        ax[lane] = x[i]; ay[lane] = y[i]; az[lane] = z[i];
+                        bx[lane] = x[j]; by[lane] = y[j]; bz[lane] = z[j];
+                        wa[lane] = inverseMass[i];
+                        wb[lane] = inverseMass[j];
+                        r[lane] = rest[k + lane];
+                        alpha[lane] = compliance[k + lane] * inverseH2;
+                        l[lane] = lambda[k + lane];
+                    }
+                    else {
+                        // Satisfied, massless padding: unit length apart, unit rest length.
+                        ax[lane] = 1.0f;
+                        ay[lane] = az[lane] = bx[lane] = by[lane] = bz[lane] = 0.0f;
+                        r[lane] = 1.0f;
+                        wa[lane] = wb[lane] = alpha[lane] = l[lane] = 0.0f;
+                    }
+                }
+                const SimdVec3 pa{ SimdFloat::load(ax), SimdFloat::load(ay), SimdFloat::load(az) };
+                const SimdVec3 pb{ SimdFloat::load(bx), SimdFloat::load(by), SimdFloat::load(bz) };
+                const SimdFloat invA = SimdFloat::load(wa), invB = SimdFloat::load(wb);
+                const SimdFloat alphaTilde = SimdFloat::load(alpha);
+                const SimdFloat lambdaOld = SimdFloat::load(l);
+
+                const SimdVec3 d = pa - pb;
+                const SimdFloat length = sqrt(max(dot(d, d), tiny));
+                const SimdFloat c = length - SimdFloat::load(r);
+                const SimdFloat denominator = max(invA + invB + alphaTilde, tiny);
+                const SimdFloat deltaLambda = (zero - c - alphaTilde * lambdaOld) / denominator;
+                const SimdVec3 impulse = d * (deltaLambda / length);
+                const SimdVec3 movedA = pa + impulse * invA;
+                const SimdVec3 movedB = pb - impulse * invB;
+                (lambdaOld + deltaLambda).store(l);
+                movedA.x.store(ax);
+                movedA.y.store(ay);
+                movedA.z.store(az);
+                movedB.x.store(bx);
+                movedB.y.store(by);
+                movedB.z.store(bz);
+
+                for (int lane = 0; lane < lanes; ++lane) {
+                    const uint32_t i = a[k + lane], j = b[k + lane];
+                    x[i] = ax[lane]; y[i] = ay[lane]; z[i] = az[lane];
+                    x[j] = bx[lane]; y[j] = by[lane]; z[j] = bz[lane];
+                    lambda[k + lane] = l[lane];
+                }
+            }
+        }
+
+        // Rotation closest to A, refined from `q` (Müller et al., "A Robust Method to Extract the
+        // Rotational Part of Deformations").
+        void extractRotation(const glm::mat3& a, glm::quat& q, int iterations) {
+            for (int i = 0; i < iterations; ++i) {
+                const glm::mat3 r = glm::mat3_cast(q);
+                const glm::vec3 omega = (glm::cross(r[0], a[0]) + glm::cross(r[1], a[1]) + glm::cross(r[2], a[2])) /
+                                        (std::abs(glm::dot(r[0], a[0]) + glm::dot(r[1], a[1]) + glm::dot(r[2], a[2])) + 1e-9f);
+                const float angle = glm::length(omega);
+                if (angle < 1e-9f) break;
+                q = glm::normalize(glm::angleAxis(angle, omega / angle) * q);
+            }
+        }
+    }
+
+    SoftBodySystem::SoftBodySystem(const SoftBodySettings& settings) {
+        setSettings(settings);
+    }
+
+    void SoftBodySystem::setSettings(const SoftBodySettings& settings) {
+        settings_ = settings;
+        settings_.substeps = std::max(settings_.substeps, 1u);
+        settings_.damping = std::max(settings_.damping, 0.0f);
+        settings_.thickness = std::max(settings_.thickness, 1e-5f);
+        settings_.friction = std::max(settings_.friction, 0.0f);
+    }
+
+    uint32_t SoftBodySystem::createBody() {
+        bodyBegin_.push_back(static_cast<uint32_t>(size()));
+        return static_cast<uint32_t>(bodyBegin_.size() - 1);
+    }
+
+    uint32_t SoftBodySystem::addParticle(const glm::vec3& position, float inverseMass) {
+        if (bodyBegin_.empty()) createBody();
+        for (auto* column : { &x_, &prevX_, &restX_ }) column->push_back(position.x);
+        for (auto* column : { &y_, &prevY_, &restY_ }) column->push_back(position.y);
+        for (auto* column : { &z_, &prevZ_, &restZ_ }) column->push_back(position.z);
+        for (auto* column : { &vx_, &vy_, &vz_ }) column->push_back(0.0f);
+        inverseMass_.push_back(std::max(inverseMass, 0.0f));
+        body_.push_back(static_cast<uint32_t>(bodyBegin_.size() - 1));
+        return static_cast<uint32_t>(size() - 1);
+    }
+
+    void SoftBodySystem::setPosition(uint32_t particle, const glm::vec3& position) {
+        x_[particle] = prevX_[particle] = position.x;
+        y_[particle] = prevY_[particle] = position.y;
+        z_[particle] = prevZ_[particle] = position.z;
+    }
+
+    void SoftBodySystem::addDistanceConstraint(uint32_t a, uint32_t b, float compliance) {
+        if (a >= size() || b >= size() || a == b) {
+            spdlog::warn("SoftBodySystem: Invalid distance constraint ({}, {})", a, b);
+            return;
+        }
+        stretch_.a.push_back(a);
+        stretch_.b.push_back(b);
+        stretch_.rest.push_back(glm::length(getPosition(a) - getPosition(b)));
+        stretch_.compliance.push_back(std::max(compliance, 0.0f));
+        stretch_.lambda.push_back(0.0f);
+        coloringDirty_ = true;
+    }
+
+    void SoftBodySystem::addBendingConstraint(uint32_t oppositeA, uint32_t oppositeB, float compliance) {
+        if (oppositeA >= size() || oppositeB >= size() || oppositeA == oppositeB) {
+            spdlog::warn("SoftBodySystem: Invalid bending constraint ({}, {})", oppositeA, oppositeB);
+            return;
+        }
+        bending_.a.push_back(oppositeA);
+        bending_.b.push_back(oppositeB);
+        bending_.rest.push_back(glm::length(getPosition(oppositeA) - getPosition(oppositeB)));
+        bending_.compliance.push_back(std::max(compliance, 0.0f));
+        bending_.lambda.push_back(0.0f);
+        coloringDirty_ = true;
+    }
+
+    void SoftBodySystem::addVolumeConstraint(uint32_t a, uint32_t b, uint32_t c, uint32_t d, float compliance) {
+        const uint32_t ids[4] = { a, b, c, d };
+        for (int i = 0; i < 4; ++i) {
+            for (int j = i + 1; j < 4; ++j) {
+                if (ids[i] >= size() || ids[j] >= size() || ids[i] == ids[j]) {
+                    spdlog::warn("SoftBodySystem: Invalid volume constraint ({}, {}, {}, {})", a, b, c, d);
+                    return;
+                }
+            }
+        }
+        for (int i = 0; i < 4; ++i) volumes_.p[i].push_back(ids[i]);
+        const glm::vec3 p0 = getPosition(a);
+        volumes_.rest.push_back(glm::dot(glm::cross(getPosition(b) - p0, getPosition(c) - p0), getPosition(d) - p0));
+        volumes_.compliance.push_back(std::max(compliance, 0.0f));
+        volumes_.lambda.push_back(0.0f);
+        coloringDirty_ = true;
+    }
+
+    void SoftBodySystem::addShapeMatchingCluster(const std::vector<uint32_t>& particles, float stiffness) {
+        if (particles.size() < 2 ||
+            std::any_of(particles.begin(), particles.end(), [&](uint32_t p) { return p >= size(); })) {
+            spdlog::warn("SoftBodySystem: Invalid shape matching cluster of {} particles", particles.size());
+            return;
+        }
+        for (uint32_t p : particles) {
+            clusters_.particles.push_back(p);
+            clusters_.restPositions.push_back(getPosition(p));
+        }
+        clusters_.start.push_back(static_cast<uint32_t>(clusters_.particles.size()));
+        clusters_.stiffness.push_back(std::clamp(stiffness, 0.0f, 1.0f));
+        clusters_.rotation.emplace_back(1.0f, 0.0f, 0.0f, 0.0f);
+        coloringDirty_ = true;
+    }
+
+    uint32_t SoftBodySystem::createCloth(const ClothDesc& desc) {
+        const glm::ivec2 res = glm::max(desc.resolution, glm::ivec2(2));
+        const uint32_t body = createBody();
+        const uint32_t first = static_cast<uint32_t>(size());
+        const float inverseMass = static_cast<float>(res.x * res.y) / std::max(desc.mass, 1e-6f);
+        for (int v = 0; v < res.y; ++v) {
+            for (int u = 0; u < res.x; ++u) {
+                const glm::vec3 p = desc.origin + desc.axisU * (static_cast<float>(u) / static_cast<float>(res.x - 1)) +
+                                    desc.axisV * (static_cast<float>(v) / static_cast<float>(res.y - 1));
+                addParticle(p, inverseMass);
+            }
+        }
+        const auto index = [&](int u, int v) { return first + static_cast<uint32_t>(v * res.x + u); };
+
+        // Two triangles per quad, split along alternating diagonals so the cloth has no
+        // preferred shear direction.
+        std::vector<uint32_t> triangles;
+        for (int v = 0; v + 1 < res.y; ++v) {
+            for (int u = 0; u + 1 < res.x; ++u) {
+                const uint32_t i00 = index(u, v), i10 = index(u + 1, v), i01 = index(u, v + 1), i11 = index(u + 1, v + 1);
+                if ((u + v) % 2 == 0) triangles.insert(triangles.end(), { i00, i10, i11, i00, i11, i01 });
+                else triangles.insert(triangles.end(), { i00, i10, i01, i10, i11, i01 });
+            }
+        }
+
+        // Edges with their opposite vertex; an edge listed twice is shared by two triangles.
+        struct Edge {
+            uint64_t key;
+            uint32_t opposite;
+        };
+        std::vector<Edge> edges;
+        edges.reserve(triangles.size());
+        for (size_t t = 0; t < triangles.size(); t += 3) {
+            for (int e = 0; e < 3; ++e) {
+                const uint32_t a = triangles[t + e], b = triangles[t + (e + 1) % 3];
+                edges.push_back({ uint64_t(std::min(a, b)) << 32 | std::max(a, b), triangles[t + (e + 2) % 3] });
+            }
+        }
+        std::stable_sort(edges.begin(), edges.end(), [](const Edge& l, const Edge& r) { return l.key < r.key; });
+        for (size_t e = 0; e < edges.size(); ++e) {
+            const uint32_t a = static_cast<uint32_t>(edges[e].key >> 32), b = static_cast<uint32_t>(edges[e].key);
+            if (e > 0 && edges[e].key == edges[e - 1].key) {
+                addBendingConstraint(edges[e - 1].opposite, edges[e].opposite, desc.bendCompliance);
+                continue;
+            }
+            const bool diagonal = (b - a) != 1 && (b - a) != static_cast<uint32_t>(res.x);
+            addDistanceConstraint(a, b, diagonal ? desc.shearCompliance : desc.stretchCompliance);
+        }
+        triangles_.insert(triangles_.end(), triangles.begin(), triangles.end());
+        return body;
+    }
+
+    uint32_t SoftBodySystem::createRope(const glm::vec3& start, const glm::vec3& end, uint32_t segments, float mass,
+                                        float compliance, float bendCompliance) {
+        segments = std::max(segments, 1u);
+        const uint32_t body = createBody();
+        const uint32_t first = static_cast<uint32_t>(size());
+        const float inverseMass = static_cast<float>(segments + 1) / std::max(mass, 1e-6f);
+        for (uint32_t i = 0; i <= segments; ++i) {
+            addParticle(start + (end - start) * (static_cast<float>(i) / static_cast<float>(segments)), inverseMass);
+        }
+        for (uint32_t i = 0; i < segments; ++i) addDistanceConstraint(first + i, first + i + 1, compliance);
+        for (uint32_t i = 0; i + 1 < segments; ++i) addBendingConstraint(first + i, first + i + 2, bendCompliance);
+        return body;
+    }
+
+    uint32_t SoftBodySystem::createTetMesh(const std::vector<glm::vec3>& vertices, const std::vector<uint32_t>& tetrahedra,
+                                           float mass, float edgeCompliance, float volumeCompliance) {
+        const uint32_t body = createBody();
+        const uint32_t first = static_cast<uint32_t>(size());
+        const size_t vertexCount = vertices.size();
+
+        // Mass follows volume: each tetrahedron gives a quarter of its share to each corner.
+        std::vector<float> vertexVolume(vertexCount, 0.0f);
+        std::vector<uint32_t> valid;
+        float totalVolume = 0.0f;
+        for (size_t t = 0; t + 3 < tetrahedra.size(); t += 4) {
+            const uint32_t* tet = tetrahedra.data() + t;
+            if (std::any_of(tet, tet + 4, [&](uint32_t v) { return v >= vertexCount; })) {
+                spdlog::warn("SoftBodySystem: Tetrahedron {} references a missing vertex", t / 4);
+                continue;
+            }
+            const glm::vec3 p0 = vertices[tet[0]];
+            const float volume = std::abs(glm::dot(glm::cross(vertices[tet[1]] - p0, vertices[tet[2]] - p0), vertices[tet[3]] - p0)) / 6.0f;
+            for (int k = 0; k < 4; ++k) vertexVolume[tet[k]] += volume * 0.25f;
+            totalVolume += volume;
+            valid.push_back(static_cast<uint32_t>(t));
+        }
+        const float density = std::max(mass, 1e-6f) / std::max(totalVolume, 1e-12f);
+        for (size_t v = 0; v < vertexCount; ++v) {
+            addParticle(vertices[v], vertexVolume[v] > 0.0f ? 1.0f / (vertexVolume[v] * density) : 0.0f);
+        }
+
+        std::vector<uint64_t> edges;
+        for (uint32_t t : valid) {
+            const uint32_t* tet = tetrahedra.data() + t;
+            for (int i = 0; i < 4; ++i) {
+                for (int j = i + 1; j < 4; ++j) {
+                    edges.push_back(uint64_t(std::min(tet[i], tet[j])) << 32 | std::max(tet[i], tet[j]));
+                }
+            }
+            addVolumeConstraint(first + tet[0], first + tet[1], first + tet[2], first + tet[3], volumeCompliance);
+        }
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+        for (uint64_t edge : edges) {
+            addDistanceConstraint(first + static_cast<uint32_t>(edge >> 32), first + static_cast<uint32_t>(edge), edgeCompliance);
+        }
+        return body;
+    }
+
+    void SoftBodySystem::clear() {
+        for (auto* column : { &x_, &y_, &z_, &prevX_, &prevY_, &prevZ_, &vx_, &vy_, &vz_, &inverseMass_,
+                              &restX_, &restY_, &restZ_, &dx_, &dy_, &dz_ }) {
+            column->clear();
+        }
+        body_.clear();
+        bodyBegin_.clear();
+        stretch_ = {};
+        bending_ = {};
+        volumes_ = {};
+        clusters_ = {};
+        triangles_.clear();
+        selfStart_.clear();
+        selfNeighbors_.clear();
+        mirrored_.clear();
+        coloringDirty_ = false;
+    }
+
+    size_t SoftBodySystem::getConstraintCount() const {
+        return stretch_.size() + bending_.size() + volumes_.size() + clusters_.size();
+    }
+
+    size_t SoftBodySystem::getColorCount() const {
+        size_t colors = 0;
+        for (const Coloring* coloring : { &stretch_.coloring, &bending_.coloring, &volumes_.coloring, &clusters_.coloring }) {
+            if (!coloring->colorStart.empty()) colors = std::max(colors, coloring->colorStart.size() - 1);
+        }
+        return colors;
+    }
+
+    void SoftBodySystem::prepareColoring() {
+        std::vector<uint32_t> order;
+        for (DistanceConstraints* set : { &stretch_, &bending_ }) {
+            DistanceConstraints& dc = *set;
+            computeColoring(dc.size(), size(), [&](size_t c, std::vector<uint32_t>& out) { out.push_back(dc.a[c]); out.push_back(dc.b[c]); },
+                            order, dc.coloring.colorStart, dc.coloring.overflowBegin);
+            permute(dc.a, order);
+            permute(dc.b, order);
+            permute(dc.rest, order);
+            permute(dc.compliance, order);
+            permute(dc.lambda, order);
+        }
+
+        computeColoring(volumes_.size(), size(), [&](size_t c, std::vector<uint32_t>& out) {
+            for (int k = 0; k < 4; ++k) out.push_back(volumes_.p[k][c]);
+        }, order, volumes_.coloring.colorStart, volumes_.coloring.overflowBegin);
+        for (auto& column : volumes_.p) permute(column, order);
+        permute(volumes_.rest, order);
+        permute(volumes_.compliance, order);
+        permute(volumes_.lambda, order);
+
+        ShapeClusters& sc = clusters_;
+        computeColoring(sc.size(), size(), [&](size_t c, std::vector<uint32_t>& out) {
+            out.insert(out.end(), sc.particles.begin() + sc.start[c], sc.particles.begin() + sc.start[c + 1]);
+        }, order, sc.coloring.colorStart, sc.coloring.overflowBegin);
+        ShapeClusters sorted;
+        sorted.coloring = sc.coloring;
+        for (uint32_t c : order) {
+            sorted.particles.insert(sorted.particles.end(), sc.particles.begin() + sc.start[c], sc.particles.begin() + sc.start[c + 1]);
+            sorted.restPositions.insert(sorted.restPositions.end(), sc.restPositions.begin() + sc.start[c], sc.restPositions.begin() + sc.start[c + 1]);
+            sorted.start.push_back(static_cast<uint32_t>(sorted.particles.size()));
+            sorted.stiffness.push_back(sc.stiffness[c]);
+            sorted.rotation.push_back(sc.rotation[c]);
+        }
+        clusters_ = std::move(sorted);
+        coloringDirty_ = false;
+    }
+
+    template <typename Kernel>
+    void SoftBodySystem::forEachChunk(Kernel&& kernel) {
+        const size_t count = size();
+        const size_t chunks = (count + kChunkSize - 1) / kChunkSize;
+        utils::JobSystem::getInstance().parallelFor(chunks, [&](size_t chunk) {
+            const size_t begin = chunk * kChunkSize;
+            kernel(begin, std::min(begin + kChunkSize, count));
+        });
+    }
+
+    void SoftBodySystem::step(float dt, PhysicsWorld* world) {
+        if (size() == 0 || dt <= 0.0f) return;
+        if (coloringDirty_) prepareColoring();
+        for (auto* column : { &dx_, &dy_, &dz_ }) column->resize(size());
+
+        if (settings_.selfCollision) findSelfCollisionPairs(dt);
+        colliders_.clear();
+        if (world) gatherColliders(*world, dt);
+        const size_t chunks = (size() + kChunkSize - 1) / kChunkSize;
+        chunkPush_.assign(chunks * colliders_.size(), glm::vec3(0.0f));
+        chunkMoment_.assign(chunks * colliders_.size(), glm::vec3(0.0f));
+
+        const uint32_t substeps = settings_.substeps;
+        const float h = dt / static_cast<float>(substeps);
+        const float inverseH2 = 1.0f / (h * h);
+        const float keep = std::max(1.0f - settings_.damping * h, 0.0f);
+        const glm::vec3 dv = settings_.gravity * h;
+        for (uint32_t substep = 0; substep < substeps; ++substep) {
+            forEachChunk([&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    prevX_[i] = x_[i];
+                    prevY_[i] = y_[i];
+                    prevZ_[i] = z_[i];
+                    if (inverseMass_[i] == 0.0f) continue;
+                    vx_[i] = (vx_[i] + dv.x) * keep;
+                    vy_[i] = (vy_[i] + dv.y) * keep;
+                    vz_[i] = (vz_[i] + dv.z) * keep;
+                    x_[i] += vx_[i] * h;
+                    y_[i] += vy_[i] * h;
+                    z_[i] += vz_[i] * h;
+                }
+            });
+
+            // One iteration per substep, so the multipliers start from zero each time.
+            for (DistanceConstraints* set : { &stretch_, &bending_ }) std::fill(set->lambda.begin(), set->lambda.end(), 0.0f);
+            std::fill(volumes_.lambda.begin(), volumes_.lambda.end(), 0.0f);
+            solveDistances(stretch_, inverseH2);
+            solveDistances(bending_, inverseH2);
+            solveVolumes(inverseH2);
+            solveShapeMatching(substeps);
+            if (settings_.selfCollision && !selfNeighbors_.empty()) solveSelfCollisions();
+            if (!colliders_.empty()) solveColliders(h);
+
+            const float inverseH = 1.0f / h;
+            forEachChunk([&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    vx_[i] = (x_[i] - prevX_[i]) * inverseH;
+                    vy_[i] = (y_[i] - prevY_[i]) * inverseH;
+                    vz_[i] = (z_[i] - prevZ_[i]) * inverseH;
+                }
+            });
+        }
+
+        if (world && !colliders_.empty()) applyCouplingForces(*world, h, dt);
+    }
+
+    void SoftBodySystem::solveDistances(DistanceConstraints& dc, float inverseH2) {
+        const std::vector<uint32_t>& colorStart = dc.coloring.colorStart;
+        for (size_t color = 0; color + 1 < colorStart.size(); ++color) {
+            const size_t begin = colorStart[color], end = colorStart[color + 1];
+            const size_t jobs = (end - begin + kConstraintsPerJob - 1) / kConstraintsPerJob;
+            utils::JobSystem::getInstance().parallelFor(jobs, [&](size_t job) {
+                const size_t first = begin + job * kConstraintsPerJob;
+                solveDistanceRange(dc.a.data(), dc.b.data(), dc.rest.data(), dc.compliance.data(), dc.lambda.data(),
+                                   x_.data(), y_.data(), z_.data(), inverseMass_.data(),
+                                   first, std::min(first + kConstraintsPerJob, end), inverseH2, true);
+            });
+        }
+        solveDistanceRange(dc.a.data(), dc.b.data(), dc.rest.data(), dc.compliance.data(), dc.lambda.data(),
+                           x_.data(), y_.data(), z_.data(), inverseMass_.data(),
+                           dc.coloring.overflowBegin, dc.size(), inverseH2, false);
+    }
+
+    void SoftBodySystem::solveVolumes(float inverseH2) {
+        VolumeConstraints& vc = volumes_;
+        const auto solve = [&](size_t c) {
+            uint32_t id[4];
+            glm::vec3 p[4];
+            float w[4];
+            for (int k = 0; k < 4; ++k) {
+                id[k] = vc.p[k][c];
+                p[k] = getPosition(id[k]);
+                w[k] = inverseMass_[id[k]];
+            }
+            // Gradients of six times the signed volume with respect to each corner.
+            const glm::vec3 gradient[4] = {
+                glm::cross(p[3] - p[1], p[2] - p[1]),
+                glm::cross(p[2] - p[0], p[3] - p[0]),
+                glm::cross(p[3] - p[0], p[1] - p[0]),
+                glm::cross(p[1] - p[0], p[2] - p[0]),
+            };
+            float denominator = vc.compliance[c] * inverseH2;
+            for (int k = 0; k < 4; ++k) denominator += w[k] * glm::dot(gradient[k], gradient[k]);
+            if (denominator <= 1e-12f) return;
+            const float constraint = glm::dot(gradient[3], p[3] - p[0]) - vc.rest[c];
+            const float deltaLambda = (-constraint - vc.compliance[c] * inverseH2 * vc.lambda[c]) / denominator;
+            vc.lambda[c] += deltaLambda;
+            for (int k = 0; k < 4; ++k) {
+                const glm::vec3 moved = p[k] + gradient[k] * (w[k] * deltaLambda);
+                x_[id[k]] = moved.x;
+                y_[id[k]] = moved.y;
+                z_[id[k]] = moved.z;
+            }
+        };
+
+        const std::vector<uint32_t>& colorStart = vc.coloring.colorStart;
+        for (size_t color = 0; color + 1 < colorStart.size(); ++color) {
+            const size_t begin = colorStart[color];
+            utils::JobSystem::getInstance().parallelFor(colorStart[color + 1] - begin, [&](size_t c) { solve(begin + c); }, kConstraintsPerJob);
+        }
+        for (size_t c = vc.coloring.overflowBegin; c < vc.size(); ++c) solve(c);
+    }
+
+    void SoftBodySystem::solveShapeMatching(uint32_t substeps) {
+        ShapeClusters& sc = clusters_;
+        const auto solve = [&](size_t c) {
+            const uint32_t begin = sc.start[c], end = sc.start[c + 1];
+            // Pinned particles weigh in as very heavy ones, so they anchor the cluster. The rest
+            // shape is centred with the same weights, or unequal masses would shift the goal off
+            // the rest pose; weights are read here since masses can change after creation.
+            const auto weight = [&](uint32_t p) { return 1.0f / std::max(inverseMass_[p], 1e-6f); };
+            glm::vec3 center(0.0f), restCenter(0.0f);
+            float total = 0.0f;
+            for (uint32_t k = begin; k < end; ++k) {
+                const uint32_t p = sc.particles[k];
+                center += getPosition(p) * weight(p);
+                restCenter += sc.restPositions[k] * weight(p);
+                total += weight(p);
+            }
+            center /= total;
+            restCenter /= total;
+            glm::mat3 a(0.0f);
+            for (uint32_t k = begin; k < end; ++k) {
+                const uint32_t p = sc.particles[k];
+                const glm::vec3 offset = (getPosition(p) - center) * weight(p);
+                const glm::vec3 rest = sc.restPositions[k] - restCenter;
+                a[0] += offset * rest.x;
+                a[1] += offset * rest.y;
+                a[2] += offset * rest.z;
+            }
+            extractRotation(a, sc.rotation[c], 8);
+
+            // Stiffness is per step; spread it so the result doesn't depend on the substep count.
+            const float alpha = 1.0f - std::pow(1.0f - sc.stiffness[c], 1.0f / static_cast<float>(substeps));
+            for (uint32_t k = begin; k < end; ++k) {
+                const uint32_t p = sc.particles[k];
+                if (inverseMass_[p] == 0.0f) continue;
+                const glm::vec3 position = getPosition(p);
+                const glm::vec3 goal = center + sc.rotation[c] * (sc.restPositions[k] - restCenter);
+                const glm::vec3 moved = position + (goal - position) * alpha;
+                x_[p] = moved.x;
+                y_[p] = moved.y;
+                z_[p] = moved.z;
+            }
+        };
+
+        const std::vector<uint32_t>& colorStart = sc.coloring.colorStart;
+        for (size_t color = 0; color + 1 < colorStart.size(); ++color) {
+            const size_t begin = colorStart[color];
+            utils::JobSystem::getInstance().parallelFor(colorStart[color + 1] - begin, [&](size_t c) { solve(begin + c); });
+        }
+        for (size_t c = sc.coloring.overflowBegin; c < sc.size(); ++c) solve(c);
+    }
+
+    void SoftBodySystem::findSelfCollisionPairs(float dt) {
+        const size_t count = size();
+        const size_t chunks = (count + kChunkSize - 1) / kChunkSize;
+
+        // Pairs are found once per step, so a pair is kept if the particles could close the gap
+        // during it at their relative speed, plus a thickness of slack for what the constraints
+        // do to it. Relative to the mean velocity c, |vi - vj| <= 2 max(|vi - c|, |vj - c|), so
+        // each particle searches as far as it alone could take the pair (capped at 16 contact
+        // distances; anything faster can pass through) and a cloth falling as a whole still
+        // searches only its slack. A pair only the faster particle reaches is mirrored into the
+        // other's list.
+        std::vector<glm::vec3> chunkMomentum(chunks);
+        forEachChunk([&](size_t begin, size_t end) {
+            glm::vec3 sum(0.0f);
+            for (size_t i = begin; i < end; ++i) sum += getVelocity(i);
+            chunkMomentum[begin / kChunkSize] = sum;
+        });
+        glm::vec3 mean(0.0f);
+        for (const glm::vec3& sum : chunkMomentum) mean += sum;
+        mean /= static_cast<float>(count);
+
+        const float contact = 2.0f * settings_.thickness;
+        const float slack = contact + settings_.thickness;
+        const float maxRadius = 16.0f * contact;
+        const float contact2 = contact * contact;
+        AlignedVector<float>& searchRadius = dx_;
+        forEachChunk([&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                searchRadius[i] = std::min(slack + 2.0f * glm::length(getVelocity(i) - mean) * dt, maxRadius);
+            }
+        });
+
+        // Cells of two slacks keep most particles to their own 27 cells at moderate speeds.
+        grid_.setCellSize(2.0f * slack);
+        grid_.build(x_.data(), y_.data(), z_.data(), count);
+        const float inverseCellSize = 1.0f / grid_.getCellSize();
+        selfStart_.assign(count + 1, 0);
+        if (chunkNeighbors_.size() < chunks) chunkNeighbors_.resize(chunks);
+        if (chunkMirrored_.size() < chunks) chunkMirrored_.resize(chunks);
+        forEachChunk([&](size_t begin, size_t end) {
+            std::vector<uint32_t>& list = chunkNeighbors_[begin / kChunkSize];
+            std::vector<uint64_t>& mirrored = chunkMirrored_[begin / kChunkSize];
+            list.clear();
+            mirrored.clear();
+            for (size_t i = begin; i < end; ++i) {
+                const glm::vec3 p = getPosition(i);
+                const glm::vec3 v = getVelocity(i);
+                const glm::vec3 rest(restX_[i], restY_[i], restZ_[i]);
+                const float radius = searchRadius[i];
+                const SpatialHashGrid::Cell center = grid_.cellOf(p);
+                const int span = static_cast<int>(std::ceil(radius * inverseCellSize));
+                const size_t first = list.size();
+                for (int cz = center.z - span; cz <= center.z + span; ++cz) {
+                    for (int cy = center.y - span; cy <= center.y + span; ++cy) {
+                        for (int cx = center.x - span; cx <= center.x + span; ++cx) {
+                            grid_.forEachInCell({ cx, cy, cz }, [&](uint32_t j) {
+                                if (j == i) return;
+                                const glm::vec3 d = p - getPosition(j);
+                                const float distance2 = glm::dot(d, d);
+                                if (distance2 >= radius * radius) return;
+                                const float reach = slack + glm::length(v - getVelocity(j)) * dt;
+                                if (distance2 >= reach * reach) return;
+                                if (body_[j] == body_[i]) {
+                                    const glm::vec3 r = rest - glm::vec3(restX_[j], restY_[j], restZ_[j]);
+                                    if (glm::dot(r, r) < contact2) return;
+                                }
+                                list.push_back(j);
+                                if (distance2 >= searchRadius[j] * searchRadius[j]) mirrored.push_back((uint64_t(j) << 32) | i);
+                            });
+                        }
+                    }
+                }
+                // Cells sharing a bucket are walked once each, so drop the repeats.
+                std::sort(list.begin() + static_cast<std::ptrdiff_t>(first), list.end());
+                list.erase(std::unique(list.begin() + static_cast<std::ptrdiff_t>(first), list.end()), list.end());
+                selfStart_[i + 1] = static_cast<uint32_t>(list.size() - first);
+            }
+        });
+
+        std::vector<uint64_t>& mirrored = mirrored_;
+        mirrored.clear();
+        for (size_t chunk = 0; chunk < chunks; ++chunk) mirrored.insert(mirrored.end(), chunkMirrored_[chunk].begin(), chunkMirrored_[chunk].end());
+        std::sort(mirrored.begin(), mirrored.end());
+        mirrored.erase(std::unique(mirrored.begin(), mirrored.end()), mirrored.end());
+        for (uint64_t pair : mirrored) ++selfStart_[(pair >> 32) + 1];
+        for (size_t i = 0; i < count; ++i) selfStart_[i + 1] += selfStart_[i];
+        selfNeighbors_.resize(selfStart_[count]);
+
+        // Each particle's own finds, then the pairs mirrored to it, merged back into order.
+        utils::JobSystem::getInstance().parallelFor(chunks, [&](size_t chunk) {
+            const std::vector<uint32_t>& list = chunkNeighbors_[chunk];
+            const size_t begin = chunk * kChunkSize, end = std::min(begin + kChunkSize, count);
+            size_t next = static_cast<size_t>(std::lower_bound(mirrored.begin(), mirrored.end(), uint64_t(begin) << 32) - mirrored.begin());
+            auto own = list.begin();
+            for (size_t i = begin; i < end; ++i) {
+                const auto first = selfNeighbors_.begin() + selfStart_[i];
+                const auto last = selfNeighbors_.begin() + selfStart_[i + 1];
+                auto out = first;
+                size_t extra = 0;
+                while (next + extra < mirrored.size() && (mirrored[next + extra] >> 32) == i) ++extra;
+                const auto owned = (last - first) - static_cast<std::ptrdiff_t>(extra);
+                out = std::copy(own, own + owned, out);
+                own += owned;
+                for (; extra > 0; --extra) *out++ = static_cast<uint32_t>(mirrored[next++]);
+                std::inplace_merge(first, first + owned, last);
+            }
+        });
+    }
+
+    void SoftBodySystem::solveSelfCollisions() {
+        const float contact = 2.0f * settings_.thickness;
+        const float contact2 = contact * contact;
+
+        // Jacobi: every particle averages the corrections of its overlapping pairs, reading the
+        // positions from before the pass.
+        forEachChunk([&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                dx_[i] = dy_[i] = dz_[i] = 0.0f;
+                const float wi = inverseMass_[i];
+                if (wi == 0.0f) continue;
+                const glm::vec3 p = getPosition(i);
+                glm::vec3 correction(0.0f);
+                int touching = 0;
+                for (uint32_t k = selfStart_[i]; k < selfStart_[i + 1]; ++k) {
+                    const uint32_t j = selfNeighbors_[k];
+                    const glm::vec3 d = p - getPosition(j);
+                    const float distance2 = glm::dot(d, d);
+                    if (distance2 >= contact2 || distance2 == 0.0f) continue;
+                    const float distance = std::sqrt(distance2);
+                    correction += d * ((contact - distance) / distance * wi / (wi + inverseMass_[j]));
+                    ++touching;
+                }
+                if (touching == 0) continue;
+                correction /= static_cast<float>(touching);
+                dx_[i] = correction.x;
+                dy_[i] = correction.y;
+                dz_[i] = correction.z;
+            }
+        });
+        forEachChunk([&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                x_[i] += dx_[i];
+                y_[i] += dy_[i];
+                z_[i] += dz_[i];
+            }
+        });
+    }
+
+    void SoftBodySystem::gatherColliders(PhysicsWorld& world, float dt) {
+        // Bounds of where the particles are and where they would be after the step unhindered.
+        const size_t count = size();
+        const size_t chunks = (count + kChunkSize - 1) / kChunkSize;
+        const glm::vec3 fall = settings_.gravity * dt * dt;
+        std::vector<Aabb> chunkBounds(chunks);
+        forEachChunk([&](size_t begin, size_t end) {
+            Aabb bounds{ getPosition(begin), getPosition(begin) };
+            for (size_t i = begin; i < end; ++i) {
+                const glm::vec3 p = getPosition(i);
+                const glm::vec3 q = p + getVelocity(i) * dt + fall;
+                bounds = { glm::min(bounds.min, glm::min(p, q)), glm::max(bounds.max, glm::max(p, q)) };
+            }
+            chunkBounds[begin / kChunkSize] = bounds;
+        });
+        Aabb bounds = chunkBounds[0];
+        for (const Aabb& chunk : chunkBounds) bounds = Aabb::merge(bounds, chunk);
+        bounds = bounds.fattened(settings_.thickness);
+
+        const BodyStorage& bodies = world.getBodies();
+        world.queryAabb(bounds, [&](BodyHandle handle) {
+            const auto index = world.indexOf(handle);
+            if (!index) return true;
+            const Shape& shape = bodies.shapes[*index];
+            const glm::vec3 position = bodies.position(*index);
+            const glm::quat orientation = bodies.orientation(*index);
+            colliders_.push_back({ &shape, position, orientation, bodies.velocity(*index), bodies.angularVelocity(*index),
+                                   shape.computeAabb(position, orientation).fattened(settings_.thickness),
+                                   static_cast<uint32_t>(*index), (bodies.flags[*index] & (kBodyStatic | kBodyKinematic)) == 0 });
+            return true;
+        });
+    }
+
+    void SoftBodySystem::solveColliders(float h) {
+        const float thickness = settings_.thickness;
+        const float friction = settings_.friction;
+        const size_t colliderCount = colliders_.size();
+        forEachChunk([&](size_t begin, size_t end) {
+            glm::vec3* push = chunkPush_.data() + (begin / kChunkSize) * colliderCount;
+            glm::vec3* moment = chunkMoment_.data() + (begin / kChunkSize) * colliderCount;
+            for (size_t i = begin; i < end; ++i) {
+                const float w = inverseMass_[i];
+                if (w == 0.0f) continue;
+                for (size_t c = 0; c < colliderCount; ++c) {
+                    const Collider& collider = colliders_[c];
+                    glm::vec3 p = getPosition(i);
+                    if (!collider.bounds.contains(p)) continue;
+                    glm::vec3 normal;
+                    const float distance = collider.shape->signedDistance(glm::conjugate(collider.orientation) * (p - collider.position), normal);
+                    if (distance >= thickness) continue;
+                    normal = collider.orientation * normal;
+                    const float depth = thickness - distance;
+                    glm::vec3 correction = normal * depth;
+
+                    // Position-level Coulomb friction: cancel sliding against the surface, up to
+                    // friction times the penetration.
+                    const glm::vec3 arm = p - collider.position;
+                    const glm::vec3 surfaceMotion = (collider.velocity + glm::cross(collider.angularVelocity, arm)) * h;
+                    const glm::vec3 relative = p - glm::vec3(prevX_[i], prevY_[i], prevZ_[i]) - surfaceMotion;
+                    const glm::vec3 sliding = relative - normal * glm::dot(relative, normal);
+                    const float slide = glm::length(sliding);
+                    if (slide > 0.0f) correction -= sliding * std::min(friction * depth / slide, 1.0f);
+
+                    p += correction;
+                    x_[i] = p.x;
+                    y_[i] = p.y;
+                    z_[i] = p.z;
+                    if (collider.dynamic) {
+                        const glm::vec3 momentum = correction / w;
+                        push[c] += momentum;
+                        moment[c] += glm::cross(arm, momentum);
+                    }
+                }
+            }
+        });
+    }
+
+    void SoftBodySystem::applyCouplingForces(PhysicsWorld& world, float h, float dt) {
+        // A push of d in a substep of length h gives the particle momentum m * d / h; the body gets
+        // the opposite, spread over the world's next step of length dt.
+        const size_t colliderCount = colliders_.size();
+        const size_t chunks = chunkPush_.size() / colliderCount;
+        std::vector<BodyHandle> handles(colliderCount);
+        for (size_t c = 0; c < colliderCount; ++c) handles[c] = world.handleAt(colliders_[c].bodyIndex);
+        for (size_t c = 0; c < colliderCount; ++c) {
+            if (!colliders_[c].dynamic) continue;
+            glm::vec3 push(0.0f), moment(0.0f);
+            for (size_t chunk = 0; chunk < chunks; ++chunk) {
+                push += chunkPush_[chunk * colliderCount + c];
+                moment += chunkMoment_[chunk * colliderCount + c];
+            }
+            if (push == glm::vec3(0.0f)) continue;
+            const float scale = -1.0f / (h * dt);
+            world.applyForce(handles[c], push * scale);
+            world.applyTorque(handles[c], moment * scale);
+        }
+    }
+
+} // namespace physics
@@ -0,0 +1,53 @@
+#include "physics/SpatialHashGrid.h"
+#include "utils/JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+
+namespace physics {
+
+    namespace {
+        constexpr size_t kBuildChunk = 4096;
+    }
+
+    void SpatialHashGrid::setCellSize(float cellSize) {
+        cellSize_ = std::max(cellSize, 1e-4f);
+        inverseCellSize_ = 1.0f / cellSize_;
+    }
+
+    void SpatialHashGrid::build(const float* x, const float* y, const float* z, size_t count) {
+        // About two buckets per point keeps collisions rare without bloating the prefix sums.
+        const uint32_t tableSize = std::bit_ceil(static_cast<uint32_t>(std::max<size_t>(count * 2, 64)));
+        tableMask_ = tableSize - 1;
+        cellStart_.assign(tableSize + 1, 0);
+        buckets_.resize(count);
+        ranks_.resize(count);
+        sorted_.resize(count);
+        if (count == 0) return;
+
+        auto& jobs = utils::JobSystem::getInstance();
+        const size_t chunks = (count + kBuildChunk - 1) / kBuildChunk;
+
+        // Count: each point claims the next slot of its bucket. Counts go one entry up so the
+        // inclusive scan below leaves bucket b spanning [cellStart_[b], cellStart_[b + 1]).
+        jobs.parallelFor(chunks, [&](size_t chunk) {
+            const size_t end = std::min(count, (chunk + 1) * kBuildChunk);
+            for (size_t i = chunk * kBuildChunk; i < end; ++i) {
+                const uint32_t bucket = hashCell(cellOf(glm::vec3(x[i], y[i], z[i])));
+                buckets_[i] = bucket;
+                ranks_[i] = std::atomic_ref<uint32_t>(cellStart_[bucket + 1]).fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+
+        for (uint32_t b = 1; b <= tableSize; ++b) cellStart_[b] += cellStart_[b - 1];
+
+        // Scatter: every point already knows its final slot, so writes never conflict.
+        jobs.parallelFor(chunks, [&](size_t chunk) {
+            const size_t end = std::min(count, (chunk + 1) * kBuildChunk);
+            for (size_t i = chunk * kBuildChunk; i < end; ++i) {
+                sorted_[cellStart_[buckets_[i]] + ranks_[i]] = static_cast<uint32_t>(i);
+            }
+        });
+    }
+
+} // namespace physics
@@ -0,0 +1,222 @@
+#include "physics/SweepAndPrune.h"
+#include "utils/JobSystem.h"
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define PHYSICS_SAP_SSE 1
+#endif
+
+namespace physics {
+
+    namespace {
+        constexpr size_t kSliceSize = 1024;
+        // Sentinels after the last sorted entry: never in range, so the sweep stops there and the
+        // four-wide loads can't read past the end.
+        constexpr size_t kPadding = 4;
+
+        // Maps a float to an unsigned key with the same ordering.
+        uint32_t sortableKey(float value) {
+            const uint32_t bits = std::bit_cast<uint32_t>(value);
+            return bits ^ ((bits >> 31) ? 0xFFFFFFFFu : 0x80000000u);
+        }
+    }
+
+    SweepAndPrune::SweepAndPrune(float margin)
+        : margin_(margin) {
+    }
+
+    ProxyId SweepAndPrune::createProxy(const Aabb& aabb, uint32_t userData) {
+        ProxyId proxy;
+        if (!freeProxies_.empty()) {
+            proxy = freeProxies_.back();
+            freeProxies_.pop_back();
+        }
+        else {
+            proxy = static_cast<ProxyId>(proxies_.size());
+            proxies_.emplace_back();
+        }
+        proxies_[proxy] = { aabb.fattened(margin_), userData, true };
+        ++proxyCount_;
+        return proxy;
+    }
+
+    void SweepAndPrune::destroyProxy(ProxyId proxy) {
+        if (proxy >= proxies_.size() || !proxies_[proxy].alive) return;
+        proxies_[proxy].alive = false;
+        freeProxies_.push_back(proxy);
+        --proxyCount_;
+    }
+
+    void SweepAndPrune::moveProxy(ProxyId proxy, const Aabb& aabb, const glm::vec3& /*displacement*/) {
+        // Everything is re-swept each call, so there is no structure to protect with a
+        // predictive box; the small margin only keeps resting contacts from flickering.
+        proxies_[proxy].aabb = aabb.fattened(margin_);
+    }
+
+    int SweepAndPrune::chooseSweepAxis() const {
+        glm::vec3 sum(0.0f);
+        glm::vec3 sumSquares(0.0f);
+        for (const Proxy& proxy : proxies_) {
+            if (!proxy.alive) continue;
+            const glm::vec3 c = proxy.aabb.center();
+            sum += c;
+            sumSquares += c * c;
+        }
+        const float n = static_cast<float>(std::max<size_t>(proxyCount_, 1));
+        const glm::vec3 variance = sumSquares / n - (sum / n) * (sum / n);
+        if (variance.y > variance.x && variance.y >= variance.z) return 1;
+        if (variance.z > variance.x && variance.z > variance.y) return 2;
+        return 0;
+    }
+
+    void SweepAndPrune::sortEndpoints(int axis) {
+        keys_.clear();
+        order_.clear();
+        for (size_t i = 0; i < proxies_.size(); ++i) {
+            if (!proxies_[i].alive) continue;
+            keys_.push_back(sortableKey(proxies_[i].aabb.min[axis]));
+            order_.push_back(static_cast<uint32_t>(i));
+        }
+
+        // LSD radix sort, three 11-bit digits. Stable, so ties keep proxy order.
+        const size_t n = keys_.size();
+        keysScratch_.resize(n);
+        orderScratch_.resize(n);
+        constexpr uint32_t kRadixBits = 11;
+        constexpr uint32_t kBuckets = 1u << kRadixBits;
+        uint32_t counts[kBuckets];
+        for (uint32_t shift = 0; shift < 32; shift += kRadixBits) {
+            std::fill(std::begin(counts), std::end(counts), 0u);
+            for (size_t i = 0; i < n; ++i) ++counts[(keys_[i] >> shift) & (kBuckets - 1)];
+            uint32_t offset = 0;
+            for (uint32_t& count : counts) {
+                const uint32_t c = count;
+                count = offset;
+                offset += c;
+            }
+            for (size_t i = 0; i < n; ++i) {
+                const uint32_t slot = counts[(keys_[i] >> shift) & (kBuckets - 1)]++;
+                keysScratch_[slot] = keys_[i];
+                orderScratch_[slot] = order_[i];
+            }
+            keys_.swap(keysScratch_);
+            order_.swap(orderScratch_);
+        }
+
+        // Gather the sorted bounds into columns for the sweep.
+        const int axisB = (axis + 1) % 3;
+        const int axisC = (axis + 2) % 3;
+        for (auto* column : { &minA_, &maxA_, &minB_, &maxB_, &minC_, &maxC_ }) column->resize(n + kPadding);
+        sortedUser_.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            const Proxy& proxy = proxies_[order_[i]];
+            minA_[i] = proxy.aabb.min[axis];
+            maxA_[i] = proxy.aabb.max[axis];
+            minB_[i] = proxy.aabb.min[axisB];
+            maxB_[i] = proxy.aabb.max[axisB];
+            minC_[i] = proxy.aabb.min[axisC];
+            maxC_[i] = proxy.aabb.max[axisC];
+            sortedUser_[i] = proxy.userData;
+        }
+        const float inf = std::numeric_limits<float>::infinity();
+        for (size_t i = n; i < n + kPadding; ++i) {
+            minA_[i] = minB_[i] = minC_[i] = inf;
+            maxA_[i] = maxB_[i] = maxC_[i] = -inf;
+        }
+    }
+
+    // Pairs every entry in [begin, end) with the later entries whose min lies inside its extent.
+    void SweepAndPrune::sweep(size_t begin, size_t end, std::vector<BroadphasePair>& out) const {
+        const float* __restrict minA = minA_.data();
+        const float* __restrict minB = minB_.data();
+        const float* __restrict maxB = maxB_.data();
+        const float* __restrict minC = minC_.data();
+        const float* __restrict maxC = maxC_.data();
+
+        auto report = [&](size_t i, size_t j) {
+            const uint32_t a = sortedUser_[i];
+            const uint32_t b = sortedUser_[j];
+            out.push_back({ std::min(a, b), std::max(a, b) });
+        };
+
+        for (size_t i = begin; i < end; ++i) {
+            const float limit = maxA_[i];
+            size_t j = i + 1;
+#ifdef PHYSICS_SAP_SSE
+            const __m128 vLimit = _mm_set1_ps(limit);
+            const __m128 vMinB = _mm_set1_ps(minB[i]);
+            const __m128 vMaxB = _mm_set1_ps(maxB[i]);
+            const __m128 vMinC = _mm_set1_ps(minC[i]);
+            const __m128 vMaxC = _mm_set1_ps(maxC[i]);
+            for (;; j += 4) {
+                const __m128 inRange = _mm_cmple_ps(_mm_loadu_ps(minA + j), vLimit);
+                const int rangeMask = _mm_movemask_ps(inRange);
+                if (rangeMask == 0) break;
+
+                __m128 overlap = _mm_and_ps(inRange, _mm_cmple_ps(_mm_loadu_ps(minB + j), vMaxB));
+                overlap = _mm_and_ps(overlap, _mm_cmple_ps(vMinB, _mm_loadu_ps(maxB + j)));
+                overlap = _mm_and_ps(overlap, _mm_cmple_ps(_mm_loadu_ps(minC + j), vMaxC));
+                overlap = _mm_and_ps(overlap, _mm_cmple_ps(vMinC, _mm_loadu_ps(maxC + j)));
+                for (unsigned mask = static_cast<unsigned>(_mm_movemask_ps(overlap)); mask != 0; mask &= mask - 1) {
+                    report(i, j + static_cast<size_t>(std::countr_zero(mask)));
+                }
+                // Mins are sorted, so a partial range mask means the run ended inside this group.
+                if (rangeMask != 0xF) break;
+            }
+#else
+            for (; minA[j] <= limit; ++j) {
+                if (minB[j] <= maxB[i] && minB[i] <= maxB[j] && minC[j] <= maxC[i] && minC[i] <= maxC[j]) {
+                    report(i, j);
+                }
+            }
+#endif
+        }
+    }
+
+    void SweepAndPrune::findPairs(std::vector<BroadphasePair>& pairs) {
+        pairs.clear();
+        if (proxyCount_ < 2) return;
+
+        sweepAxis_ = chooseSweepAxis();
+        sortEndpoints(sweepAxis_);
+
+        const size_t n = sortedUser_.size();
+        const size_t slices = (n + kSliceSize - 1) / kSliceSize;
+        if (slicePairs_.size() < slices) slicePairs_.resize(slices);
+
+        utils::JobSystem::getInstance().parallelFor(slices, [&](size_t slice) {
+            std::vector<BroadphasePair>& out = slicePairs_[slice];
+            out.clear();
+            sweep(slice * kSliceSize, std::min(n, (slice + 1) * kSliceSize), out);
+        });
+
+        size_t total = 0;
+        for (size_t s = 0; s < slices; ++s) total += slicePairs_[s].size();
+        pairs.reserve(total);
+        for (size_t s = 0; s < slices; ++s) {
+            pairs.insert(pairs.end(), slicePairs_[s].begin(), slicePairs_[s].end());
+        }
+        // Each overlapping pair is found exactly once (from its lower sorted entry).
+        std::sort(pairs.begin(), pairs.end());
+    }
+
+    void SweepAndPrune::queryAabb(const Aabb& aabb, const std::function<bool(uint32_t)>& visitor) const {
+        for (const Proxy& proxy : proxies_) {
+            if (proxy.alive && proxy.aabb.overlaps(aabb) && !visitor(proxy.userData)) return;
+        }
+    }
+
+    void SweepAndPrune::rayCast(const glm::vec3& origin, const glm::vec3& direction, float maxT,
+                                const std::function<float(uint32_t, float)>& visitor) const {
+        for (const Proxy& proxy : proxies_) {
+            if (!proxy.alive || proxy.aabb.rayCast(origin, direction, maxT) < 0.0f) continue;
+            const float value = visitor(proxy.userData, maxT);
+            if (value == 0.0f) return;
+            if (value > 0.0f) maxT = std::min(maxT, value);
+        }
+    }
+
+} // namespace physics
@@ -0,0 +1,57 @@
+#include "physics/TimeOfImpact.h"
+#include "physics/Gjk.h"
+#include <algorithm>
+#include <cmath>
+
+namespace physics {
+
+    namespace {
+        constexpr int kMaxIterations = 32;
+        // Distance accuracy of the advancement; the result stops short by at most this much.
+        constexpr float kTolerance = 0.25e-3f;
+
+        float rotationAngle(const glm::quat& q0, const glm::quat& q1) {
+            const float cosHalf = std::min(std::abs(glm::dot(q0, q1)), 1.0f);
+            return 2.0f * std::acos(cosHalf);
+        }
+
+        // Surface distance and unit direction from A towards B; negative once the cores overlap.
+        float surfaceDistance(const ConvexInstance& a, const ConvexInstance& b, glm::vec3& normal) {
+            const GjkResult gjk = gjkDistance(a, b);
+            if (gjk.overlap || gjk.distance <= 0.0f) return -1.0f;
+            normal = (gjk.pointB - gjk.pointA) / gjk.distance;
+            return gjk.distance - a.shape->coreRadius() - b.shape->coreRadius();
+        }
+    }
+
+    float timeOfImpact(const Shape& shapeA, const Sweep& sweepA, const Shape& shapeB, const Sweep& sweepB, float targetDistance) {
+        const glm::vec3 motionA = sweepA.position1 - sweepA.position0;
+        const glm::vec3 motionB = sweepB.position1 - sweepB.position0;
+        // Farthest any surface point can swing over the whole sweep.
+        const float angularBound = rotationAngle(sweepA.orientation0, sweepA.orientation1) * shapeA.boundingRadius()
+                                 + rotationAngle(sweepB.orientation0, sweepB.orientation1) * shapeB.boundingRadius();
+
+        float t = 0.0f;
+        for (int iteration = 0; iteration < kMaxIterations; ++iteration) {
+            const ConvexInstance a{ &shapeA, sweepA.position(t), sweepA.orientation(t) };
+            const ConvexInstance b{ &shapeB, sweepB.position(t), sweepB.orientation(t) };
+            glm::vec3 normal;
+            const float distance = surfaceDistance(a, b, normal);
+            if (iteration == 0 && distance <= targetDistance + kTolerance) {
+                // Already touching: sliding along the contact is fine, but driving into it by more
+                // than the target (say, shoved by something landing on top) is stopped early.
+                if (distance < 0.0f) return 1.0f;
+                const float pushing = glm::dot(motionA - motionB, normal);
+                return pushing > targetDistance ? targetDistance / pushing : 1.0f;
+            }
+            if (distance <= targetDistance + kTolerance) return t;
+
+            const float closing = glm::dot(motionA - motionB, normal) + angularBound;
+            if (closing <= 0.0f) return 1.0f;
+            t += (distance - targetDistance) / closing;
+            if (t >= 1.0f) return 1.0f;
+        }
+        return t;
+    }
+
+} // namespace physics
@@ -0,0 +1,190 @@
+#include "physics/VectorField.h"
+#include "physics/SimdFloat.h"
+#include "utils/JobSystem.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+
+namespace physics {
+
+    namespace {
+        // Points per job for the batch sampler; a few pages of input per job.
+        constexpr size_t kSampleChunk = 4096;
+
+        glm::vec3 lerp(const glm::vec3& a, const glm::vec3& b, float t) { return a + (b - a) * t; }
+        SimdFloat lerp(SimdFloat a, SimdFloat b, SimdFloat t) { return a + (b - a) * t; }
+    }
+
+    VectorField::VectorField(const glm::vec3& origin, float cellSize, const glm::ivec3& resolution)
+        : origin_(origin), cellSize_(std::max(cellSize, 1e-4f)), inverseCellSize_(1.0f / cellSize_),
+          resolution_(glm::max(resolution, glm::ivec3(2))) {
+        values_.assign(static_cast<size_t>(resolution_.x) * resolution_.y * resolution_.z, glm::vec3(0.0f));
+    }
+
+    void VectorField::fill(const glm::vec3& value) {
+        std::fill(values_.begin(), values_.end(), value);
+    }
+
+    void VectorField::setRegion(const glm::ivec3& first, const glm::ivec3& count, const glm::vec3* values) {
+        const glm::ivec3 end = first + count;
+        if (glm::any(glm::lessThan(first, glm::ivec3(0))) || glm::any(glm::lessThanEqual(count, glm::ivec3(0))) ||
+            glm::any(glm::greaterThan(end, resolution_))) {
+            spdlog::warn("VectorField: Region ({}, {}, {}) + ({}, {}, {}) is outside the grid",
+                         first.x, first.y, first.z, count.x, count.y, count.z);
+            return;
+        }
+        for (int z = 0; z < count.z; ++z) {
+            for (int y = 0; y < count.y; ++y) {
+                std::copy_n(values, count.x, values_.begin() + static_cast<std::ptrdiff_t>(nodeIndex(first + glm::ivec3(0, y, z))));
+                values += count.x;
+            }
+        }
+    }
+
+    void VectorField::updateRegion(const Aabb& bounds, const std::function<glm::vec3(const glm::vec3&)>& generator) {
+        const glm::ivec3 first = glm::max(glm::ivec3(glm::ceil((bounds.min - origin_) * inverseCellSize_)), glm::ivec3(0));
+        const glm::ivec3 last = glm::min(glm::ivec3(glm::floor((bounds.max - origin_) * inverseCellSize_)), resolution_ - 1);
+        if (glm::any(glm::greaterThan(first, last))) return;
+
+        // One job per row of nodes along x.
+        const int rowsY = last.y - first.y + 1;
+        const size_t rows = static_cast<size_t>(rowsY) * (last.z - first.z + 1);
+        utils::JobSystem::getInstance().parallelFor(rows, [&](size_t row) {
+            const glm::ivec3 start(first.x, first.y + static_cast<int>(row % rowsY), first.z + static_cast<int>(row / rowsY));
+            size_t index = nodeIndex(start);
+            for (int x = first.x; x <= last.x; ++x, ++index) {
+                values_[index] = generator(nodePosition({ x, start.y, start.z }));
+            }
+        }, 16);
+    }
+
+    void VectorField::locate(const glm::vec3& position, glm::ivec3& cell, glm::vec3& fraction) const {
+        const glm::vec3 local = (position - origin_) * inverseCellSize_;
+        for (int axis = 0; axis < 3; ++axis) {
+            // max(0, x) first so NaN lands on the boundary too.
+            const float c = std::min(std::max(0.0f, local[axis]), static_cast<float>(resolution_[axis] - 1));
+            cell[axis] = std::min(static_cast<int>(c), resolution_[axis] - 2);
+            fraction[axis] = c - static_cast<float>(cell[axis]);
+        }
+    }
+
+    glm::vec3 VectorField::sample(const glm::vec3& position) const {
+        glm::ivec3 cell;
+        glm::vec3 f;
+        locate(position, cell, f);
+        const size_t strideY = static_cast<size_t>(resolution_.x);
+        const size_t strideZ = strideY * resolution_.y;
+        const glm::vec3* c = values_.data() + nodeIndex(cell);
+        const glm::vec3 y0 = lerp(lerp(c[0], c[1], f.x), lerp(c[strideY], c[strideY + 1], f.x), f.y);
+        const glm::vec3 y1 = lerp(lerp(c[strideZ], c[strideZ + 1], f.x), lerp(c[strideZ + strideY], c[strideZ + strideY + 1], f.x), f.y);
+        return lerp(y0, y1, f.z);
+    }
+
+    void VectorField::sample(const float* x, const float* y, const float* z, size_t count,
+                             float* outX, float* outY, float* outZ) const {
+        const size_t chunks = (count + kSampleChunk - 1) / kSampleChunk;
+        utils::JobSystem::getInstance().parallelFor(chunks, [&](size_t chunk) {
+            const size_t begin = chunk * kSampleChunk;
+            sampleRange(x, y, z, begin, std::min(begin + kSampleChunk, count), outX, outY, outZ);
+        });
+    }
+
+    void VectorField::sampleRange(const float* x, const float* y, const float* z, size_t begin, size_t end,
+                                  float* outX, float* outY, float* outZ) const {
+        constexpr int W = SimdFloat::kWidth;
+        const size_t strideY = static_cast<size_t>(resolution_.x);
+        const size_t strideZ = strideY * resolution_.y;
+        const size_t corners[8] = { 0, 1, strideY, strideY + 1, strideZ, strideZ + 1, strideZ + strideY, strideZ + strideY + 1 };
+
+        const SimdFloat zero = SimdFloat::zero();
+        const SimdFloat one = SimdFloat::splat(1.0f);
+        const SimdFloat scale = SimdFloat::splat(inverseCellSize_);
+        const SimdVec3 origin{ SimdFloat::splat(origin_.x), SimdFloat::splat(origin_.y), SimdFloat::splat(origin_.z) };
+        const SimdVec3 maxNode{ SimdFloat::splat(static_cast<float>(resolution_.x - 1)),
+                                SimdFloat::splat(static_cast<float>(resolution_.y - 1)),
+                                SimdFloat::splat(static_cast<float>(resolution_.z - 1)) };
+        const SimdVec3 maxCell{ SimdFloat::splat(static_cast<float>(resolution_.x - 2)),
+                                SimdFloat::splat(static_cast<float>(resolution_.y - 2)),
+                                SimdFloat::splat(static_cast<float>(resolution_.z - 2)) };
+
+        // Cells and the eight corner weights are computed W lanes at a time; each lane then sums
+        // its weighted corners, which are adjacent in memory apart from the row and slice strides.
+        alignas(64) int32_t cell[3][W];
+        alignas(64) float weights[8][W];
+
+        size_t i = begin;
+        for (; i + W <= end; i += W) {
+            // Clamping with the position first maps NaN lanes to 0 as well.
+            SimdVec3 c{ max((SimdFloat::load(x + i) - origin.x) * scale, zero),
+                        max((SimdFloat::load(y + i) - origin.y) * scale, zero),
+                        max((SimdFloat::load(z + i) - origin.z) * scale, zero) };
+            c = { min(c.x, maxNode.x), min(c.y, maxNode.y), min(c.z, maxNode.z) };
+            const SimdVec3 base{ min(c.x, maxCell.x), min(c.y, maxCell.y), min(c.z, maxCell.z) };
+            const SimdVec3 f{ c.x - base.x.truncate(), c.y - base.y.truncate(), c.z - base.z.truncate() };
+            base.x.storeTruncated(cell[0]);
+            base.y.storeTruncated(cell[1]);
+            base.z.storeTruncated(cell[2]);
+
+            const SimdVec3 g{ one - f.x, one - f.y, one - f.z };
+            const SimdFloat y0z0 = g.y * g.z, y1z0 = f.y * g.z, y0z1 = g.y * f.z, y1z1 = f.y * f.z;
+            (g.x * y0z0).store(weights[0]);
+            (f.x * y0z0).store(weights[1]);
+            (g.x * y1z0).store(weights[2]);
+            (f.x * y1z0).store(weights[3]);
+            (g.x * y0z1).store(weights[4]);
+            (f.x * y0z1).store(weights[5]);
+            (g.x * y1z1).store(weights[6]);
+            (f.x * y1z1).store(weights[7]);
+
+            for (int lane = 0; lane < W; ++lane) {
+                const glm::vec3* node = values_.data() + nodeIndex({ cell[0][lane], cell[1][lane], cell[2][lane] });
+                glm::vec3 v = node[0] * weights[0][lane];
+                for (int k = 1; k < 8; ++k) v += node[corners[k]] * weights[k][lane];
+                outX[i + lane] = v.x;
+                outY[i + lane] = v.y;
+                outZ[i + lane] = v.z;
+            }
+        }
+        for (; i < end; ++i) {
+            const glm::vec3 v = sample(glm::vec3(x[i], y[i], z[i]));
+            outX[i] = v.x;
+            outY[i] = v.y;
+            outZ[i] = v.z;
+        }
+    }
+
+    glm::mat3 VectorField::jacobian(const glm::vec3& position) const {
+        glm::ivec3 cell;
+        glm::vec3 f;
+        locate(position, cell, f);
+        const size_t strideY = static_cast<size_t>(resolution_.x);
+        const size_t strideZ = strideY * resolution_.y;
+        const glm::vec3* c = values_.data() + nodeIndex(cell);
+        const glm::vec3& c000 = c[0];
+        const glm::vec3& c100 = c[1];
+        const glm::vec3& c010 = c[strideY];
+        const glm::vec3& c110 = c[strideY + 1];
+        const glm::vec3& c001 = c[strideZ];
+        const glm::vec3& c101 = c[strideZ + 1];
+        const glm::vec3& c011 = c[strideZ + strideY];
+        const glm::vec3& c111 = c[strideZ + strideY + 1];
+
+        // Partial derivatives of the trilinear blend: the edge differences along one axis,
+        // bilinearly weighted over the other two.
+        const glm::vec3 dx = lerp(lerp(c100 - c000, c110 - c010, f.y), lerp(c101 - c001, c111 - c011, f.y), f.z);
+        const glm::vec3 dy = lerp(lerp(c010 - c000, c110 - c100, f.x), lerp(c011 - c001, c111 - c101, f.x), f.z);
+        const glm::vec3 dz = lerp(lerp(c001 - c000, c101 - c100, f.x), lerp(c011 - c010, c111 - c110, f.x), f.y);
+        return glm::mat3(dx, dy, dz) * inverseCellSize_;
+    }
+
+    glm::vec3 VectorField::curl(const glm::vec3& position) const {
+        const glm::mat3 j = jacobian(position);
+        return { j[1].z - j[2].y, j[2].x - j[0].z, j[0].y - j[1].x };
+    }
+
+    float VectorField::divergence(const glm::vec3& position) const {
+        const glm::mat3 j = jacobian(position);
+        return j[0].x + j[1].y + j[2].z;
+    }
+
+} // namespace physics
@@ -0,0 +1,58 @@
+#include "ui/BodyInspector.h"
+#include "ui/UIPropertyDescription.h"
+
+namespace ui {
+
+    namespace {
+        UIPropertyDescription vectorProperty(const std::string& name, const glm::vec3& value) {
+            UIPropertyDescription description(name);
+            description.setReadOnly(true);
+            description.addField("X", FieldType::Float, value.x);
+            description.addField("Y", FieldType::Float, value.y);
+            description.addField("Z", FieldType::Float, value.z);
+            return description;
+        }
+    }
+
+    BodyInspector::BodyInspector(physics::PhysicsBody body)
+        : body_(body) {
+        stateField_ = binding_.registerField("Motion.State", std::string(getStateName(body_)));
+        const char* axes[3] = { "X", "Y", "Z" };
+        for (int axis = 0; axis < 3; ++axis) {
+            positionFields_[axis] = binding_.registerField(std::string("Position.") + axes[axis]);
+            velocityFields_[axis] = binding_.registerField(std::string("Velocity.") + axes[axis]);
+        }
+    }
+
+    void BodyInspector::publish() {
+        binding_.publish(stateField_, std::string(getStateName(body_)));
+        if (!body_.isValid()) return;
+        const glm::vec3 position = body_.getPosition();
+        const glm::vec3 velocity = body_.getVelocity();
+        for (int axis = 0; axis < 3; ++axis) {
+            binding_.publish(positionFields_[axis], position[axis]);
+            binding_.publish(velocityFields_[axis], velocity[axis]);
+        }
+    }
+
+    const char* BodyInspector::getStateName(const physics::PhysicsBody& body) {
+        if (!body.isValid()) return "Destroyed";
+        const uint32_t flags = body.getFlags();
+        if (flags & physics::kBodyStatic) return "Static";
+        if (flags & physics::kBodyKinematic) return "Kinematic";
+        return (flags & physics::kBodySleeping) ? "Sleeping" : "Awake";
+    }
+
+    std::string BodyInspector::getObjectName() const {
+        return "Body " + std::to_string(body_.getHandle().id);
+    }
+
+    std::vector<UIPropertyDescription> BodyInspector::getProperties() const {
+        UIPropertyDescription state("Motion");
+        state.setReadOnly(true);
+        state.addField("State", FieldType::String, std::string(getStateName(body_)));
+        if (!body_.isValid()) return { state };
+        return { state, vectorProperty("Position", body_.getPosition()), vectorProperty("Velocity", body_.getVelocity()) };
+    }
+
+} // namespace ui
@@ -0,0 +1,54 @@
+#include "ui/HeadlessRenderer.h"
+
+namespace ui {
+
+HeadlessRenderer::HeadlessRenderer(const glm::vec2& screenSize)
+    : screenSize_(screenSize) {
+}
+
+void HeadlessRenderer::drawRect(const glm::vec2&, const glm::vec2&, const glm::vec4&) {
+    ++stats_.rects;
+}
+
+void HeadlessRenderer::drawLine(const glm::vec2&, const glm::vec2&, const glm::vec4&) {
+    ++stats_.lines;
+}
+
+void HeadlessRenderer::drawLines(const glm::vec2*, size_t vertexCount, const glm::vec4&) {
+    ++stats_.lineBatches;
+    stats_.lines += vertexCount / 2;
+}
+
+void HeadlessRenderer::drawText(const glm::vec2&, const std::string&, const glm::vec4&, float) {
+    ++stats_.texts;
+}
+
+void HeadlessRenderer::drawTexture(const glm::vec2&, const glm::vec2&, ITexture* texture) {
+    if (!texture) return;
+    ++stats_.textures;
+}
+
+glm::vec2 HeadlessRenderer::measureText(const std::string& text, float fontSize) {
+    ++stats_.measures;
+    // Fixed-advance approximation: half an em per byte, one em high.
+    return glm::vec2(static_cast<float>(text.size()) * fontSize * 0.5f, fontSize);
+}
+
+void HeadlessRenderer::setClipRect(const glm::vec2& position, const glm::vec2& size) {
+    ++stats_.clips;
+    clipRect_ = std::make_pair(position, size);
+}
+
+void HeadlessRenderer::resetClipRect() {
+    clipRect_.reset();
+}
+
+void* HeadlessRenderer::getNVGContext() {
+    return nullptr;
+}
+
+glm::vec2 HeadlessRenderer::getScreenSize() const {
+    return screenSize_;
+}
+
+} // namespace ui
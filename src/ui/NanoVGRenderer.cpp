@@ -30,6 +30,18 @@ void NanoVGRenderer::drawLine(const glm::vec2& start, const glm::vec2& end, cons
     nvgStroke(ctx_);
 }
 
+void NanoVGRenderer::drawLines(const glm::vec2* vertices, size_t vertexCount, const glm::vec4& color) {
+    if (!vertices || vertexCount < 2) return;
+    // One path and one stroke for the whole batch.
+    nvgBeginPath(ctx_);
+    for (size_t i = 0; i + 1 < vertexCount; i += 2) {
+        nvgMoveTo(ctx_, vertices[i].x, vertices[i].y);
+        nvgLineTo(ctx_, vertices[i + 1].x, vertices[i + 1].y);
+    }
+    nvgStrokeColor(ctx_, nvgRGBAf(color.r, color.g, color.b, color.a));
+    nvgStroke(ctx_);
+}
+
 void NanoVGRenderer::drawText(const glm::vec2& position, const std::string& text, const glm::vec4& color, float fontSize) {
     nvgFontSize(ctx_, fontSize);
     nvgFontFace(ctx_, "sans"); // Using default font; ideally, obtain from theme
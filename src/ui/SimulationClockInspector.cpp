@@ -0,0 +1,43 @@
+#include "ui/SimulationClockInspector.h"
+#include "ui/UIPropertyDescription.h"
+#include <utility>
+
+namespace ui {
+
+    SimulationClockInspector::SimulationClockInspector(std::shared_ptr<const physics::SimulationClock> clock)
+        : clock_(std::move(clock)) {
+        frameField_ = binding_.registerField("Timing.Frame ms");
+        substepsField_ = binding_.registerField("Timing.Substeps");
+        stepMsField_ = binding_.registerField("Timing.Step ms");
+        alphaField_ = binding_.registerField("Timing.Alpha");
+        timeField_ = binding_.registerField("Timing.Sim Time");
+        droppedField_ = binding_.registerField("Timing.Dropped ms");
+    }
+
+    void SimulationClockInspector::publish() {
+        binding_.publish(frameField_, static_cast<float>(clock_->getLastFrameMs()));
+        binding_.publish(substepsField_, static_cast<float>(clock_->getLastSubsteps()));
+        binding_.publish(stepMsField_, static_cast<float>(clock_->getLastStepMs()));
+        binding_.publish(alphaField_, clock_->getAlpha());
+        binding_.publish(timeField_, static_cast<float>(clock_->getSimulationTime()));
+        binding_.publish(droppedField_, static_cast<float>(clock_->getDroppedTime() * 1000.0));
+    }
+
+    std::vector<UIPropertyDescription> SimulationClockInspector::getProperties() const {
+        UIPropertyDescription settings("Settings");
+        settings.setReadOnly(true);
+        settings.addField("Step Hz", FieldType::Float, static_cast<float>(clock_->getStepRate()));
+        settings.addField("Max Substeps", FieldType::Float, static_cast<float>(clock_->getMaxSubsteps()));
+
+        UIPropertyDescription timing("Timing");
+        timing.setReadOnly(true);
+        timing.addField("Frame ms", FieldType::Float, static_cast<float>(clock_->getLastFrameMs()));
+        timing.addField("Substeps", FieldType::Float, static_cast<float>(clock_->getLastSubsteps()));
+        timing.addField("Step ms", FieldType::Float, static_cast<float>(clock_->getLastStepMs()));
+        timing.addField("Alpha", FieldType::Float, clock_->getAlpha());
+        timing.addField("Sim Time", FieldType::Float, static_cast<float>(clock_->getSimulationTime()));
+        timing.addField("Dropped ms", FieldType::Float, static_cast<float>(clock_->getDroppedTime() * 1000.0));
+        return { settings, timing };
+    }
+
+} // namespace ui
@@ -81,6 +81,7 @@ namespace ui {
     void UICanvas::addChild(std::unique_ptr<UIElement> child) {
         if (child) {
             child->setParent(this);
+            focusOrder_.insert(child.get());
             getMutableChildren().push_back(std::move(child));
             updateLayout();
             markDirty();
@@ -88,6 +89,7 @@ namespace ui {
     }
 
     void UICanvas::removeChild(const UIElement* child) {
+        focusOrder_.erase(child);
         auto& children = getMutableChildren();
         children.erase(std::remove_if(children.begin(), children.end(),
             [child](const std::unique_ptr<UIElement>& ptr) {
@@ -98,6 +100,10 @@ namespace ui {
         markDirty();
     }
 
+    void UICanvas::onChildFocusPriorityChanged(UIElement* child) {
+        focusOrder_.update(child);
+    }
+
     void UICanvas::addScrollbar(std::unique_ptr<UIScrollbar> scrollbar) {
         if (scrollbar) {
             scrollbar->setParent(this);
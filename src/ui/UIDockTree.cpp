@@ -0,0 +1,301 @@
+#include "ui/UIDockTree.h"
+#include "ui/UIDockable.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+
+namespace ui {
+
+    UIDockTree::UIDockTree() {
+        root_ = allocate();
+        nodes_[root_].workspace = true;
+    }
+
+    UIDockTree::NodeId UIDockTree::allocate() {
+        if (!freeNodes_.empty()) {
+            NodeId id = freeNodes_.back();
+            freeNodes_.pop_back();
+            nodes_[id] = Node{};
+            return id;
+        }
+        nodes_.emplace_back();
+        return static_cast<NodeId>(nodes_.size() - 1);
+    }
+
+    void UIDockTree::release(NodeId id) {
+        nodes_[id] = Node{};
+        freeNodes_.push_back(id);
+    }
+
+    void UIDockTree::setBounds(const glm::vec2& position, const glm::vec2& size) {
+        if (position == boundsPosition_ && size == boundsSize_) return;
+        boundsPosition_ = position;
+        boundsSize_ = size;
+        solve(root_, position, size);
+    }
+
+    bool UIDockTree::dock(UIDockable* panel, NodeId target, DockSide side) {
+        if (!panel || target >= nodes_.size() || contains(panel)) return false;
+
+        if (side == DockSide::Tab) {
+            if (nodes_[target].isSplit) {
+                spdlog::warn("UIDockTree: cannot add a tab to split node {}", target);
+                return false;
+            }
+            Node& leaf = nodes_[target];
+            leaf.tabs.push_back(panel);
+            leaf.activeTab = leaf.tabs.size() - 1;
+            panelLeaf_[panel] = target;
+            applyLeaf(leaf);
+            return true;
+        }
+
+        const bool horizontal = side == DockSide::Left || side == DockSide::Right;
+        const bool panelFirst = side == DockSide::Left || side == DockSide::Top;
+        const glm::vec2 position = nodes_[target].position;
+        const glm::vec2 size = nodes_[target].size;
+        const NodeId parent = nodes_[target].parent;
+
+        // Keep the panel's current extent along the split axis where it fits.
+        const float extent = horizontal ? size.x : size.y;
+        const float panelExtent = horizontal ? panel->getSize().x : panel->getSize().y;
+        const float fraction = extent > 0.0f ? std::clamp(panelExtent / extent, kMinRatio, kMaxRatio) : 0.5f;
+
+        const NodeId leafId = allocate();
+        const NodeId splitId = allocate();
+        Node& leaf = nodes_[leafId];
+        leaf.tabs.push_back(panel);
+        leaf.parent = splitId;
+
+        Node& split = nodes_[splitId];
+        split.isSplit = true;
+        split.horizontal = horizontal;
+        split.ratio = panelFirst ? fraction : 1.0f - fraction;
+        split.first = panelFirst ? leafId : target;
+        split.second = panelFirst ? target : leafId;
+        split.parent = parent;
+
+        nodes_[target].parent = splitId;
+        replaceChild(parent, target, splitId);
+        panelLeaf_[panel] = leafId;
+
+        solve(splitId, position, size);
+        return true;
+    }
+
+    bool UIDockTree::undock(UIDockable* panel) {
+        auto found = panelLeaf_.find(panel);
+        if (found == panelLeaf_.end()) return false;
+        const NodeId leafId = found->second;
+        panelLeaf_.erase(found);
+
+        Node& leaf = nodes_[leafId];
+        leaf.tabs.erase(std::remove(leaf.tabs.begin(), leaf.tabs.end(), panel), leaf.tabs.end());
+        if (leaf.activeTab >= leaf.tabs.size()) leaf.activeTab = leaf.tabs.empty() ? 0 : leaf.tabs.size() - 1;
+        panel->setVisible(true);
+
+        if (!leaf.tabs.empty() || leaf.workspace || leaf.parent == kInvalidNode) {
+            applyLeaf(leaf);
+            edgesDirty_ = true;
+            return true;
+        }
+
+        // Collapse: the sibling takes over the parent split's slot and rect.
+        const NodeId splitId = leaf.parent;
+        const Node& split = nodes_[splitId];
+        const NodeId siblingId = split.first == leafId ? split.second : split.first;
+        const NodeId grandParent = split.parent;
+        const glm::vec2 position = split.position;
+        const glm::vec2 size = split.size;
+
+        nodes_[siblingId].parent = grandParent;
+        replaceChild(grandParent, splitId, siblingId);
+        release(leafId);
+        release(splitId);
+        solve(siblingId, position, size);
+        return true;
+    }
+
+    void UIDockTree::replaceChild(NodeId parent, NodeId oldChild, NodeId newChild) {
+        if (parent == kInvalidNode) {
+            root_ = newChild;
+            return;
+        }
+        Node& node = nodes_[parent];
+        if (node.first == oldChild) node.first = newChild;
+        else if (node.second == oldChild) node.second = newChild;
+    }
+
+    void UIDockTree::setRatio(NodeId split, float ratio) {
+        if (split >= nodes_.size() || !nodes_[split].isSplit) return;
+        Node& node = nodes_[split];
+        ratio = std::clamp(ratio, kMinRatio, kMaxRatio);
+        if (node.ratio == ratio) return;
+        node.ratio = ratio;
+        solve(split, node.position, node.size);
+    }
+
+    void UIDockTree::setActiveTab(UIDockable* panel) {
+        auto found = panelLeaf_.find(panel);
+        if (found == panelLeaf_.end()) return;
+        Node& leaf = nodes_[found->second];
+        auto it = std::find(leaf.tabs.begin(), leaf.tabs.end(), panel);
+        leaf.activeTab = static_cast<size_t>(it - leaf.tabs.begin());
+        applyLeaf(leaf);
+    }
+
+    UIDockTree::NodeId UIDockTree::findLeaf(const UIDockable* panel) const {
+        auto found = panelLeaf_.find(panel);
+        return found == panelLeaf_.end() ? kInvalidNode : found->second;
+    }
+
+    void UIDockTree::solve(NodeId id, const glm::vec2& position, const glm::vec2& size) {
+        Node& node = nodes_[id];
+        node.position = position;
+        node.size = size;
+        edgesDirty_ = true;
+
+        if (!node.isSplit) {
+            applyLeaf(node);
+            return;
+        }
+
+        const NodeId first = node.first;
+        const NodeId second = node.second;
+        if (node.horizontal) {
+            const float available = std::max(size.x - kSplitterThickness, 0.0f);
+            const float firstWidth = available * node.ratio;
+            solve(first, position, glm::vec2(firstWidth, size.y));
+            solve(second, glm::vec2(position.x + firstWidth + kSplitterThickness, position.y),
+                  glm::vec2(available - firstWidth, size.y));
+        }
+        else {
+            const float available = std::max(size.y - kSplitterThickness, 0.0f);
+            const float firstHeight = available * node.ratio;
+            solve(first, position, glm::vec2(size.x, firstHeight));
+            solve(second, glm::vec2(position.x, position.y + firstHeight + kSplitterThickness),
+                  glm::vec2(size.x, available - firstHeight));
+        }
+    }
+
+    void UIDockTree::applyLeaf(const Node& leaf) {
+        for (size_t i = 0; i < leaf.tabs.size(); ++i) {
+            UIDockable* panel = leaf.tabs[i];
+            const bool active = i == leaf.activeTab;
+            panel->setVisible(active);
+            if (active) {
+                panel->setPosition(leaf.position);
+                panel->setSize(leaf.size);
+            }
+        }
+    }
+
+    void UIDockTree::rebuildEdges() const {
+        verticalEdges_.clear();
+        horizontalEdges_.clear();
+
+        // Screen edges dock against the whole tree.
+        const glm::vec2 min = boundsPosition_;
+        const glm::vec2 max = boundsPosition_ + boundsSize_;
+        verticalEdges_.push_back({ min.x, min.y, max.y, root_, DockSide::Left });
+        verticalEdges_.push_back({ max.x, min.y, max.y, root_, DockSide::Right });
+        horizontalEdges_.push_back({ min.y, min.x, max.x, root_, DockSide::Top });
+        horizontalEdges_.push_back({ max.y, min.x, max.x, root_, DockSide::Bottom });
+
+        std::vector<NodeId> stack{ root_ };
+        while (!stack.empty()) {
+            const NodeId id = stack.back();
+            stack.pop_back();
+            const Node& node = nodes_[id];
+            if (node.isSplit) {
+                stack.push_back(node.first);
+                stack.push_back(node.second);
+                continue;
+            }
+            if (node.tabs.empty()) continue; // Empty workspace only accepts tabs.
+            const glm::vec2 lo = node.position;
+            const glm::vec2 hi = node.position + node.size;
+            verticalEdges_.push_back({ lo.x, lo.y, hi.y, id, DockSide::Left });
+            verticalEdges_.push_back({ hi.x, lo.y, hi.y, id, DockSide::Right });
+            horizontalEdges_.push_back({ lo.y, lo.x, hi.x, id, DockSide::Top });
+            horizontalEdges_.push_back({ hi.y, lo.x, hi.x, id, DockSide::Bottom });
+        }
+
+        std::stable_sort(verticalEdges_.begin(), verticalEdges_.end());
+        std::stable_sort(horizontalEdges_.begin(), horizontalEdges_.end());
+        edgesDirty_ = false;
+    }
+
+    bool UIDockTree::inside(const Node& node, const glm::vec2& point) {
+        return point.x >= node.position.x && point.x <= node.position.x + node.size.x &&
+               point.y >= node.position.y && point.y <= node.position.y + node.size.y;
+    }
+
+    UIDockTree::NodeId UIDockTree::leafAt(const glm::vec2& point) const {
+        NodeId id = root_;
+        if (!inside(nodes_[id], point)) return kInvalidNode;
+        while (nodes_[id].isSplit) {
+            const Node& split = nodes_[id];
+            id = inside(nodes_[split.first], point) ? split.first : split.second;
+        }
+        return id;
+    }
+
+    void UIDockTree::previewRect(const Node& node, DockSide side, glm::vec2& position, glm::vec2& size) {
+        position = node.position;
+        size = node.size;
+        switch (side) {
+            case DockSide::Left:   size.x *= 0.5f; break;
+            case DockSide::Right:  size.x *= 0.5f; position.x += size.x; break;
+            case DockSide::Top:    size.y *= 0.5f; break;
+            case DockSide::Bottom: size.y *= 0.5f; position.y += size.y; break;
+            case DockSide::Tab:    break;
+        }
+    }
+
+    std::optional<DockSnapTarget> UIDockTree::querySnap(const glm::vec2& point, const UIDockable* dragged, float threshold) const {
+        if (edgesDirty_) rebuildEdges();
+
+        const Edge* best = nullptr;
+        float bestDistance = threshold;
+        auto scan = [&](const std::vector<Edge>& edges, float along, float across) {
+            // Only the edges within `threshold` of the pointer are visited.
+            auto first = std::lower_bound(edges.begin(), edges.end(), Edge{ along - threshold, 0, 0, 0, DockSide::Left });
+            for (auto it = first; it != edges.end() && it->coord <= along + threshold; ++it) {
+                if (across < it->lo || across > it->hi) continue;
+                if (it->node != root_ && !inside(nodes_[it->node], point)) continue;
+                const Node& node = nodes_[it->node];
+                if (node.tabs.size() == 1 && node.tabs[0] == dragged) continue;
+                const float distance = std::abs(along - it->coord);
+                // Screen edges sort ahead of leaf edges at the same coordinate and win ties.
+                if (distance < bestDistance) {
+                    best = &*it;
+                    bestDistance = distance;
+                }
+            }
+        };
+        scan(verticalEdges_, point.x, point.y);
+        scan(horizontalEdges_, point.y, point.x);
+
+        DockSnapTarget target{};
+        if (best) {
+            target.node = best->node;
+            target.side = best->side;
+        }
+        else {
+            // Away from every edge: drop onto the central area of the leaf under the pointer as a tab.
+            const NodeId leafId = leafAt(point);
+            if (leafId == kInvalidNode) return std::nullopt;
+            const Node& leaf = nodes_[leafId];
+            const float u = (point.x - leaf.position.x) / std::max(leaf.size.x, 1.0f);
+            const float v = (point.y - leaf.position.y) / std::max(leaf.size.y, 1.0f);
+            const bool central = u > 0.25f && u < 0.75f && v > 0.25f && v < 0.75f;
+            if (!leaf.tabs.empty() && !central) return std::nullopt;
+            target.node = leafId;
+            target.side = DockSide::Tab;
+        }
+        previewRect(nodes_[target.node], target.side, target.previewPosition, target.previewSize);
+        return target;
+    }
+
+} // namespace ui
@@ -23,22 +23,9 @@ namespace ui {
 
     void UIDockable::setDockPosition(DockPosition position) {
         dockPosition_ = position;
-        updateDocking();
         markDirty();
     }
 
-    void UIDockable::updateDocking() {
-        // Remove dependency on UIManager::getScreenSize() by using a fallback.
-        glm::vec2 screenSize(1280.0f, 720.0f);
-        if (dockPosition_ == DockPosition::Top) {
-            setPosition(glm::vec2(0.0f, 0.0f));
-        }
-        else if (dockPosition_ == DockPosition::Bottom) {
-            setPosition(glm::vec2(0.0f, screenSize.y - size_.y));
-        }
-        // Left and Right can be added similarly.
-    }
-
     void UIDockable::setTitle(const std::string& title) {
         title_ = title;
         if (titleLabel_) {
@@ -85,13 +72,12 @@ namespace ui {
         if (mouseEvent->getType() == EventType::MousePress && mouseEvent->getButton() == MouseButton::Left && isInsideTitleBar) {
             isDragging_ = true;
             dragStart_ = pos - position_;
-            if (dockPosition_ != DockPosition::None) {
-                dockPosition_ = DockPosition::None;
-            }
+            // Still docked until the first move pulls it out (UIManager::handleDockableDragging).
             return true;
         }
         else if (mouseEvent->getType() == EventType::MouseMove && isDragging_) {
             setPosition(pos - dragStart_);
+            UIManager::getInstance().handleDockableDragging(this, pos);
             return true;
         }
         else if (mouseEvent->getType() == EventType::MouseRelease && isDragging_) {
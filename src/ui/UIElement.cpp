@@ -40,6 +40,12 @@ namespace ui {
         markDirty();
     }
 
+    void UIElement::setFocusPriority(int priority) {
+        if (focusPriority_ == priority) return;
+        focusPriority_ = priority;
+        if (parent_ && *parent_) (*parent_)->onChildFocusPriorityChanged(this);
+    }
+
     void UIElement::setFocus(bool focused) {
         focused_ = focused;
         if (focused)
@@ -1,6 +1,7 @@
 #include "ui/UIFactory.h"
 #include "ui/UIButton.h"
 #include "ui/UITextField.h"
+#include "ui/UITextArea.h"
 #include "ui/UICheckBox.h"
 #include "ui/UIImage.h"
 #include "ui/UILabel.h"
@@ -52,6 +53,10 @@ namespace ui {
             element = UITextField::create();
             element->setTextAlignment(UIElement::TextAlignment::Left);
         }
+        else if (type == "textArea") {
+            element = UITextArea::create();
+            element->setTextAlignment(UIElement::TextAlignment::Left);
+        }
         else if (type == "checkBox") {
             element = UICheckBox::create("Check Me");
             element->setTextAlignment(UIElement::TextAlignment::Right);
@@ -0,0 +1,63 @@
+#include "ui/UIFocusOrder.h"
+#include "ui/UIElement.h"
+#include <iterator>
+
+namespace ui {
+
+    void UIFocusOrder::insert(UIElement* element) {
+        if (!element || contains(element)) return;
+        Slot slot{ nextSequence_++, std::nullopt };
+        if (element->getFocusPriority() > 0) {
+            slot.position = order_.emplace(Key{ element->getFocusPriority(), slot.sequence }, element).first;
+        }
+        slots_.emplace(element, slot);
+    }
+
+    void UIFocusOrder::erase(const UIElement* element) {
+        auto it = slots_.find(element);
+        if (it == slots_.end()) return;
+        if (it->second.position) order_.erase(*it->second.position);
+        slots_.erase(it);
+    }
+
+    void UIFocusOrder::update(UIElement* element) {
+        auto it = slots_.find(element);
+        if (it == slots_.end()) return;
+        Slot& slot = it->second;
+        if (slot.position) {
+            order_.erase(*slot.position);
+            slot.position.reset();
+        }
+        if (element->getFocusPriority() > 0) {
+            slot.position = order_.emplace(Key{ element->getFocusPriority(), slot.sequence }, element).first;
+        }
+    }
+
+    void UIFocusOrder::clear() {
+        order_.clear();
+        slots_.clear();
+    }
+
+    UIElement* UIFocusOrder::first() const {
+        return order_.empty() ? nullptr : order_.begin()->second;
+    }
+
+    UIElement* UIFocusOrder::last() const {
+        return order_.empty() ? nullptr : order_.rbegin()->second;
+    }
+
+    UIElement* UIFocusOrder::next(const UIElement* current) const {
+        auto slot = slots_.find(current);
+        if (slot == slots_.end()) return nullptr;
+        auto it = order_.upper_bound(Key{ current->getFocusPriority(), slot->second.sequence });
+        return it == order_.end() ? nullptr : it->second;
+    }
+
+    UIElement* UIFocusOrder::previous(const UIElement* current) const {
+        auto slot = slots_.find(current);
+        if (slot == slots_.end()) return nullptr;
+        auto it = order_.lower_bound(Key{ current->getFocusPriority(), slot->second.sequence });
+        return it == order_.begin() ? nullptr : std::prev(it)->second;
+    }
+
+} // namespace ui
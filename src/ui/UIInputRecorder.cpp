@@ -0,0 +1,86 @@
+#include "ui/UIInputRecorder.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <limits>
+
+namespace ui {
+
+UIInputRecorder::~UIInputRecorder() {
+    close();
+}
+
+bool UIInputRecorder::open(const std::filesystem::path& path) {
+    close();
+    stream_.open(path, std::ios::binary | std::ios::trunc);
+    if (!stream_.is_open()) {
+        spdlog::error("UIInputRecorder: Failed to open input log '{}'", path.string());
+        return false;
+    }
+    stream_.write(inputlog::kMagic, sizeof(inputlog::kMagic));
+    write(inputlog::kVersion);
+    start_ = std::chrono::steady_clock::now();
+    frame_ = 0;
+    spdlog::info("UIInputRecorder: Recording input to '{}'", path.string());
+    return true;
+}
+
+void UIInputRecorder::close() {
+    if (!stream_.is_open()) return;
+    stream_.flush();
+    stream_.close();
+    spdlog::info("UIInputRecorder: Recorded {} frames", frame_);
+}
+
+void UIInputRecorder::record(const IMouseEvent& event) {
+    if (!isOpen()) return;
+    writeHeader(inputlog::RecordKind::Mouse);
+    const glm::vec2 pos = event.getPosition();
+    const glm::vec2 wheel = event.getWheelDelta();
+    write(static_cast<std::uint8_t>(event.getType()));
+    write(pos.x);
+    write(pos.y);
+    write(static_cast<std::uint8_t>(event.getButton()));
+    write(wheel.x);
+    write(wheel.y);
+    writeString(event.getDroppedData());
+}
+
+void UIInputRecorder::record(const IKeyboardEvent& event) {
+    if (!isOpen()) return;
+    writeHeader(inputlog::RecordKind::Keyboard);
+    write(static_cast<std::uint8_t>(event.getType()));
+    write(static_cast<std::uint16_t>(event.getKeyCode()));
+    write(static_cast<std::uint16_t>(event.getModifiers()));
+}
+
+void UIInputRecorder::record(const ITextInputEvent& event) {
+    if (!isOpen()) return;
+    writeHeader(inputlog::RecordKind::Text);
+    write(static_cast<std::uint8_t>(event.getType()));
+    writeString(event.getText());
+}
+
+void UIInputRecorder::endFrame() {
+    if (!isOpen()) return;
+    writeHeader(inputlog::RecordKind::Frame);
+    write(frame_);
+    ++frame_;
+}
+
+std::uint64_t UIInputRecorder::elapsedMicros() const {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start_).count());
+}
+
+void UIInputRecorder::writeHeader(inputlog::RecordKind kind) {
+    write(static_cast<std::uint8_t>(kind));
+    write(elapsedMicros());
+}
+
+void UIInputRecorder::writeString(const std::string& value) {
+    const auto length = static_cast<std::uint16_t>(std::min<std::size_t>(value.size(), std::numeric_limits<std::uint16_t>::max()));
+    write(length);
+    stream_.write(value.data(), length);
+}
+
+} // namespace ui
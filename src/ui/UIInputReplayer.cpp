@@ -0,0 +1,105 @@
+#include "ui/UIInputReplayer.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <fstream>
+
+namespace ui {
+
+namespace {
+
+    template <typename T>
+    bool read(std::istream& in, T& value) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    bool readString(std::istream& in, std::string& value) {
+        std::uint16_t length = 0;
+        if (!read(in, length)) return false;
+        value.resize(length);
+        return length == 0 || static_cast<bool>(in.read(value.data(), length));
+    }
+
+} // namespace
+
+bool UIInputReplayer::load(const std::filesystem::path& path) {
+    frames_.clear();
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        spdlog::error("UIInputReplayer: Failed to open input log '{}'", path.string());
+        return false;
+    }
+
+    char magic[sizeof(inputlog::kMagic)] = {};
+    std::uint16_t version = 0;
+    if (!in.read(magic, sizeof(magic)) || !std::equal(std::begin(magic), std::end(magic), std::begin(inputlog::kMagic)) ||
+        !read(in, version) || version != inputlog::kVersion) {
+        spdlog::error("UIInputReplayer: '{}' is not a version {} input log", path.string(), inputlog::kVersion);
+        return false;
+    }
+
+    Frame current;
+    std::uint8_t kind = 0;
+    while (read(in, kind)) {
+        std::uint64_t timestamp = 0;
+        std::uint8_t type = 0;
+        if (!read(in, timestamp)) break;
+
+        bool ok = true;
+        switch (static_cast<inputlog::RecordKind>(kind)) {
+        case inputlog::RecordKind::Frame: {
+            ok = read(in, current.index);
+            current.timestampMicros = timestamp;
+            frames_.push_back(std::move(current));
+            current = Frame{};
+            break;
+        }
+        case inputlog::RecordKind::Mouse: {
+            glm::vec2 pos, wheel;
+            std::uint8_t button = 0;
+            std::string dropped;
+            ok = read(in, type) && read(in, pos.x) && read(in, pos.y) && read(in, button) &&
+                read(in, wheel.x) && read(in, wheel.y) && readString(in, dropped);
+            if (ok) {
+                current.events.emplace_back(std::in_place_type<RecordedMouseEvent>, static_cast<EventType>(type), pos,
+                    static_cast<MouseButton>(button), wheel, std::move(dropped));
+            }
+            break;
+        }
+        case inputlog::RecordKind::Keyboard: {
+            std::uint16_t key = 0, modifiers = 0;
+            ok = read(in, type) && read(in, key) && read(in, modifiers);
+            if (ok) {
+                current.events.emplace_back(std::in_place_type<RecordedKeyboardEvent>, static_cast<EventType>(type),
+                    static_cast<KeyCode>(key), static_cast<int>(modifiers));
+            }
+            break;
+        }
+        case inputlog::RecordKind::Text: {
+            std::string text;
+            ok = read(in, type) && readString(in, text);
+            if (ok) {
+                current.events.emplace_back(std::in_place_type<RecordedTextInputEvent>, static_cast<EventType>(type), std::move(text));
+            }
+            break;
+        }
+        default:
+            spdlog::error("UIInputReplayer: Unknown record kind {} in '{}'", kind, path.string());
+            return false;
+        }
+        if (!ok) {
+            spdlog::warn("UIInputReplayer: Truncated record in '{}', replaying {} complete frames", path.string(), frames_.size());
+            break;
+        }
+    }
+
+    // Events recorded after the last frame marker still form a (final) frame.
+    if (!current.events.empty()) {
+        current.index = frames_.empty() ? 0 : frames_.back().index + 1;
+        current.timestampMicros = frames_.empty() ? 0 : frames_.back().timestampMicros;
+        frames_.push_back(std::move(current));
+    }
+    spdlog::info("UIInputReplayer: Loaded {} frames from '{}'", frames_.size(), path.string());
+    return true;
+}
+
+} // namespace ui
@@ -3,6 +3,8 @@
 #include "ui/UIDockable.h"
 #include "ui/UIElement.h"
 #include "ui/UIEventBus.h" // Added for event publishing
+#include "ui/UIInputReplayer.h"
+#include "utils/JobSystem.h"
 #include <algorithm>
 #include <spdlog/spdlog.h>
 #include <chrono>
@@ -10,9 +12,23 @@
 #include <coroutine>
 #include <thread>
 #include <condition_variable>
+#include <variant>
 
 namespace ui {
 
+namespace {
+    UIDockable::DockPosition toDockPosition(DockSide side) {
+        switch (side) {
+            case DockSide::Left:   return UIDockable::DockPosition::Left;
+            case DockSide::Right:  return UIDockable::DockPosition::Right;
+            case DockSide::Top:    return UIDockable::DockPosition::Top;
+            case DockSide::Bottom: return UIDockable::DockPosition::Bottom;
+            case DockSide::Tab:    return UIDockable::DockPosition::Tabbed;
+        }
+        return UIDockable::DockPosition::None;
+    }
+}
+
 UIManager& UIManager::getInstance() {
     static UIManager instance;
     return instance;
@@ -44,38 +60,101 @@ UIManager::~UIManager() {
 }
 
 void UIManager::processInput(void* rawEvent) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
     if (!translator_) {
         spdlog::warn("No input translator set in UIManager");
         return;
     }
 
-    std::unique_ptr<IInputEvent> event = translator_->translate(rawEvent);
-    if (!event) return;
+    // The raw event is exactly one of these kinds; recording happens here so that
+    // replayed events are never recorded a second time.
+    if (auto mouseEvent = translator_->createMouseEvent(rawEvent)) {
+        if (recorder_) recorder_->record(*mouseEvent);
+        lock.unlock();
+        dispatchInput(mouseEvent.get());
+    }
+    else if (auto keyboardEvent = translator_->createKeyboardEvent(rawEvent)) {
+        if (recorder_) recorder_->record(*keyboardEvent);
+        lock.unlock();
+        dispatchInput(keyboardEvent.get());
+    }
+    else if (auto textEvent = translator_->createTextInputEvent(rawEvent)) {
+        if (recorder_) recorder_->record(*textEvent);
+        lock.unlock();
+        dispatchInput(textEvent.get());
+    }
+}
 
+void UIManager::dispatchInput(IMouseEvent* mouseEvent) {
     UIEventBus& eventBus = UIEventBus::getInstance();
-    switch (event->getType()) {
+    switch (mouseEvent->getType()) {
         case EventType::MouseMove:
-            eventBus.publish("MouseMove", nullptr, event->getType());
+            eventBus.publish("MouseMove", nullptr, mouseEvent->getType());
             break;
         case EventType::MousePress:
-            eventBus.publish("MousePress", nullptr, event->getType());
+            eventBus.publish("MousePress", nullptr, mouseEvent->getType());
             break;
         case EventType::MouseRelease:
-            eventBus.publish("MouseRelease", nullptr, event->getType());
+            eventBus.publish("MouseRelease", nullptr, mouseEvent->getType());
             break;
-        case EventType::KeyPress:
-            eventBus.publish("KeyPress", focusedElement_, event->getType());
+        default:
             break;
-        case EventType::KeyRelease:
-            eventBus.publish("KeyRelease", focusedElement_, event->getType());
-            break;
-        case EventType::TextInput:
-            eventBus.publish("TextInput", focusedElement_, event->getType());
+    }
+
+    // Moves go to every canvas so hover state can clear; everything else stops at
+    // the topmost canvas that handles it.
+    for (UICanvas* canvas : getCanvasesTopDown()) {
+        if (!canvas->isVisible()) continue;
+        if (mouseEvent->getType() == EventType::MouseMove) {
+            canvas->handleInput(mouseEvent);
+        }
+        else if (canvas->hitTest(mouseEvent->getPosition()) && canvas->handleInput(mouseEvent)) {
             break;
+        }
     }
 }
 
+void UIManager::dispatchInput(IKeyboardEvent* keyboardEvent) {
+    UIElement* focused = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        focused = focusedElement_;
+    }
+    UIEventBus::getInstance().publish(keyboardEvent->getType() == EventType::KeyPress ? "KeyPress" : "KeyRelease",
+                                      focused, keyboardEvent->getType());
+    if (focused && focused->handleInput(keyboardEvent)) return;
+    for (UICanvas* canvas : getCanvasesTopDown()) {
+        if (canvas->isVisible() && canvas->handleInput(keyboardEvent)) return;
+    }
+}
+
+void UIManager::dispatchInput(ITextInputEvent* textEvent) {
+    UIElement* focused = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        focused = focusedElement_;
+    }
+    UIEventBus::getInstance().publish("TextInput", focused, textEvent->getType());
+    if (focused && focused->handleInput(textEvent)) return;
+    for (UICanvas* canvas : getCanvasesTopDown()) {
+        if (canvas->isVisible() && canvas->handleInput(textEvent)) return;
+    }
+}
+
+std::vector<UICanvas*> UIManager::getCanvasesTopDown() const {
+    std::vector<UICanvas*> ordered;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ordered.reserve(canvases_.size());
+        for (const auto& canvas : canvases_) {
+            if (canvas) ordered.push_back(canvas.get());
+        }
+    }
+    std::stable_sort(ordered.begin(), ordered.end(),
+                     [](const UICanvas* a, const UICanvas* b) { return a->getZIndex() > b->getZIndex(); });
+    return ordered;
+}
+
 void UIManager::setGlobalTheme(std::unique_ptr<UITheme> theme) {
     std::lock_guard<std::mutex> lock(mutex_);
     globalTheme_ = std::move(theme);
@@ -92,7 +171,15 @@ void UIManager::applyTheme() {
 }
 
 void UIManager::setFocusedElement(UIElement* element) {
+    if (updatingCanvases_) {
+        deferUntilMerge([this, element]() { setFocusedElement(element); });
+        return;
+    }
     std::lock_guard<std::mutex> lock(mutex_);
+    setFocusedElementLocked(element);
+}
+
+void UIManager::setFocusedElementLocked(UIElement* element) {
     if (focusedElement_ != element) {
         if (focusedElement_) focusedElement_->setFocus(false);
         focusedElement_ = element;
@@ -104,24 +191,24 @@ void UIManager::focusNext() {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!focusedElement_) {
         if (!canvases_.empty() && canvases_[0]) {
-            setFocusedElement(findNextFocusable(canvases_[0].get(), false));
+            setFocusedElementLocked(findNextFocusable(canvases_[0].get(), false));
         }
         return;
     }
     UIElement* next = findNextFocusable(focusedElement_);
-    if (next) setFocusedElement(next);
+    if (next) setFocusedElementLocked(next);
 }
 
 void UIManager::focusPrevious() {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!focusedElement_) {
         if (!canvases_.empty() && canvases_[0]) {
-            setFocusedElement(findPreviousFocusable(canvases_[0].get(), false));
+            setFocusedElementLocked(findPreviousFocusable(canvases_[0].get(), false));
         }
         return;
     }
     UIElement* prev = findPreviousFocusable(focusedElement_);
-    if (prev) setFocusedElement(prev);
+    if (prev) setFocusedElementLocked(prev);
 }
 
 void UIManager::moveFocusToNextCanvas() {
@@ -134,15 +221,21 @@ void UIManager::moveFocusToNextCanvas() {
         auto nextIt = it + 1;
         if (nextIt == canvases_.end()) nextIt = canvases_.begin();
         if (*nextIt) {
-            setFocusedElement(findNextFocusable((*nextIt).get(), false));
+            setFocusedElementLocked(findNextFocusable((*nextIt).get(), false));
         }
     }
 }
 
 void UIManager::addCanvas(std::unique_ptr<UICanvas> canvas) {
+    if (updatingCanvases_) {
+        auto shared = std::make_shared<std::unique_ptr<UICanvas>>(std::move(canvas));
+        deferUntilMerge([this, shared]() { addCanvas(std::move(*shared)); });
+        return;
+    }
     std::lock_guard<std::mutex> lock(mutex_);
     if (canvas) {
         canvases_.push_back(std::move(canvas));
+        canvasIndex_.emplace(canvases_.back().get(), canvases_.size() - 1);
         if (auto* dockable = dynamic_cast<UIDockable*>(canvases_.back().get())) {
             dockables_.push_back(dockable);
         }
@@ -151,14 +244,23 @@ void UIManager::addCanvas(std::unique_ptr<UICanvas> canvas) {
 }
 
 void UIManager::removeCanvas(const UICanvas* canvas) {
+    if (updatingCanvases_) {
+        deferUntilMerge([this, canvas]() { removeCanvas(canvas); });
+        return;
+    }
     std::lock_guard<std::mutex> lock(mutex_);
-    auto it = std::remove_if(canvases_.begin(), canvases_.end(),
-                             [canvas](const auto& ptr) { return ptr.get() == canvas; });
-    canvases_.erase(it, canvases_.end());
-
-    auto dockIt = std::remove_if(dockables_.begin(), dockables_.end(),
-                                 [canvas](UIDockable* dockable) { return dynamic_cast<UICanvas*>(dockable) == canvas; });
-    dockables_.erase(dockIt, dockables_.end());
+    auto it = std::find_if(canvases_.begin(), canvases_.end(),
+                           [canvas](const auto& ptr) { return ptr.get() == canvas; });
+    if (it == canvases_.end()) return;
+
+    // Keep the canvas alive until it is out of the dock tree; undocking touches the panel.
+    std::unique_ptr<UICanvas> removed = std::move(*it);
+    if (auto* dockable = dynamic_cast<UIDockable*>(removed.get())) {
+        dockTree_.undock(dockable);
+        dockables_.erase(std::remove(dockables_.begin(), dockables_.end(), dockable), dockables_.end());
+    }
+    canvases_.erase(it);
+    rebuildCanvasIndex();
 }
 
 void UIManager::scheduleCoroutine(float seconds, std::coroutine_handle<> handle) {
@@ -174,16 +276,10 @@ void UIManager::scheduleCoroutine(float seconds, std::coroutine_handle<> handle)
 }
 
 void UIManager::update() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    for (auto& canvas : canvases_) {
-        if (canvas) canvas->update();
-    }
-
-    std::vector<UICanvas*> dirtyCanvases;
-    for (auto& canvas : canvases_) {
-        if (canvas && canvas->isDirty()) {
-            dirtyCanvases.push_back(canvas.get());
-        }
+    std::vector<UICanvas*> dirtyCanvases = updateCanvases();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (recorder_) recorder_->endFrame();
     }
     if (!dirtyCanvases.empty()) {
         std::lock_guard<std::mutex> renderLock(renderMutex_);
@@ -192,10 +288,82 @@ void UIManager::update() {
     }
 }
 
+std::vector<UICanvas*> UIManager::updateCanvases() {
+    std::vector<UICanvas*> dirtyCanvases;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Canvases are independent subtrees, so each one updates on its own job.
+        std::vector<char> dirty(canvases_.size(), 0);
+        updatingCanvases_ = true;
+        utils::JobSystem::getInstance().parallelFor(canvases_.size(), [this, &dirty](size_t i) {
+            UICanvas* canvas = canvases_[i].get();
+            if (!canvas) return;
+            canvas->update();
+            dirty[i] = canvas->isDirty() ? 1 : 0;
+        });
+        updatingCanvases_ = false;
+
+        dirtyCanvases.reserve(canvases_.size());
+        for (size_t i = 0; i < canvases_.size(); ++i) {
+            if (dirty[i]) dirtyCanvases.push_back(canvases_[i].get());
+        }
+    }
+    // Serial merge: focus, docking and canvas list changes requested during the update.
+    runDeferredActions();
+    return dirtyCanvases;
+}
+
+void UIManager::deferUntilMerge(std::function<void()> action) {
+    if (!action) return;
+    if (!updatingCanvases_) {
+        action();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(deferredMutex_);
+    deferredActions_.push_back(std::move(action));
+}
+
+void UIManager::runDeferredActions() {
+    std::vector<std::function<void()>> actions;
+    {
+        std::lock_guard<std::mutex> lock(deferredMutex_);
+        actions.swap(deferredActions_);
+    }
+    for (auto& action : actions) {
+        action();
+    }
+}
+
+void UIManager::renderCanvases(IRenderer* renderer, std::vector<UICanvas*>& canvases) {
+    std::sort(canvases.begin(), canvases.end(),
+              [](const UICanvas* a, const UICanvas* b) { return a->getZIndex() < b->getZIndex(); });
+    for (auto* canvas : canvases) {
+        if (canvas && canvas->isVisible()) {
+            canvas->doRender(renderer);
+        }
+    }
+}
+
 void UIManager::render(IRenderer* renderer) {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!renderer) return;
     renderer_ = renderer;
+    syncDockBounds();
+}
+
+bool UIManager::dockDockable(UIDockable* dockable, DockSide side) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!dockable) return false;
+    syncDockBounds();
+    dockTree_.undock(dockable);
+    if (!dockTree_.dock(dockable, dockTree_.getRoot(), side)) return false;
+    dockable->setDockPosition(toDockPosition(side));
+    return true;
+}
+
+std::optional<DockSnapTarget> UIManager::getDockPreview() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dockPreview_;
 }
 
 void UIManager::renderLoop() {
@@ -209,13 +377,7 @@ void UIManager::renderLoop() {
         }
 
         if (renderer_) {
-            std::sort(canvasesToRender.begin(), canvasesToRender.end(),
-                      [](const UICanvas* a, const UICanvas* b) { return a->getZIndex() < b->getZIndex(); });
-            for (auto* canvas : canvasesToRender) {
-                if (canvas && canvas->isVisible()) {
-                    canvas->doRender(renderer_);
-                }
-            }
+            renderCanvases(renderer_, canvasesToRender);
         }
     }
 }
@@ -257,163 +419,192 @@ void UIManager::setInputTranslator(std::unique_ptr<IInputTranslator> translator)
 }
 
 void UIManager::handleDockableDragging(UIDockable* dockable, const glm::vec2& position) {
+    if (updatingCanvases_) {
+        deferUntilMerge([this, dockable, position]() { handleDockableDragging(dockable, position); });
+        return;
+    }
     std::lock_guard<std::mutex> lock(mutex_);
     if (!dockable || !dockable->isDragging()) return;
 
+    // Pulling a docked panel out collapses its slot; the siblings re-solve around it.
+    if (dockTree_.undock(dockable)) {
+        dockable->setDockPosition(UIDockable::DockPosition::None);
+    }
     updateDockableSnapping(dockable, position);
 }
 
 void UIManager::handleDockableRelease(UIDockable* dockable) {
+    if (updatingCanvases_) {
+        deferUntilMerge([this, dockable]() { handleDockableRelease(dockable); });
+        return;
+    }
     std::lock_guard<std::mutex> lock(mutex_);
     if (!dockable) return;
 
-    DockPosition newPosition = checkDockableSnapping(dockable, dockable->getPosition());
-    if (newPosition != DockPosition::None) {
-        dockable->setDockPosition(newPosition);
+    const glm::vec2 pointer = dockable->getPosition() + dockable->getDragStart();
+    if (auto target = checkDockableSnapping(dockable, pointer)) {
+        if (dockTree_.dock(dockable, target->node, target->side)) {
+            dockable->setDockPosition(toDockPosition(target->side));
+        }
     }
+    dockPreview_.reset();
     dockable->setDragging(false);
 }
 
-UIElement* UIManager::findNextFocusable(UIElement* current, bool withinScope) {
+bool UIManager::startRecording(const std::filesystem::path& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto recorder = std::make_unique<UIInputRecorder>();
+    if (!recorder->open(path)) return false;
+    recorder_ = std::move(recorder);
+    return true;
+}
+
+void UIManager::stopRecording() {
     std::lock_guard<std::mutex> lock(mutex_);
+    recorder_.reset();
+}
+
+bool UIManager::isRecording() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return recorder_ != nullptr;
+}
+
+std::vector<ReplayFrameTiming> UIManager::replayInput(const std::filesystem::path& path, IRenderer* renderer, ReplayMode mode) {
+    UIInputReplayer replayer;
+    if (!replayer.load(path)) return {};
+
+    using Clock = std::chrono::steady_clock;
+    auto elapsedMs = [](Clock::time_point from, Clock::time_point to) {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    };
+
+    std::vector<ReplayFrameTiming> timings;
+    timings.reserve(replayer.getFrames().size());
+    const auto start = Clock::now();
+    for (auto& frame : replayer.getFrames()) {
+        if (mode == ReplayMode::RealTime) {
+            std::this_thread::sleep_until(start + std::chrono::microseconds(frame.timestampMicros));
+        }
+
+        ReplayFrameTiming timing;
+        timing.frame = frame.index;
+        timing.eventCount = frame.events.size();
+
+        const auto inputStart = Clock::now();
+        for (auto& event : frame.events) {
+            std::visit([this](auto& recorded) { dispatchInput(&recorded); }, event);
+        }
+        const auto updateStart = Clock::now();
+        std::vector<UICanvas*> dirtyCanvases = updateCanvases();
+        const auto renderStart = Clock::now();
+        // Render synchronously so the cost is attributed to this frame.
+        if (renderer) renderCanvases(renderer, dirtyCanvases);
+        const auto frameEnd = Clock::now();
+
+        timing.inputMs = elapsedMs(inputStart, updateStart);
+        timing.updateMs = elapsedMs(updateStart, renderStart);
+        timing.renderMs = elapsedMs(renderStart, frameEnd);
+        timings.push_back(timing);
+    }
+
+    if (!timings.empty()) {
+        double total = 0.0, worst = 0.0;
+        for (const auto& timing : timings) {
+            total += timing.totalMs();
+            worst = std::max(worst, timing.totalMs());
+        }
+        spdlog::info("Replayed {} frames from '{}': avg {:.3f} ms, max {:.3f} ms",
+                     timings.size(), path.string(), total / timings.size(), worst);
+    }
+    return timings;
+}
+
+UIElement* UIManager::findNextFocusable(UIElement* current, bool withinScope) {
+    // Caller holds mutex_.
     if (!current) return nullptr;
 
+    // Starting from a canvas itself means "enter it".
+    if (auto it = canvasIndex_.find(current); it != canvasIndex_.end()) {
+        return canvases_[it->second]->getFocusOrder().first();
+    }
+
     UICanvas* canvas = getCanvasForElement(current);
     if (!canvas) return nullptr;
 
-    const auto& children = canvas->getChildren();
-    auto it = std::find_if(children.begin(), children.end(),
-                           [current](const auto& child) { return child.get() == current; });
-    if (it == children.end()) return nullptr;
-
-    auto nextIt = it + 1;
-    while (nextIt != children.end()) {
-        if ((*nextIt)->getFocusPriority() > 0) return nextIt->get();
-        ++nextIt;
-    }
-
-    if (!withinScope && canvas != canvases_.front().get()) {
-        auto canvasIt = std::find_if(canvases_.begin(), canvases_.end(),
-                                     [canvas](const auto& c) { return c.get() == canvas; });
-        if (canvasIt != canvases_.begin()) {
-            --canvasIt;
-            if (*canvasIt) {
-                const auto& prevChildren = (*canvasIt)->getChildren();
-                for (auto rit = prevChildren.rbegin(); rit != prevChildren.rend(); ++rit) {
-                    if ((*rit)->getFocusPriority() > 0) return rit->get();
-                }
-            }
+    const UIFocusOrder& order = canvas->getFocusOrder();
+    if (UIElement* next = order.next(current)) return next;
+    if (canvas->isFocusScope()) return order.first();
+    if (withinScope) return nullptr;
+
+    for (size_t i = canvasIndex_.at(canvas) + 1; i < canvases_.size(); ++i) {
+        if (canvases_[i]) {
+            if (UIElement* first = canvases_[i]->getFocusOrder().first()) return first;
         }
     }
-
     return nullptr;
 }
 
 UIElement* UIManager::findPreviousFocusable(UIElement* current, bool withinScope) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    // Caller holds mutex_.
     if (!current) return nullptr;
 
+    if (auto it = canvasIndex_.find(current); it != canvasIndex_.end()) {
+        return canvases_[it->second]->getFocusOrder().last();
+    }
+
     UICanvas* canvas = getCanvasForElement(current);
     if (!canvas) return nullptr;
 
-    const auto& children = canvas->getChildren();
-    auto it = std::find_if(children.begin(), children.end(),
-                           [current](const auto& child) { return child.get() == current; });
-    if (it == children.end()) return nullptr;
-
-    auto prevIt = it - 1;
-    while (prevIt >= children.begin()) {
-        if ((*prevIt)->getFocusPriority() > 0) return prevIt->get();
-        --prevIt;
-    }
-
-    if (!withinScope && canvas != canvases_.back().get()) {
-        auto canvasIt = std::find_if(canvases_.begin(), canvases_.end(),
-                                     [canvas](const auto& c) { return c.get() == canvas; });
-        if (canvasIt != canvases_.end() - 1) {
-            ++canvasIt;
-            if (*canvasIt) {
-                const auto& nextChildren = (*canvasIt)->getChildren();
-                for (auto rit = nextChildren.rbegin(); rit != nextChildren.rend(); ++rit) {
-                    if ((*rit)->getFocusPriority() > 0) return rit->get();
-                }
-            }
+    const UIFocusOrder& order = canvas->getFocusOrder();
+    if (UIElement* previous = order.previous(current)) return previous;
+    if (canvas->isFocusScope()) return order.last();
+    if (withinScope) return nullptr;
+
+    for (size_t i = canvasIndex_.at(canvas); i-- > 0;) {
+        if (canvases_[i]) {
+            if (UIElement* last = canvases_[i]->getFocusOrder().last()) return last;
         }
     }
-
     return nullptr;
 }
 
 UICanvas* UIManager::getCanvasForElement(const UIElement* element) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    // Caller holds mutex_. Walks the ancestor chain once; membership is a hash lookup.
     if (!element) return nullptr;
 
-    for (const auto& canvas : canvases_) {
-        if (canvas) {
-            const auto* parent = element->getParent();
-            while (parent) {
-                if (parent == canvas.get()) return canvas.get();
-                parent = parent->getParent();
-            }
+    std::optional<UIElement*> parent = element->getParent();
+    while (parent && *parent) {
+        if (auto it = canvasIndex_.find(*parent); it != canvasIndex_.end()) {
+            return canvases_[it->second].get();
         }
+        parent = (*parent)->getParent();
     }
     return nullptr;
 }
 
-void UIManager::updateDockableSnapping(UIDockable* dockable, const glm::vec2& position) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!dockable) return;
-
-    glm::vec2 originalPos = dockable->getPosition();
-    dockable->setPosition(position);
-
-    IRenderer* renderer = renderer_;
-    glm::vec2 screenSize = (renderer) ? renderer->getScreenSize() : glm::vec2(1280.0f, 720.0f);
-
-    DockPosition newPosition = checkDockableSnapping(dockable, position, screenSize);
-    if (newPosition != DockPosition::None) {
-        dockable->setDockPosition(newPosition);
-    } else {
-        dockable->setDockPosition(DockPosition::None);
-    }
-
-    if (dockable->getDockPosition() == DockPosition::None) {
-        dockable->setPosition(originalPos);
+void UIManager::rebuildCanvasIndex() {
+    canvasIndex_.clear();
+    canvasIndex_.reserve(canvases_.size());
+    for (size_t i = 0; i < canvases_.size(); ++i) {
+        if (canvases_[i]) canvasIndex_.emplace(canvases_[i].get(), i);
     }
 }
 
-DockPosition UIManager::checkDockableSnapping(UIDockable* dockable, const glm::vec2& position, const glm::vec2& screenSize) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!dockable) return DockPosition::None;
-
-    const float snapThreshold = 20.0f;
-
-    if (position.y < snapThreshold) return DockPosition::Top;
-    if (position.y + dockable->getSize().y > screenSize.y - snapThreshold) return DockPosition::Bottom;
-    if (position.x < snapThreshold) return DockPosition::Left;
-    if (position.x + dockable->getSize().x > screenSize.x - snapThreshold) return DockPosition::Right;
-
-    for (UIDockable* other : dockables_) {
-        if (other == dockable || other->getDockPosition() == DockPosition::None) continue;
-
-        glm::vec2 otherPos = other->getPosition();
-        glm::vec2 otherSize = other->getSize();
+void UIManager::updateDockableSnapping(UIDockable* dockable, const glm::vec2& position) {
+    // Caller holds mutex_.
+    dockPreview_ = checkDockableSnapping(dockable, position);
+}
 
-        if (std::abs(position.y + dockable->getSize().y - otherPos.y) < snapThreshold) {
-            return DockPosition::Top;
-        }
-        if (std::abs(position.y - (otherPos.y + otherSize.y)) < snapThreshold) {
-            return DockPosition::Bottom;
-        }
-        if (std::abs(position.x + dockable->getSize().x - otherPos.x) < snapThreshold) {
-            return DockPosition::Left;
-        }
-        if (std::abs(position.x - (otherPos.x + otherSize.x)) < snapThreshold) {
-            return DockPosition::Right;
-        }
-    }
+std::optional<DockSnapTarget> UIManager::checkDockableSnapping(UIDockable* dockable, const glm::vec2& position) {
+    // Caller holds mutex_.
+    if (!dockable) return std::nullopt;
+    syncDockBounds();
+    return dockTree_.querySnap(position, dockable, kDockSnapThreshold);
+}
 
-    return DockPosition::None;
+void UIManager::syncDockBounds() {
+    const glm::vec2 screenSize = renderer_ ? renderer_->getScreenSize() : glm::vec2(1280.0f, 720.0f);
+    dockTree_.setBounds(glm::vec2(0.0f), screenSize);
 }
 
 } // namespace ui
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "ui/UIPropertyBinding.h"
+#include <spdlog/spdlog.h>
+
+namespace ui {
+
+UIPropertyBinding::FieldId UIPropertyBinding::registerField(const std::string& path, PropertyValue initial) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    fields_.push_back({ path, std::move(initial) });
+    for (auto& subscription : subscriptions_) {
+        subscription.dirty.push_back(0);
+        subscription.pending.reserve(fields_.size());
+        subscription.flushing.reserve(fields_.size());
+    }
+    return static_cast<FieldId>(fields_.size() - 1);
+}
+
+std::size_t UIPropertyBinding::getFieldCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return fields_.size();
+}
+
+void UIPropertyBinding::publish(FieldId field, float value) {
+    publishValue(field, value);
+}
+
+void UIPropertyBinding::publish(FieldId field, const std::string& value) {
+    publishValue(field, value);
+}
+
+template <typename T>
+void UIPropertyBinding::publishValue(FieldId field, const T& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (field >= fields_.size()) {
+        spdlog::warn("UIPropertyBinding: Publish to unknown field {}", field);
+        return;
+    }
+    // Assigning into the existing alternative reuses string capacity.
+    auto& slot = fields_[field].value;
+    if (auto* current = std::get_if<T>(&slot)) {
+        *current = value;
+    }
+    else {
+        slot = value;
+    }
+    for (auto& subscription : subscriptions_) {
+        if (subscription.active && !subscription.dirty[field]) {
+            subscription.dirty[field] = 1;
+            subscription.pending.push_back(field);
+        }
+    }
+}
+
+UIPropertyBinding::SubscriptionId UIPropertyBinding::subscribe() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Subscription subscription;
+    subscription.active = true;
+    subscription.dirty.assign(fields_.size(), 0);
+    subscription.pending.reserve(fields_.size());
+    subscription.flushing.reserve(fields_.size());
+    for (std::size_t i = 0; i < subscriptions_.size(); ++i) {
+        if (!subscriptions_[i].active) {
+            subscriptions_[i] = std::move(subscription);
+            return static_cast<SubscriptionId>(i);
+        }
+    }
+    subscriptions_.push_back(std::move(subscription));
+    return static_cast<SubscriptionId>(subscriptions_.size() - 1);
+}
+
+void UIPropertyBinding::unsubscribe(SubscriptionId subscription) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (subscription < subscriptions_.size()) {
+        subscriptions_[subscription] = Subscription{};
+    }
+}
+
+std::size_t UIPropertyBinding::flush(SubscriptionId subscription, const Listener& listener) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (subscription >= subscriptions_.size() || !subscriptions_[subscription].active) return 0;
+
+    auto& sub = subscriptions_[subscription];
+    sub.flushing.clear();
+    sub.flushing.swap(sub.pending);
+    for (FieldId field : sub.flushing) {
+        sub.dirty[field] = 0;
+    }
+    // Listeners run under the lock so a value cannot change while it is being read;
+    // they must not publish back into this binding.
+    for (FieldId field : sub.flushing) {
+        listener(field, fields_[field].value);
+    }
+    return sub.flushing.size();
+}
+
+} // namespace ui
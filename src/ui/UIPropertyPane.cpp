@@ -3,16 +3,16 @@
 #include "ui/UILabel.h"
 #include "ui/UITextField.h"
 #include "ui/UIButton.h"
-#include "ui/UIManager.h"
 #include <spdlog/spdlog.h>
+#include <spdlog/fmt/fmt.h>
 #include <algorithm>
+#include <iterator>
+#include <type_traits>
 
 namespace ui {
 
     std::unique_ptr<UIPropertyPane> UIPropertyPane::create(const std::string& title, const std::string& styleType, int zIndex) {
-        auto pane = std::unique_ptr<UIPropertyPane>(new UIPropertyPane(title, styleType, zIndex));
-        UIManager::getInstance().addCanvas(std::move(pane));
-        return pane;
+        return std::unique_ptr<UIPropertyPane>(new UIPropertyPane(title, styleType, zIndex));
     }
 
     UIPropertyPane::UIPropertyPane(const std::string& title, const std::string& styleType, int zIndex)
@@ -22,54 +22,224 @@ namespace ui {
     }
 
     UIPropertyPane::~UIPropertyPane() {
+        for (auto& bound : boundObjects_) {
+            if (bound.binding) bound.binding->unsubscribe(bound.subscription);
+        }
     }
 
     void UIPropertyPane::addObject(std::shared_ptr<IExposable> obj) {
         if (obj) {
             objects_.push_back(obj);
             objectNames_.push_back(obj->getObjectName());
-            rebuildPropertyElements();
+            bindObject(obj);
+            scheduleReconcile();
         }
     }
 
     void UIPropertyPane::combineWith(const UIPropertyPane& other) {
         objects_.insert(objects_.end(), other.objects_.begin(), other.objects_.end());
+        for (const auto& obj : other.objects_) {
+            bindObject(obj);
+        }
         objectNames_.insert(objectNames_.end(), other.objectNames_.begin(), other.objectNames_.end());
-        rebuildPropertyElements();
+        scheduleReconcile();
     }
 
     void UIPropertyPane::refresh() {
-        rebuildPropertyElements();
+        scheduleReconcile();
     }
 
     void UIPropertyPane::setUseBeautification(bool useBeautification) {
         auto style = getEffectiveTheme()->getStyle(styleType_);
         style.useBeautification = useBeautification;
-        rebuildPropertyElements();
+        refresh();
     }
 
     void UIPropertyPane::setSeparatorColor(const glm::vec4& color) {
         auto style = getEffectiveTheme()->getStyle(styleType_);
         style.separatorColor = color;
-        rebuildPropertyElements();
+        refresh();
     }
 
-    void UIPropertyPane::rebuildPropertyElements() {
-        auto& children = getMutableChildren();
-        children.clear();
-        glm::vec2 currentPos = position_ + glm::vec2(0.0f, titleBarHeight_);
+    void UIPropertyPane::scheduleReconcile() {
+        // Many changes in one frame (e.g. a multi-selection) collapse into one pass.
+        reconcilePending_ = true;
+        markDirty();
+    }
+
+    void UIPropertyPane::update() {
+        UIDockable::update();
+        if (reconcilePending_) {
+            reconcilePending_ = false;
+            reconcilePropertyElements();
+        }
+        applyLiveUpdates();
+    }
+
+    void UIPropertyPane::bindObject(const std::shared_ptr<IExposable>& obj) {
+        BoundObject bound;
+        bound.binding = obj ? obj->getPropertyBinding() : nullptr;
+        if (bound.binding) {
+            bound.subscription = bound.binding->subscribe();
+        }
+        boundObjects_.push_back(std::move(bound));
+    }
+
+    void UIPropertyPane::applyLiveUpdates() {
+        if (liveUpdateInterval_ > 0.0f) {
+            auto now = std::chrono::steady_clock::now();
+            if (now - lastLiveUpdate_ < std::chrono::duration<float>(liveUpdateInterval_)) return;
+            lastLiveUpdate_ = now;
+        }
+
+        for (auto& bound : boundObjects_) {
+            if (!bound.binding) continue;
+            bound.binding->flush(bound.subscription, [this, &bound](UIPropertyBinding::FieldId field, const PropertyValue& value) {
+                UILabel* row = resolveFieldRow(bound, field);
+                if (!row) return;
+                valueScratch_.assign(bound.fieldPrefixes[field]);
+                if (const float* number = std::get_if<float>(&value)) {
+                    fmt::format_to(std::back_inserter(valueScratch_), "{:g}", *number);
+                }
+                else {
+                    valueScratch_.append(std::get<std::string>(value));
+                }
+                if (row->getText() != valueScratch_) {
+                    row->setText(valueScratch_);
+                }
+            });
+        }
+    }
+
+    UILabel* UIPropertyPane::resolveFieldRow(BoundObject& bound, UIPropertyBinding::FieldId field) {
+        if (field >= bound.fieldRows.size()) {
+            bound.fieldRows.resize(field + 1, nullptr);
+            bound.fieldPrefixes.resize(field + 1);
+        }
+        if (!bound.fieldRows[field]) {
+            // Called from inside flush(), so only the lock-free path accessor is used here.
+            const std::string& path = bound.binding->getFieldPath(field);
+            auto it = rowsByKey_.find(bound.objectKey + "/" + path);
+            if (it == rowsByKey_.end()) return nullptr;
+            const auto labelStart = path.find_last_of('.');
+            bound.fieldRows[field] = it->second;
+            bound.fieldPrefixes[field] = (labelStart == std::string::npos ? path : path.substr(labelStart + 1)) + ": ";
+        }
+        return bound.fieldRows[field];
+    }
+
+    void UIPropertyPane::collectRows(std::vector<PropertyRow>& rows, std::vector<std::string>& objectKeys) const {
+        // Objects are keyed by identity; repeats of the same object get an occurrence suffix.
+        std::unordered_map<const IExposable*, int> occurrences;
         for (size_t i = 0; i < objects_.size(); ++i) {
-            auto obj = objects_[i];
-            auto name = objectNames_[i];
-            auto header = UIFactory::createElement("label", this);
-            if (header) {
-                dynamic_cast<UILabel*>(header.get())->setText(name);
-                header->setPosition(currentPos);
-                header->setTextAlignment(TextAlignment::Left);
-                children.push_back(std::move(header));
-                currentPos.y += 20.0f + padding_.y;
+            const IExposable* obj = objects_[i].get();
+            const std::string objectKey = fmt::format("{}#{}", static_cast<const void*>(obj), occurrences[obj]++);
+            objectKeys.push_back(objectKey);
+            rows.push_back({ objectKey, objectNames_[i], 0 });
+            std::unordered_map<std::string, int> keyCounts;
+            for (const auto& description : obj->getProperties()) {
+                appendDescriptionRows(rows, keyCounts, objectKey, description, 1);
+            }
+        }
+    }
+
+    void UIPropertyPane::appendDescriptionRows(std::vector<PropertyRow>& rows, std::unordered_map<std::string, int>& keyCounts,
+                                               const std::string& parentKey, const UIPropertyDescription& description,
+                                               int depth) const {
+        // Repeated names get an occurrence suffix after the first, which keeps the plain key
+        // bindings resolve against.
+        const auto uniqueKey = [&keyCounts](std::string key) {
+            if (const int seen = keyCounts[key]++; seen > 0) key += fmt::format("#{}", seen);
+            return key;
+        };
+        const std::string key = uniqueKey(parentKey + "/" + description.getName());
+        rows.push_back({ key, description.getName(), depth });
+        for (const auto& field : description.getFields()) {
+            std::string value = std::visit([](const auto& v) -> std::string {
+                if constexpr (std::is_same_v<std::decay_t<decltype(v)>, float>) return fmt::format("{:g}", v);
+                else return v;
+            }, field.value);
+            rows.push_back({ uniqueKey(key + "." + field.label), field.label + ": " + value, depth + 1 });
+        }
+        for (const auto& sub : description.getSubProperties()) {
+            appendDescriptionRows(rows, keyCounts, key, sub, depth + 1);
+        }
+    }
+
+    void UIPropertyPane::reconcilePropertyElements() {
+        std::vector<PropertyRow> rows;
+        std::vector<std::string> objectKeys;
+        collectRows(rows, objectKeys);
+
+        // Reuse the rows this pane created, found through rowsByKey_; other children are left alone.
+        std::unordered_map<const UIElement*, const std::string*> ownedKeys;
+        ownedKeys.reserve(rowsByKey_.size());
+        for (const auto& [key, label] : rowsByKey_) {
+            ownedKeys.emplace(label, &key);
+        }
+        auto& children = getMutableChildren();
+        std::unordered_map<std::string, std::unique_ptr<UIElement>> existing;
+        std::vector<std::unique_ptr<UIElement>> foreign;
+        existing.reserve(rowsByKey_.size());
+        for (auto& child : children) {
+            if (!child) continue;
+            if (auto owned = ownedKeys.find(child.get()); owned != ownedKeys.end()) {
+                existing.emplace(*owned->second, std::move(child));
+            }
+            else {
+                foreign.push_back(std::move(child));
             }
         }
+
+        std::vector<std::unique_ptr<UIElement>> next;
+        std::unordered_map<std::string, UILabel*> rowsByKey;
+        next.reserve(rows.size() + foreign.size());
+        rowsByKey.reserve(rows.size());
+        size_t created = 0;
+        glm::vec2 currentPos = position_ + glm::vec2(padding_.x, titleBarHeight_);
+        for (const auto& row : rows) {
+            std::unique_ptr<UIElement> element;
+            UILabel* label = nullptr;
+            if (auto it = existing.find(row.key); it != existing.end()) {
+                label = rowsByKey_.at(row.key);
+                element = std::move(it->second);
+                existing.erase(it);
+            }
+            else {
+                auto newLabel = UILabel::create();
+                newLabel->setId(row.key);
+                newLabel->setTextAlignment(TextAlignment::Left);
+                newLabel->setParent(this);
+                label = newLabel.get();
+                element = std::move(newLabel);
+                ++created;
+            }
+
+            // Only touch what changed so untouched rows stay clean.
+            if (label->getText() != row.text) {
+                label->setText(row.text);
+            }
+            const glm::vec2 rowPos = currentPos + glm::vec2(kIndent * static_cast<float>(row.depth), 0.0f);
+            if (label->getPosition() != rowPos) {
+                label->setPosition(rowPos);
+            }
+            rowsByKey.emplace(row.key, label);
+            next.push_back(std::move(element));
+            currentPos.y += kRowHeight + padding_.y;
+        }
+
+        spdlog::debug("UIPropertyPane: reconciled {} rows ({} reused, {} created, {} destroyed)",
+                      rows.size(), rows.size() - created, created, existing.size());
+        std::move(foreign.begin(), foreign.end(), std::back_inserter(next));
+        children = std::move(next);
+
+        // Row pointers may have changed; live bindings re-resolve against the new index.
+        rowsByKey_ = std::move(rowsByKey);
+        for (size_t i = 0; i < boundObjects_.size() && i < objectKeys.size(); ++i) {
+            boundObjects_[i].objectKey = objectKeys[i];
+            std::fill(boundObjects_[i].fieldRows.begin(), boundObjects_[i].fieldRows.end(), nullptr);
+        }
+        markDirty();
     }
 
     void UIPropertyPane::onStyleUpdate() {
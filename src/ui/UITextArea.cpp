@@ -0,0 +1,17 @@
+#include "ui/UITextArea.h"
+
+namespace ui {
+
+std::unique_ptr<UITextArea> UITextArea::create() {
+    return std::unique_ptr<UITextArea>(new UITextArea());
+}
+
+UITextArea::UITextArea()
+    : UITextEdit(true) {
+    styleType_ = "textArea";
+    size_ = glm::vec2(300.0f, 150.0f);
+    setTextAlignment(TextAlignment::Left);
+    registerEventHandler("styleUpdate", [this](UIElement*, EventType) { onStyleUpdate(); });
+}
+
+} // namespace ui
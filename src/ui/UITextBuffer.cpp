@@ -0,0 +1,148 @@
+#include "ui/UITextBuffer.h"
+#include <algorithm>
+#include <cstring>
+
+namespace ui {
+
+namespace {
+    bool isContinuationByte(char c) {
+        return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+    }
+}
+
+UITextBuffer::UITextBuffer(std::size_t initialCapacity)
+    : data_(initialCapacity), gapStart_(0), gapEnd_(initialCapacity) {
+}
+
+void UITextBuffer::assign(std::string_view text) {
+    data_.assign(text.begin(), text.end());
+    data_.resize(text.size() + std::max<std::size_t>(64, text.size() / 4));
+    gapStart_ = text.size();
+    gapEnd_ = data_.size();
+    lineStarts_.assign(1, 0);
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '\n') lineStarts_.push_back(i + 1);
+    }
+    ++revision_;
+}
+
+void UITextBuffer::insert(std::size_t pos, std::string_view text) {
+    if (text.empty()) return;
+    pos = std::min(pos, size());
+    ensureGap(text.size());
+    moveGap(pos);
+    std::memcpy(data_.data() + gapStart_, text.data(), text.size());
+    gapStart_ += text.size();
+
+    // Shift the lines after the insertion point, then add the new ones.
+    const std::size_t line = lineOf(pos);
+    for (std::size_t i = line + 1; i < lineStarts_.size(); ++i) {
+        lineStarts_[i] += text.size();
+    }
+    std::vector<std::size_t> newStarts;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '\n') newStarts.push_back(pos + i + 1);
+    }
+    lineStarts_.insert(lineStarts_.begin() + static_cast<std::ptrdiff_t>(line + 1), newStarts.begin(), newStarts.end());
+    ++revision_;
+}
+
+void UITextBuffer::erase(std::size_t pos, std::size_t count) {
+    if (pos >= size()) return;
+    count = std::min(count, size() - pos);
+    if (count == 0) return;
+    moveGap(pos);
+    gapEnd_ += count;
+
+    // Drop the lines that started inside the erased range and shift the rest.
+    auto first = std::upper_bound(lineStarts_.begin(), lineStarts_.end(), pos);
+    auto last = std::upper_bound(first, lineStarts_.end(), pos + count);
+    first = lineStarts_.erase(first, last);
+    for (auto it = first; it != lineStarts_.end(); ++it) {
+        *it -= count;
+    }
+    ++revision_;
+}
+
+std::string UITextBuffer::substr(std::size_t pos, std::size_t count) const {
+    pos = std::min(pos, size());
+    count = std::min(count, size() - pos);
+    std::string result;
+    result.reserve(count);
+    const std::size_t end = pos + count;
+    if (pos < gapStart_) {
+        const std::size_t beforeGap = std::min(end, gapStart_);
+        result.append(data_.data() + pos, beforeGap - pos);
+        pos = beforeGap;
+    }
+    if (pos < end) {
+        result.append(data_.data() + pos + gapSize(), end - pos);
+    }
+    return result;
+}
+
+std::size_t UITextBuffer::nextBoundary(std::size_t pos) const {
+    const std::size_t length = size();
+    if (pos >= length) return length;
+    ++pos;
+    while (pos < length && isContinuationByte(at(pos))) ++pos;
+    return pos;
+}
+
+std::size_t UITextBuffer::prevBoundary(std::size_t pos) const {
+    if (pos == 0) return 0;
+    pos = std::min(pos, size());
+    --pos;
+    while (pos > 0 && isContinuationByte(at(pos))) --pos;
+    return pos;
+}
+
+char32_t UITextBuffer::codepointAt(std::size_t pos) const {
+    if (pos >= size()) return 0;
+    const auto lead = static_cast<unsigned char>(at(pos));
+    int extra = 0;
+    char32_t cp = lead;
+    if (lead >= 0xF0) { extra = 3; cp = lead & 0x07; }
+    else if (lead >= 0xE0) { extra = 2; cp = lead & 0x0F; }
+    else if (lead >= 0xC0) { extra = 1; cp = lead & 0x1F; }
+    for (int i = 1; i <= extra && pos + i < size(); ++i) {
+        cp = (cp << 6) | (static_cast<unsigned char>(at(pos + i)) & 0x3F);
+    }
+    return cp;
+}
+
+std::size_t UITextBuffer::lineEnd(std::size_t line) const {
+    return line + 1 < lineStarts_.size() ? lineStarts_[line + 1] - 1 : size();
+}
+
+std::size_t UITextBuffer::lineOf(std::size_t pos) const {
+    auto it = std::upper_bound(lineStarts_.begin(), lineStarts_.end(), pos);
+    return static_cast<std::size_t>(it - lineStarts_.begin()) - 1;
+}
+
+void UITextBuffer::moveGap(std::size_t pos) {
+    if (pos < gapStart_) {
+        const std::size_t count = gapStart_ - pos;
+        std::memmove(data_.data() + gapEnd_ - count, data_.data() + pos, count);
+        gapStart_ -= count;
+        gapEnd_ -= count;
+    }
+    else if (pos > gapStart_) {
+        const std::size_t count = pos - gapStart_;
+        std::memmove(data_.data() + gapStart_, data_.data() + gapEnd_, count);
+        gapStart_ += count;
+        gapEnd_ += count;
+    }
+}
+
+void UITextBuffer::ensureGap(std::size_t minimum) {
+    if (gapSize() >= minimum) return;
+    // Grow geometrically so a long run of keystrokes stays amortized O(1).
+    const std::size_t tail = data_.size() - gapEnd_;
+    const std::size_t newCapacity = std::max(data_.size() * 2, size() + minimum + 64);
+    data_.resize(newCapacity);
+    std::memmove(data_.data() + newCapacity - tail, data_.data() + gapEnd_, tail);
+    gapEnd_ = newCapacity - tail;
+}
+
+} // namespace ui
@@ -0,0 +1,259 @@
+#include "ui/UITextEdit.h"
+#include "ui/UICanvas.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <source_location> // Added for C++20 std::source_location
+
+namespace ui {
+
+UITextEdit::UITextEdit(bool multiLine)
+    : multiLine_(multiLine) {
+}
+
+void UITextEdit::setText(const std::string& text) {
+    if (multiLine_) {
+        buffer_.assign(text);
+    }
+    else {
+        std::string singleLine = text;
+        std::replace(singleLine.begin(), singleLine.end(), '\n', ' ');
+        buffer_.assign(singleLine);
+    }
+    metrics_.invalidateAll();
+    cursor_ = buffer_.size();
+    preferredX_ = -1.0f;
+    markDirty();
+    // Log with source_location for automatic file/line info
+    spdlog::debug("{} text set ({} bytes) at {}", styleType_, buffer_.size(), std::source_location::current().function_name());
+}
+
+void UITextEdit::setCursor(std::size_t pos) {
+    pos = std::min(pos, buffer_.size());
+    // Snap to a code point boundary.
+    while (pos > 0 && pos < buffer_.size() && (static_cast<unsigned char>(buffer_.at(pos)) & 0xC0) == 0x80) --pos;
+    cursor_ = pos;
+    markDirty();
+}
+
+void UITextEdit::insertAtCursor(std::string_view text) {
+    if (text.empty()) return;
+    const std::size_t line = buffer_.lineOf(cursor_);
+    const std::size_t linesBefore = buffer_.lineCount();
+    buffer_.insert(cursor_, text);
+    metrics_.onEdit(line, cursor_ - buffer_.lineStart(line),
+                    static_cast<std::ptrdiff_t>(buffer_.lineCount()) - static_cast<std::ptrdiff_t>(linesBefore));
+    cursor_ += text.size();
+    preferredX_ = -1.0f;
+    markDirty();
+}
+
+void UITextEdit::eraseRange(std::size_t pos, std::size_t count) {
+    if (count == 0) return;
+    const std::size_t line = buffer_.lineOf(pos);
+    const std::size_t linesBefore = buffer_.lineCount();
+    const std::size_t byteInLine = pos - buffer_.lineStart(line);
+    buffer_.erase(pos, count);
+    metrics_.onEdit(line, byteInLine,
+                    static_cast<std::ptrdiff_t>(buffer_.lineCount()) - static_cast<std::ptrdiff_t>(linesBefore));
+    preferredX_ = -1.0f;
+    markDirty();
+}
+
+void UITextEdit::moveCursorVertically(int lines) {
+    const std::size_t line = buffer_.lineOf(cursor_);
+    const auto target = static_cast<std::ptrdiff_t>(line) + lines;
+    if (target < 0 || target >= static_cast<std::ptrdiff_t>(buffer_.lineCount())) return;
+    if (preferredX_ < 0.0f) {
+        preferredX_ = metrics_.prefixWidth(buffer_, line, cursor_ - buffer_.lineStart(line));
+    }
+    const auto targetLine = static_cast<std::size_t>(target);
+    cursor_ = buffer_.lineStart(targetLine) + metrics_.byteAtX(buffer_, targetLine, preferredX_);
+    markDirty();
+}
+
+void UITextEdit::ensureCursorVisible(const glm::vec2& viewportSize) {
+    const std::size_t line = buffer_.lineOf(cursor_);
+    const float cursorX = metrics_.prefixWidth(buffer_, line, cursor_ - buffer_.lineStart(line));
+    if (cursorX < scroll_.x) {
+        scroll_.x = cursorX;
+    }
+    else if (cursorX > scroll_.x + viewportSize.x) {
+        scroll_.x = cursorX - viewportSize.x;
+    }
+
+    if (multiLine_) {
+        const float cursorTop = static_cast<float>(line) * lineHeight_;
+        if (cursorTop < scroll_.y) {
+            scroll_.y = cursorTop;
+        }
+        else if (cursorTop + lineHeight_ > scroll_.y + viewportSize.y) {
+            scroll_.y = cursorTop + lineHeight_ - viewportSize.y;
+        }
+    }
+}
+
+void UITextEdit::renderLine(IRenderer* renderer, std::size_t line, const glm::vec2& origin, float viewportWidth,
+                            const glm::vec4& color, float fontSize) {
+    // Only the slice of the line that intersects the viewport is measured and drawn.
+    const std::size_t first = metrics_.floorByteAtX(buffer_, line, scroll_.x);
+    const std::size_t last = metrics_.ceilByteAtX(buffer_, line, scroll_.x + viewportWidth);
+    if (last <= first) return;
+    const float x = origin.x + metrics_.prefixWidth(buffer_, line, first) - scroll_.x;
+    renderer->drawText(glm::vec2(x, origin.y), buffer_.substr(buffer_.lineStart(line) + first, last - first), color, fontSize);
+}
+
+void UITextEdit::render(IRenderer* renderer) {
+    if (!renderer || !dirty_) return;
+
+    const UITheme* theme = nullptr;
+    if (auto* canvas = dynamic_cast<UICanvas*>(parent_.value_or(nullptr))) {
+        theme = canvas->getEffectiveTheme();
+    }
+    if (!theme) return;
+
+    UIStyle style = *theme->getStyle(styleType_).get();
+    std::unordered_map<std::string, bool> states = {{"hovered", isHovered_}, {"pressed", isPressed_}, {"focused", hasFocus()}};
+    UIStyle effectiveStyle = style.computeEffectiveStyle(states);
+
+    renderer->drawRect(position_, size_, effectiveStyle.backgroundColor);
+
+    metrics_.setRenderer(renderer);
+    metrics_.setFontSize(style.fontSize);
+    lineHeight_ = style.fontSize * kLineSpacing;
+    const glm::vec2 viewport(std::max(0.0f, size_.x - 2.0f * kTextInset),
+                             multiLine_ ? std::max(lineHeight_, size_.y - 2.0f * kTextInset) : lineHeight_);
+    ensureCursorVisible(viewport);
+
+    // Alignment only applies to a single line that fits; otherwise it scrolls.
+    alignOffset_ = 0.0f;
+    if (!multiLine_ && (getTextAlignment() == TextAlignment::Right || getTextAlignment() == TextAlignment::Center)) {
+        const float width = metrics_.lineWidth(buffer_, 0);
+        if (width < viewport.x) {
+            alignOffset_ = getTextAlignment() == TextAlignment::Right ? viewport.x - width : (viewport.x - width) / 2.0f;
+        }
+    }
+
+    std::size_t firstLine = 0;
+    std::size_t lastLine = 0;
+    float baseline = position_.y + (size_.y + style.fontSize) / 2.0f;
+    if (multiLine_) {
+        firstLine = static_cast<std::size_t>(std::floor(scroll_.y / lineHeight_));
+        lastLine = std::min(buffer_.lineCount() - 1,
+                            static_cast<std::size_t>(std::floor((scroll_.y + viewport.y) / lineHeight_)));
+        baseline = position_.y + kTextInset + style.fontSize - scroll_.y;
+    }
+
+    const float originX = position_.x + kTextInset + alignOffset_;
+    for (std::size_t line = firstLine; line <= lastLine && line < buffer_.lineCount(); ++line) {
+        const float lineBaseline = baseline + (multiLine_ ? static_cast<float>(line) * lineHeight_ : 0.0f);
+        renderLine(renderer, line, glm::vec2(originX, lineBaseline), viewport.x, effectiveStyle.textColor, style.fontSize);
+    }
+
+    // Render cursor if focused
+    if (hasFocus()) {
+        const std::size_t line = buffer_.lineOf(cursor_);
+        const float cursorX = originX + metrics_.prefixWidth(buffer_, line, cursor_ - buffer_.lineStart(line)) - scroll_.x;
+        const float cursorBaseline = baseline + (multiLine_ ? static_cast<float>(line) * lineHeight_ : 0.0f);
+        renderer->drawLine(glm::vec2(cursorX, cursorBaseline - style.fontSize), glm::vec2(cursorX, cursorBaseline), effectiveStyle.textColor);
+    }
+
+    dirty_ = false;
+}
+
+bool UITextEdit::handleInput(IMouseEvent* mouseEvent) {
+    if (!mouseEvent) return false;
+
+    bool handled = UIElement::handleInput(mouseEvent);
+    if (handled && mouseEvent->getType() == EventType::MousePress && hitTest(mouseEvent->getPosition())) {
+        setFocus(true);
+        // Place the cursor under the pointer once metrics from a render are available.
+        if (metrics_.hasRenderer() && lineHeight_ > 0.0f) {
+            const glm::vec2 local = mouseEvent->getPosition() - position_ - glm::vec2(kTextInset + alignOffset_, kTextInset) + scroll_;
+            std::size_t line = 0;
+            if (multiLine_ && local.y > 0.0f) {
+                line = std::min(buffer_.lineCount() - 1, static_cast<std::size_t>(local.y / lineHeight_));
+            }
+            cursor_ = buffer_.lineStart(line) + metrics_.byteAtX(buffer_, line, local.x);
+            preferredX_ = -1.0f;
+            markDirty();
+        }
+        // Log with source_location for better debugging context
+        spdlog::debug("{} gained focus at {}", styleType_, std::source_location::current().function_name());
+        return true;
+    }
+    return handled;
+}
+
+bool UITextEdit::handleInput(IKeyboardEvent* keyboardEvent) {
+    if (!keyboardEvent || !hasFocus()) return false;
+
+    if (keyboardEvent->getType() == EventType::KeyPress) {
+        switch (keyboardEvent->getKeyCode()) {
+        case KeyCode::Left:
+            cursor_ = buffer_.prevBoundary(cursor_);
+            preferredX_ = -1.0f;
+            markDirty();
+            return true;
+        case KeyCode::Right:
+            cursor_ = buffer_.nextBoundary(cursor_);
+            preferredX_ = -1.0f;
+            markDirty();
+            return true;
+        case KeyCode::Home:
+            cursor_ = buffer_.lineStart(buffer_.lineOf(cursor_));
+            preferredX_ = -1.0f;
+            markDirty();
+            return true;
+        case KeyCode::End:
+            cursor_ = buffer_.lineEnd(buffer_.lineOf(cursor_));
+            preferredX_ = -1.0f;
+            markDirty();
+            return true;
+        case KeyCode::Up:
+            if (!multiLine_) break;
+            moveCursorVertically(-1);
+            return true;
+        case KeyCode::Down:
+            if (!multiLine_) break;
+            moveCursorVertically(1);
+            return true;
+        case KeyCode::Backspace:
+            if (cursor_ > 0) {
+                const std::size_t prev = buffer_.prevBoundary(cursor_);
+                eraseRange(prev, cursor_ - prev);
+                cursor_ = prev;
+            }
+            return true;
+        case KeyCode::Delete:
+            eraseRange(cursor_, buffer_.nextBoundary(cursor_) - cursor_);
+            return true;
+        case KeyCode::Return:
+            if (!multiLine_) break;
+            insertAtCursor("\n");
+            return true;
+        default:
+            break;
+        }
+    }
+    return UIElement::handleInput(keyboardEvent);
+}
+
+bool UITextEdit::handleInput(ITextInputEvent* textEvent) {
+    if (!textEvent || !hasFocus()) return false;
+
+    std::string text = textEvent->getText();
+    if (!multiLine_) {
+        text.erase(std::remove(text.begin(), text.end(), '\n'), text.end());
+    }
+    insertAtCursor(text);
+    // Log with source_location for detailed tracing
+    spdlog::debug("Text input of {} bytes added at cursor position {} in {}", text.size(), cursor_, std::source_location::current().function_name());
+    return true;
+}
+
+void UITextEdit::onStyleUpdate() {
+    markDirty();
+}
+
+} // namespace ui
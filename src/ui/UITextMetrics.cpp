@@ -0,0 +1,121 @@
+#include "ui/UITextMetrics.h"
+#include <algorithm>
+
+namespace ui {
+
+void UITextMetrics::setRenderer(IRenderer* renderer) {
+    if (renderer == renderer_) return;
+    // Widths measured with another (or no) renderer are not comparable.
+    renderer_ = renderer;
+    advances_.clear();
+    invalidateAll();
+}
+
+void UITextMetrics::setFontSize(float fontSize) {
+    if (fontSize == fontSize_) return;
+    fontSize_ = fontSize;
+    advances_.clear();
+    invalidateAll();
+}
+
+void UITextMetrics::onEdit(std::size_t line, std::size_t byteInLine, std::ptrdiff_t lineDelta) {
+    if (line >= lines_.size()) return;
+
+    // Boundaries before the edit point are unaffected.
+    LineMetrics& metrics = lines_[line];
+    auto keep = std::upper_bound(metrics.offsets.begin(), metrics.offsets.end(), static_cast<std::uint32_t>(byteInLine));
+    const auto kept = static_cast<std::size_t>(keep - metrics.offsets.begin());
+    metrics.offsets.resize(std::max<std::size_t>(kept, 1));
+    metrics.widths.resize(metrics.offsets.size());
+
+    const auto next = lines_.begin() + static_cast<std::ptrdiff_t>(line + 1);
+    if (lineDelta > 0) {
+        lines_.insert(next, static_cast<std::size_t>(lineDelta), LineMetrics{});
+    }
+    else if (lineDelta < 0) {
+        const auto removed = std::min<std::ptrdiff_t>(-lineDelta, lines_.end() - next);
+        lines_.erase(next, next + removed);
+    }
+}
+
+void UITextMetrics::invalidateAll() {
+    lines_.clear();
+}
+
+UITextMetrics::LineMetrics& UITextMetrics::lineMetrics(const UITextBuffer& buffer, std::size_t line) {
+    if (lines_.size() != buffer.lineCount()) {
+        lines_.resize(buffer.lineCount());
+    }
+    return lines_[line];
+}
+
+float UITextMetrics::prefixWidth(const UITextBuffer& buffer, std::size_t line, std::size_t byteInLine) {
+    LineMetrics& metrics = lineMetrics(buffer, line);
+    extendTo(buffer, line, metrics, byteInLine);
+    auto it = std::upper_bound(metrics.offsets.begin(), metrics.offsets.end(), static_cast<std::uint32_t>(byteInLine));
+    return metrics.widths[static_cast<std::size_t>(it - metrics.offsets.begin()) - 1];
+}
+
+float UITextMetrics::lineWidth(const UITextBuffer& buffer, std::size_t line) {
+    return prefixWidth(buffer, line, buffer.lineEnd(line) - buffer.lineStart(line));
+}
+
+std::size_t UITextMetrics::byteAtX(const UITextBuffer& buffer, std::size_t line, float x) {
+    LineMetrics& metrics = lineMetrics(buffer, line);
+    extendToX(buffer, line, metrics, x);
+    auto it = std::lower_bound(metrics.widths.begin(), metrics.widths.end(), x);
+    if (it == metrics.widths.end()) return metrics.offsets.back();
+    auto index = static_cast<std::size_t>(it - metrics.widths.begin());
+    if (index > 0 && x - metrics.widths[index - 1] < *it - x) --index;
+    return metrics.offsets[index];
+}
+
+std::size_t UITextMetrics::floorByteAtX(const UITextBuffer& buffer, std::size_t line, float x) {
+    LineMetrics& metrics = lineMetrics(buffer, line);
+    extendToX(buffer, line, metrics, x);
+    auto it = std::upper_bound(metrics.widths.begin(), metrics.widths.end(), x);
+    return metrics.offsets[it == metrics.widths.begin() ? 0 : static_cast<std::size_t>(it - metrics.widths.begin()) - 1];
+}
+
+std::size_t UITextMetrics::ceilByteAtX(const UITextBuffer& buffer, std::size_t line, float x) {
+    LineMetrics& metrics = lineMetrics(buffer, line);
+    extendToX(buffer, line, metrics, x);
+    auto it = std::lower_bound(metrics.widths.begin(), metrics.widths.end(), x);
+    return it == metrics.widths.end() ? metrics.offsets.back() : metrics.offsets[static_cast<std::size_t>(it - metrics.widths.begin())];
+}
+
+void UITextMetrics::extendTo(const UITextBuffer& buffer, std::size_t line, LineMetrics& metrics, std::size_t byteInLine) {
+    const std::size_t start = buffer.lineStart(line);
+    const std::size_t length = buffer.lineEnd(line) - start;
+    byteInLine = std::min(byteInLine, length);
+    while (metrics.offsets.back() < byteInLine) {
+        const std::size_t pos = start + metrics.offsets.back();
+        const std::size_t next = buffer.nextBoundary(pos);
+        metrics.widths.push_back(metrics.widths.back() + advance(buffer.codepointAt(pos), buffer, pos, next - pos));
+        metrics.offsets.push_back(static_cast<std::uint32_t>(next - start));
+    }
+}
+
+void UITextMetrics::extendToX(const UITextBuffer& buffer, std::size_t line, LineMetrics& metrics, float x) {
+    const std::size_t start = buffer.lineStart(line);
+    const std::size_t length = buffer.lineEnd(line) - start;
+    while (metrics.widths.back() < x && metrics.offsets.back() < length) {
+        const std::size_t pos = start + metrics.offsets.back();
+        const std::size_t next = buffer.nextBoundary(pos);
+        metrics.widths.push_back(metrics.widths.back() + advance(buffer.codepointAt(pos), buffer, pos, next - pos));
+        metrics.offsets.push_back(static_cast<std::uint32_t>(next - start));
+    }
+}
+
+float UITextMetrics::advance(char32_t codepoint, const UITextBuffer& buffer, std::size_t pos, std::size_t length) {
+    auto it = advances_.find(codepoint);
+    if (it != advances_.end()) return it->second;
+    // Without a renderer fall back to a fixed half-em advance; the cache is not
+    // populated so real measurements replace it once a renderer is available.
+    if (!renderer_) return fontSize_ * 0.5f;
+    const float width = renderer_->measureText(buffer.substr(pos, length), fontSize_).x;
+    advances_.emplace(codepoint, width);
+    return width;
+}
+
+} // namespace ui
@@ -0,0 +1,115 @@
+#include "utils/JobSystem.h"
+#include <algorithm>
+
+namespace utils {
+
+    namespace {
+        thread_local bool tlsInsideJob = false;
+
+        struct InsideJobScope {
+            bool previous;
+            InsideJobScope() : previous(tlsInsideJob) { tlsInsideJob = true; }
+            ~InsideJobScope() { tlsInsideJob = previous; }
+        };
+    }
+
+    JobSystem& JobSystem::getInstance() {
+        static JobSystem instance(std::max(1u, std::thread::hardware_concurrency()) - 1);
+        return instance;
+    }
+
+    bool JobSystem::isInsideJob() {
+        return tlsInsideJob;
+    }
+
+    JobSystem::JobSystem(size_t workerCount) {
+        workers_.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; ++i) {
+            workers_.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    JobSystem::~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wakeCv_.notify_all();
+        workers_.clear();
+    }
+
+    void JobSystem::parallelFor(size_t count, const std::function<void(size_t)>& fn, size_t grain) {
+        if (count == 0) return;
+        grain = std::max<size_t>(grain, 1);
+
+        if (workers_.empty() || count <= grain || tlsInsideJob) {
+            InsideJobScope scope;
+            for (size_t i = 0; i < count; ++i) fn(i);
+            return;
+        }
+
+        std::lock_guard<std::mutex> submitLock(submitMutex_);
+        Batch batch;
+        batch.fn = &fn;
+        batch.count = count;
+        batch.grain = grain;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            current_ = &batch;
+            ++generation_;
+        }
+        wakeCv_.notify_all();
+
+        runChunks(batch);
+
+        // Late wakers see no batch; anyone already inside finishes its claimed chunk first.
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            current_ = nullptr;
+            doneCv_.wait(lock, [this]() { return busy_ == 0; });
+        }
+
+        if (batch.error) std::rethrow_exception(batch.error);
+    }
+
+    void JobSystem::runChunks(Batch& batch) {
+        InsideJobScope scope;
+        for (;;) {
+            const size_t begin = batch.next.fetch_add(batch.grain, std::memory_order_relaxed);
+            if (begin >= batch.count) break;
+            const size_t end = std::min(begin + batch.grain, batch.count);
+            try {
+                for (size_t i = begin; i < end; ++i) (*batch.fn)(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(batch.errorMutex);
+                if (!batch.error) batch.error = std::current_exception();
+            }
+        }
+    }
+
+    void JobSystem::workerLoop() {
+        size_t seenGeneration = 0;
+        for (;;) {
+            Batch* batch = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wakeCv_.wait(lock, [&]() { return stopping_ || generation_ != seenGeneration; });
+                if (stopping_) return;
+                seenGeneration = generation_;
+                batch = current_;
+                if (!batch) continue;
+                ++busy_;
+            }
+
+            runChunks(*batch);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --busy_;
+            }
+            doneCv_.notify_one();
+        }
+    }
+
+} // namespace utils